@@ -0,0 +1,97 @@
+#ifndef AIKIDO_COMMON_BOUNDEDLEASTSQUARES_HPP_
+#define AIKIDO_COMMON_BOUNDEDLEASTSQUARES_HPP_
+
+#include <vector>
+#include <Eigen/Dense>
+
+namespace aikido {
+namespace common {
+
+/// Solves box-constrained linear least-squares problems
+///
+///   min ||A x - b||^2 subject to lower <= x <= upper
+///
+/// with a primal active-set method. Each iteration solves the least-squares
+/// problem on the variables that are not held at a bound directly, moving
+/// as far towards that solution as the bounds allow. Once no bound blocks
+/// the step, a variable held at a bound is released if the objective
+/// decreases by moving it into the box. The direct solve makes the number of
+/// iterations independent of the conditioning of \c A.
+///
+/// The solver is meant for small, repeatedly solved problems, such as
+/// mapping an end-effector twist to joint velocities: it starts from the
+/// given initial guess, e.g. the previous solution, and reuses its
+/// workspace between calls. If \c A does not have full column rank, each
+/// step is the smallest one that minimizes the objective, so the solution
+/// stays close to the initial guess.
+class BoundedLeastSquaresSolver
+{
+public:
+  /// Constructor.
+  ///
+  /// \param maxIterations maximum number of active-set iterations
+  /// \param tolerance a variable held at a bound is released only if the
+  /// gradient of the objective pulls it into the box by more than this,
+  /// relative to the magnitude of \c A^T \c b
+  explicit BoundedLeastSquaresSolver(
+      int maxIterations = 1000, double tolerance = 1e-10);
+
+  /// Solves the problem, starting from \c x clamped to the bounds. Bounds
+  /// may be infinite.
+  ///
+  /// \param A matrix with one column per variable
+  /// \param b target vector with one element per row of \c A
+  /// \param lower lower bound on each variable
+  /// \param upper upper bound on each variable
+  /// \param[in,out] x initial guess; the solution on output
+  /// \return whether the solver converged within the maximum number of
+  /// iterations. Otherwise \c x is the last iterate, which satisfies the
+  /// bounds.
+  /// \throws std::invalid_argument if the dimensions do not match or a lower
+  /// bound exceeds its upper bound.
+  bool solve(
+      const Eigen::MatrixXd& A,
+      const Eigen::VectorXd& b,
+      const Eigen::VectorXd& lower,
+      const Eigen::VectorXd& upper,
+      Eigen::VectorXd& x);
+
+  /// Returns the number of iterations performed by the last call to solve().
+  int getNumIterations() const;
+
+private:
+  /// Set to the value of \c maxIterations.
+  int mMaxIterations;
+
+  /// Set to the value of \c tolerance.
+  double mTolerance;
+
+  /// Number of iterations performed by the last call to solve().
+  int mNumIterations;
+
+  /// Workspace for whether each variable is held at a bound.
+  std::vector<bool> mIsHeld;
+
+  /// Workspace for the indices of the variables that are not held.
+  std::vector<int> mFreeIndices;
+
+  /// Workspace for the columns of A of the variables that are not held.
+  Eigen::MatrixXd mFreeColumns;
+
+  /// Workspace for the decomposition of mFreeColumns.
+  Eigen::JacobiSVD<Eigen::MatrixXd> mSvd;
+
+  /// Workspace for b - A x.
+  Eigen::VectorXd mResidual;
+
+  /// Workspace for the step of the variables that are not held.
+  Eigen::VectorXd mStep;
+
+  /// Workspace for the gradient of the objective.
+  Eigen::VectorXd mGradient;
+};
+
+} // namespace common
+} // namespace aikido
+
+#endif // AIKIDO_COMMON_BOUNDEDLEASTSQUARES_HPP_
@@ -3,8 +3,10 @@
 
 #include <cstddef>
 #include <memory>
+#include <type_traits>
 #include <vector>
 #include <Eigen/Core>
+#include <Eigen/LU>
 #include <Eigen/QR>
 #include <Eigen/Sparse>
 #include <Eigen/StdVector>
@@ -286,6 +288,13 @@ public:
   /// under-constrained. To avoid this, be sure to only add
   /// (num coefficients) * (num knots - 1) constraints to this class.
   ///
+  /// A single segment with a compile-time number of coefficients is solved by
+  /// inverting its fixed-size matrix, which is closed-form for up to four
+  /// coefficients, e.g. linear and cubic Hermite segments. Otherwise, each
+  /// constraint only involves the segments adjacent to one knot, so the
+  /// problem is solved as a banded system in time linear in the number of
+  /// knots. Sparse QR is used as a fallback if either solve fails.
+  ///
   /// \return spline that satisfies the constraints
   Spline fit();
 
@@ -306,6 +315,23 @@ public:
   Scalar getDuration() const;
 
 private:
+  /// Solves a single segment with a fixed number of coefficients in closed
+  /// form.
+  void solve(std::true_type _isFixedSingleSegment);
+
+  /// Solves the general problem as a banded system, falling back to sparse
+  /// QR.
+  void solve(std::false_type _isFixedSingleSegment);
+
+  /// Solves the problem by Gaussian elimination with partial pivoting on
+  /// its band, after sorting the constraints by the first coefficient they
+  /// involve. Returns false, without modifying the solution, if the
+  /// constraints do not fit in the band or the problem is singular.
+  bool solveBanded();
+
+  /// Solves the problem by sparse QR.
+  void solveSparse();
+
   Index mNumKnots;
   Index mNumSegments;
   Index mNumCoefficients;
@@ -393,6 +393,191 @@ auto SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
 {
   assert(mRowIndex == mDimension);
 
+  solve(
+      std::integral_constant<bool,
+                             NumKnotsAtCompileTime == 2
+                                 && NumCoefficientsAtCompileTime
+                                        != Eigen::Dynamic>());
+
+  return Spline(mTimes, mSolution);
+}
+
+template <class Scalar,
+          class Index,
+          Index _NumCoefficients,
+          Index _NumOutputs,
+          Index _NumKnots>
+void SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
+    solve(std::true_type /*_isFixedSingleSegment*/)
+{
+  // Eigen inverts matrices of up to 4x4 by cofactors.
+  const CoefficientMatrix a = mA.toDense();
+  const CoefficientMatrix inverse = a.inverse();
+
+  if (!inverse.allFinite())
+  {
+    solveSparse();
+    return;
+  }
+
+  mSolution[0] = (inverse * mB).transpose();
+}
+
+template <class Scalar,
+          class Index,
+          Index _NumCoefficients,
+          Index _NumOutputs,
+          Index _NumKnots>
+void SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
+    solve(std::false_type /*_isFixedSingleSegment*/)
+{
+  if (!solveBanded())
+    solveSparse();
+}
+
+template <class Scalar,
+          class Index,
+          Index _NumCoefficients,
+          Index _NumOutputs,
+          Index _NumKnots>
+bool SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
+    solveBanded()
+{
+  using BandMatrix
+      = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  using RightHandSide
+      = Eigen::Matrix<Scalar, Eigen::Dynamic, NumOutputsAtCompileTime>;
+
+  const Index n = mDimension;
+
+  // A constraint involves at most the two segments adjacent to a knot. Once
+  // the constraints are sorted by the first coefficient they involve, a
+  // nonsingular problem has at most this many non-zeros on either side of
+  // the diagonal.
+  const Index bandwidth = 2 * mNumCoefficients - 1;
+
+  // Sort the constraints by the first coefficient they involve.
+  std::vector<Index> firstColumns(n, n);
+  for (Index col = 0; col < mA.outerSize(); ++col)
+  {
+    for (typename ProblemMatrix::InnerIterator it(mA, col); it; ++it)
+    {
+      if (it.value() != 0)
+        firstColumns[it.row()] = std::min(firstColumns[it.row()], col);
+    }
+  }
+
+  std::vector<Index> order(n);
+  for (Index i = 0; i < n; ++i)
+    order[i] = i;
+
+  std::stable_sort(order.begin(), order.end(), [&](Index _a, Index _b) {
+    return firstColumns[_a] < firstColumns[_b];
+  });
+
+  std::vector<Index> rows(n);
+  for (Index i = 0; i < n; ++i)
+    rows[order[i]] = i;
+
+  // Row i stores columns [i - bandwidth, i + 2 * bandwidth]. The extra
+  // bandwidth to the right of the diagonal holds the fill-in of pivoting.
+  BandMatrix band = BandMatrix::Zero(n, 3 * bandwidth + 1);
+  auto at = [&](Index _row, Index _col) -> Scalar& {
+    return band(_row, _col - _row + bandwidth);
+  };
+
+  for (Index col = 0; col < mA.outerSize(); ++col)
+  {
+    for (typename ProblemMatrix::InnerIterator it(mA, col); it; ++it)
+    {
+      // Explicit zeros may lie outside of the band.
+      if (it.value() == 0)
+        continue;
+
+      const Index row = rows[it.row()];
+      if (col < row - bandwidth || col > row + bandwidth)
+        return false;
+
+      at(row, col) = it.value();
+    }
+  }
+
+  RightHandSide x(n, mNumOutputs);
+  for (Index i = 0; i < n; ++i)
+    x.row(rows[i]) = mB.row(i);
+
+  // Gaussian elimination with partial pivoting.
+  for (Index k = 0; k < n; ++k)
+  {
+    const Index lastRow = std::min(n - 1, k + bandwidth);
+    const Index lastCol = std::min(n - 1, k + 2 * bandwidth);
+
+    Index pivot = k;
+    for (Index i = k + 1; i <= lastRow; ++i)
+    {
+      if (std::abs(at(i, k)) > std::abs(at(pivot, k)))
+        pivot = i;
+    }
+
+    if (at(pivot, k) == 0)
+      return false;
+
+    if (pivot != k)
+    {
+      for (Index col = k; col <= lastCol; ++col)
+        std::swap(at(k, col), at(pivot, col));
+
+      x.row(k).swap(x.row(pivot));
+    }
+
+    for (Index i = k + 1; i <= lastRow; ++i)
+    {
+      const Scalar factor = at(i, k) / at(k, k);
+      if (factor == 0)
+        continue;
+
+      for (Index col = k; col <= lastCol; ++col)
+        at(i, col) -= factor * at(k, col);
+
+      x.row(i) -= factor * x.row(k);
+    }
+  }
+
+  // Back substitution.
+  for (Index k = n - 1; k >= 0; --k)
+  {
+    const Index lastCol = std::min(n - 1, k + 2 * bandwidth);
+    for (Index col = k + 1; col <= lastCol; ++col)
+      x.row(k) -= at(k, col) * x.row(col);
+
+    x.row(k) /= at(k, k);
+  }
+
+  if (!x.allFinite())
+    return false;
+
+  // Split the coefficients by segment.
+  for (Index isegment = 0; isegment < mNumSegments; ++isegment)
+  {
+    mSolution[isegment] = x.block(
+                               isegment * mNumCoefficients,
+                               0,
+                               mNumCoefficients,
+                               mNumOutputs)
+                              .transpose();
+  }
+
+  return true;
+}
+
+template <class Scalar,
+          class Index,
+          Index _NumCoefficients,
+          Index _NumOutputs,
+          Index _NumKnots>
+void SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
+    solveSparse()
+{
   // SparseQR requires the matrix to be compressed.
   mA.finalize();
   mA.makeCompressed();
@@ -403,7 +588,7 @@ auto SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
   for (Index ioutput = 0; ioutput < mNumOutputs; ++ioutput)
   {
     // Solve for the spline coefficients for each output dimension.
-    Eigen::Matrix<Scalar, DimensionAtCompileTime, 1> solutionVector
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1> solutionVector
         = solver.solve(mB.col(ioutput));
 
     // Split the coefficients by segment.
@@ -414,8 +599,6 @@ auto SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
           isegment * mNumCoefficients, mNumCoefficients);
     }
   }
-
-  return Spline(mTimes, mSolution);
 }
 
 template <class Scalar,
@@ -0,0 +1,135 @@
+#ifndef AIKIDO_CONSTRAINT_CACHEDTESTABLE_HPP_
+#define AIKIDO_CONSTRAINT_CACHEDTESTABLE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Testable.hpp"
+
+namespace aikido {
+namespace constraint {
+
+AIKIDO_DECLARE_POINTERS(CachedTestable)
+
+/// A testable constraint that caches the results of another testable
+/// constraint, such as a CollisionFree constraint.
+///
+/// States are quantized by dividing each coordinate of their log map by a
+/// resolution and rounding it, so all states in a cell of that size share a
+/// result. The resolution should therefore be small relative to the margin
+/// the wrapped constraint is tested with.
+///
+/// The cache is split into stripes, each with its own mutex, so it can be
+/// shared by several threads if the wrapped constraint can be. When a stripe
+/// is full, its oldest entry is evicted. The cached results are only valid
+/// as long as the wrapped constraint does not change, e.g. as long as the
+/// obstacles in a World do not move; call \c clear otherwise.
+class CachedTestable : public Testable
+{
+public:
+  /// Statistics of the cache.
+  struct CacheStatistics
+  {
+    /// Number of states whose result was found in the cache.
+    std::size_t numHits = 0;
+
+    /// Number of states that were tested with the wrapped constraint.
+    std::size_t numMisses = 0;
+
+    /// Number of results in the cache.
+    std::size_t numEntries = 0;
+  };
+
+  /// Constructor.
+  /// \param testable Testable constraint to cache the results of.
+  /// \param resolution Size of the cells states are quantized to, in the
+  ///        coordinates of the log map of the StateSpace. Must be positive.
+  /// \param capacity Maximum number of results in the cache.
+  /// \param numStripes Number of independently locked parts of the cache.
+  CachedTestable(
+      TestablePtr testable,
+      double resolution,
+      std::size_t capacity = 65536,
+      std::size_t numStripes = 16);
+
+  /// Returns the cached result of the cell of \c state, testing \c state with
+  /// the wrapped constraint if there is none. If \c outcome is not nullptr,
+  /// the wrapped constraint is always tested so that it populates
+  /// \c outcome.
+  bool isSatisfied(
+      const statespace::StateSpace::State* state,
+      TestableOutcome* outcome = nullptr) const override;
+
+  // Documentation inherited.
+  statespace::StateSpacePtr getStateSpace() const override;
+
+  /// Returns an outcome of the wrapped constraint.
+  std::unique_ptr<TestableOutcome> createOutcome() const override;
+
+  /// Returns the wrapped constraint.
+  TestablePtr getTestable() const;
+
+  /// Returns the size of the cells states are quantized to.
+  double getResolution() const;
+
+  /// Returns the maximum number of results in the cache.
+  std::size_t getCapacity() const;
+
+  /// Returns the statistics of the cache.
+  CacheStatistics getStatistics() const;
+
+  /// Removes all results from the cache and resets its statistics.
+  void clear();
+
+private:
+  /// Quantized state.
+  using Key = std::vector<std::int64_t>;
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  /// Independently locked part of the cache.
+  struct Stripe
+  {
+    std::mutex mMutex;
+
+    /// Cached results.
+    std::unordered_map<Key, bool, KeyHash> mResults;
+
+    /// Keys of \c mResults, from oldest to newest.
+    std::deque<Key> mKeys;
+  };
+
+  /// Quantizes \c state into \c key.
+  void computeKey(const statespace::StateSpace::State* state, Key& key) const;
+
+  /// Returns the stripe that \c key is cached in.
+  Stripe& getStripe(const Key& key) const;
+
+  /// Caches \c satisfied as the result of \c key.
+  void insert(const Key& key, bool satisfied) const;
+
+  TestablePtr mTestable;
+  statespace::StateSpacePtr mStateSpace;
+  double mResolution;
+  std::size_t mCapacity;
+
+  /// Maximum number of results in each stripe.
+  std::size_t mStripeCapacity;
+
+  std::vector<std::unique_ptr<Stripe>> mStripes;
+
+  mutable std::atomic<std::size_t> mNumHits;
+  mutable std::atomic<std::size_t> mNumMisses;
+};
+
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_CACHEDTESTABLE_HPP_
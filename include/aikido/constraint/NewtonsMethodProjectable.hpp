@@ -12,6 +12,34 @@ namespace constraint {
 class NewtonsMethodProjectable : public Projectable
 {
 public:
+  /// Method used to compute the step taken in each iteration.
+  enum class StepMethod
+  {
+    /// Newton step, using the pseudoinverse of the jacobian.
+    PSEUDOINVERSE,
+
+    /// Damped least-squares (Levenberg-Marquardt) step on the constraint
+    /// violation, halved until the violation decreases.
+    DAMPED_LEAST_SQUARES
+  };
+
+  /// Statistics of a single projection.
+  struct ProjectionStatistics
+  {
+    /// Number of iterations taken.
+    int numIterations = 0;
+
+    /// Number of evaluations of the constraint, including the evaluations
+    /// rejected by the line search.
+    int numEvaluations = 0;
+
+    /// Norm of the constraint violation of the projected state.
+    double violation = 0.;
+
+    /// Whether the projected state satisfies the constraint.
+    bool converged = false;
+  };
+
   /// Constructor.
   /// \param _differentiable Differentiable constraint to be projected.
   /// \param _tolerance Tolerances for checking whether the constraints
@@ -32,17 +60,50 @@ public:
       const statespace::StateSpace::State* _s,
       statespace::StateSpace::State* _out) const override;
 
+  /// Projects _s to _out and reports how the projection went.
+  /// \param _s state to be projected.
+  /// \param _out resulting projection.
+  /// \param[out] _statistics statistics of the projection, or nullptr.
+  /// \return whether _out satisfies the constraint.
+  bool project(
+      const statespace::StateSpace::State* _s,
+      statespace::StateSpace::State* _out,
+      ProjectionStatistics* _statistics) const;
+
   // Documentation inherited.
   statespace::StateSpacePtr getStateSpace() const override;
 
+  /// Sets the method used to compute the step taken in each iteration.
+  /// \param _stepMethod Step method. Defaults to PSEUDOINVERSE.
+  void setStepMethod(StepMethod _stepMethod);
+
+  /// Returns the method used to compute the step taken in each iteration.
+  StepMethod getStepMethod() const;
+
+  /// Sets the damping used by the DAMPED_LEAST_SQUARES step method.
+  /// \param _damping Damping, which should be positive.
+  void setDamping(double _damping);
+
+  /// Returns the damping used by the DAMPED_LEAST_SQUARES step method.
+  double getDamping() const;
+
 private:
   DifferentiablePtr mDifferentiable;
   std::vector<double> mTolerance;
   int mMaxIteration;
   double mMinStepSize;
   statespace::StateSpacePtr mStateSpace;
+  std::vector<ConstraintType> mConstraintTypes;
+  StepMethod mStepMethod;
+  double mDamping;
+
+  /// Returns whether _values satisfy the constraint.
+  bool contains(const Eigen::VectorXd& _values) const;
 
-  bool contains(const statespace::StateSpace::State* _s) const;
+  /// Computes the violation of the constraint by _values: the value of each
+  /// equality constraint, and the positive part of each inequality.
+  void computeViolation(
+      const Eigen::VectorXd& _values, Eigen::VectorXd& _violation) const;
 };
 
 } // namespace constraint
@@ -2,6 +2,7 @@
 #define AIKIDO_CONSTRAINT_TESTABLE_HPP_
 
 #include <memory>
+#include <vector>
 #include "aikido/common/pointers.hpp"
 #include "../statespace/StateSpace.hpp"
 #include "DefaultTestableOutcome.hpp"
@@ -29,6 +30,25 @@ public:
       const statespace::StateSpace::State* _state,
       TestableOutcome* outcome = nullptr) const = 0;
 
+  /// Tests a batch of states against this constraint. This is equivalent to
+  /// calling \c isSatisfied on each state in order, but lets derived classes
+  /// amortize per-call overhead (e.g. dynamic dispatch, outcome bookkeeping,
+  /// or temporary allocations) across the whole batch. The default
+  /// implementation falls back to calling \c isSatisfied in a loop.
+  ///
+  /// \param[in] states states to test, in the order they should be tested
+  /// \param[out] results resized to the number of states; element \c i is
+  /// true if and only if \c states[i] satisfies this constraint. If
+  /// \c stopOnFailure is true, the entries following the first unsatisfied
+  /// state are unspecified.
+  /// \param[in] stopOnFailure whether to stop testing as soon as a state that
+  /// does not satisfy this constraint is found
+  /// \return true if all states satisfy this constraint
+  virtual bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::vector<bool>& results,
+      bool stopOnFailure = true) const;
+
   /// Returns StateSpace in which this constraint operates.
   virtual statespace::StateSpacePtr getStateSpace() const = 0;
 
@@ -13,9 +13,29 @@ AIKIDO_DECLARE_POINTERS(TestableIntersection)
 /// A testable constraint grouping a set of testable constraint.
 /// This constriant is satisfied only if all constraints in the set
 /// are satisfied.
+///
+/// By default, constraints are tested in the order they were added. In
+/// adaptive mode, the intersection measures the cost and the rejection rate of
+/// each constraint and periodically reorders them, so that constraints that
+/// are cheap and likely to fail are tested first. Since this updates the
+/// statistics from \c isSatisfied, an adaptive intersection must not be used
+/// concurrently from multiple threads.
 class TestableIntersection : public Testable
 {
 public:
+  /// Statistics of a constraint, collected in adaptive mode.
+  struct ConstraintStatistics
+  {
+    /// Number of states the constraint was tested on.
+    std::size_t numEvaluations = 0;
+
+    /// Number of states that did not satisfy the constraint.
+    std::size_t numRejections = 0;
+
+    /// Total time spent testing the constraint, in seconds.
+    double totalDuration = 0.;
+  };
+
   /// Construct a TestableIntersection on a specific StateSpace.
   /// \param _stateSpace StateSpace this constraint operates in.
   /// \param _constraints Set of constraints.
@@ -28,6 +48,18 @@ public:
       const aikido::statespace::StateSpace::State* state,
       TestableOutcome* outcome = nullptr) const override;
 
+  /// \copydoc Testable::isSatisfiedBatch()
+  /// \note Each constraint is tested on the whole batch at once, and only the
+  /// states that satisfy it are passed on to the next constraint. If
+  /// \c stopOnFailure is true and a constraint stops at a state, the states
+  /// before it are still tested against the remaining constraints, so their
+  /// results are exact; the states following it are not tested any further
+  /// and their results are set to false.
+  bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::vector<bool>& results,
+      bool stopOnFailure = true) const override;
+
   /// Return an instance of DefaultTestableOutcome, since this class doesn't
   /// have a more specialized TestableOutcome derivative assigned to it.
   std::unique_ptr<TestableOutcome> createOutcome() const override;
@@ -40,10 +72,50 @@ public:
   ///        TestableIntersection was initialize with.
   void addConstraint(TestablePtr constraint);
 
+  /// Enables or disables adaptive ordering of the constraints. Disabling it
+  /// restores the order the constraints were added in.
+  /// \param adaptive whether to reorder the constraints adaptively
+  void setAdaptiveOrdering(bool adaptive);
+
+  /// Returns whether the constraints are reordered adaptively.
+  bool isAdaptiveOrdering() const;
+
+  /// Returns the statistics of each constraint, in the order the constraints
+  /// were added. Statistics are only collected in adaptive mode.
+  std::vector<ConstraintStatistics> getConstraintStatistics() const;
+
+  /// Clears the statistics of all constraints.
+  void resetConstraintStatistics();
+
 private:
+  /// Records the outcome of testing constraint \c index on \c numEvaluations
+  /// states.
+  void recordEvaluations(
+      std::size_t index,
+      std::size_t numEvaluations,
+      std::size_t numRejections,
+      double duration) const;
+
+  /// Sorts \c mOrder by increasing expected cost per rejection, if enough
+  /// states were tested since the last time.
+  void updateOrder() const;
+
   statespace::StateSpacePtr mStateSpace;
   std::vector<TestablePtr> mConstraints;
 
+  /// Whether the constraints are reordered adaptively.
+  bool mAdaptiveOrdering;
+
+  /// Indices of the constraints in \c mConstraints, in the order they are
+  /// tested.
+  mutable std::vector<std::size_t> mOrder;
+
+  /// Statistics of each constraint in \c mConstraints.
+  mutable std::vector<ConstraintStatistics> mStatistics;
+
+  /// Number of states tested since the constraints were last reordered.
+  mutable std::size_t mNumEvaluationsSinceReorder;
+
   void testConstraintStateSpaceOrThrow(const TestablePtr& constraint);
 };
 
@@ -8,6 +8,7 @@
 #include <dart/collision/CollisionFilter.hpp>
 #include <dart/collision/CollisionGroup.hpp>
 #include <dart/collision/CollisionOption.hpp>
+#include <dart/collision/CollisionResult.hpp>
 #include "aikido/common/pointers.hpp"
 #include "aikido/constraint/Testable.hpp"
 #include "aikido/constraint/dart/CollisionFreeOutcome.hpp"
@@ -55,6 +56,15 @@ public:
       const aikido::statespace::StateSpace::State* _state,
       TestableOutcome* outcome = nullptr) const override;
 
+  /// \copydoc Testable::isSatisfiedBatch()
+  /// \note Consecutive states in a batch (e.g. samples along an edge) tend to
+  /// collide with the same objects, so the group check that detected the most
+  /// recent collision is tried first for the following states.
+  bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::vector<bool>& results,
+      bool stopOnFailure = true) const override;
+
   /// \copydoc Testable::createOutcome()
   /// \note Returns an instance of CollisionFreeOutcome.
   std::unique_ptr<TestableOutcome> createOutcome() const override;
@@ -85,6 +95,15 @@ public:
 private:
   using CollisionGroup = ::dart::collision::CollisionGroup;
 
+  /// Runs the \c index-th collision check, where pairwise checks come before
+  /// self checks.
+  ///
+  /// \param index index of the check to run
+  /// \param[out] result collision result of the check
+  /// \return true if the check detected a collision
+  bool collide(
+      std::size_t index, ::dart::collision::CollisionResult* result) const;
+
   aikido::statespace::dart::MetaSkeletonStateSpacePtr mMetaSkeletonStateSpace;
   ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
   std::shared_ptr<::dart::collision::CollisionDetector> mCollisionDetector;
@@ -110,16 +110,34 @@ public:
   /// se(3) tangent vector follows dart convention:
   ///   top 3 rows is the angle-axis representation of _s's rotation.
   ///   bottom 3 rows represent the translation.
+  /// The jacobian is computed in closed form. Where a coordinate of _s lies
+  /// exactly on a bound, the distance is treated as constant in it.
   /// \param _s State to be evaluated at.
   /// \param[out] _out Jacobian, 6 x 6 matrix.
   void getJacobian(
       const statespace::StateSpace::State* _s,
       Eigen::MatrixXd& _out) const override;
 
+  /// Evaluates the value and the jacobian of TSR together, sharing the
+  /// transform of _s into the TSR frame. See getValue and getJacobian.
+  /// \param _s State to be evaluated at.
+  /// \param[out] _val Value, vector of size 6.
+  /// \param[out] _jac Jacobian, 6 x 6 matrix.
+  void getValueAndJacobian(
+      const statespace::StateSpace::State* _s,
+      Eigen::VectorXd& _val,
+      Eigen::MatrixXd& _jac) const override;
+
   // Documentation inherited.
   std::vector<ConstraintType> getConstraintTypes() const override;
 
-  // Documentation inherited.
+  /// Projects _s onto this TSR by clamping each translation and
+  /// roll-pitch-yaw coordinate of _s, expressed in the TSR frame, to its
+  /// bounds. Angles outside their bounds move to the nearest bound modulo
+  /// 2 pi.
+  /// \param _s State to project.
+  /// \param[out] _out Projected state. May be the same as _s.
+  /// \return true
   bool project(
       const statespace::StateSpace::State* _s,
       statespace::StateSpace::State* _out) const override;
@@ -144,6 +162,48 @@ public:
   Eigen::Isometry3d mTw_e;
 
 private:
+  /// Recomputes the inverses of mT0_w and mTw_e.
+  void updateInverseTransforms();
+
+  /// Returns the inverse of mT0_w.
+  Eigen::Isometry3d getT0_wInverse() const;
+
+  /// Returns the inverse of mTw_e.
+  Eigen::Isometry3d getTw_eInverse() const;
+
+  /// Returns _T0_s in the TSR frame, i.e. T0_w^-1 * _T0_s * Tw_e^-1.
+  Eigen::Isometry3d computeTw_s(const Eigen::Isometry3d& _T0_s) const;
+
+  /// Computes the distance of _Tw_s from the bounds in each of the
+  /// coordinates `x, y, z, roll, pitch, yaw`.
+  /// \param _Tw_s Transform in the TSR frame.
+  /// \param[out] _distance Distance from the bounds, vector of size 6.
+  /// \param[out] _slopes Derivative of each distance with respect to its
+  ///        coordinate: -1 below the bounds, 1 above them and 0 within them.
+  /// \param[out] _nearest Coordinates of the nearest transform within the
+  ///        bounds.
+  void computeDistance(
+      const Eigen::Isometry3d& _Tw_s,
+      Eigen::VectorXd& _distance,
+      Eigen::Vector6d& _slopes,
+      Eigen::Vector6d& _nearest) const;
+
+  /// Computes the jacobian of the distance at _T0_s, given its transform
+  /// _Tw_s into the TSR frame and the slopes from computeDistance.
+  void computeJacobian(
+      const Eigen::Isometry3d& _T0_s,
+      const Eigen::Isometry3d& _Tw_s,
+      const Eigen::Vector6d& _slopes,
+      Eigen::MatrixXd& _out) const;
+
+  /// Inverses of mT0_w and mTw_e, and the transforms they were computed
+  /// from. Since mT0_w and mTw_e are public, the inverses are only used
+  /// while these match.
+  Eigen::Isometry3d mT0_wInverse;
+  Eigen::Isometry3d mTw_eInverse;
+  Eigen::Isometry3d mInvertedT0_w;
+  Eigen::Isometry3d mInvertedTw_e;
+
   /// Tolerance used in isSatisfied as a testable
   double mTestableTolerance;
   std::unique_ptr<common::RNG> mRng;
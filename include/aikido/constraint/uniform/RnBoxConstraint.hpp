@@ -52,6 +52,12 @@ public:
       const statespace::StateSpace::State* state,
       TestableOutcome* outcome = nullptr) const override;
 
+  // Documentation inherited.
+  bool isSatisfiedBatch(
+      const std::vector<const statespace::StateSpace::State*>& states,
+      std::vector<bool>& results,
+      bool stopOnFailure = true) const override;
+
   /// Return an instance of DefaultTestableOutcome, since this class doesn't
   /// have a more specialized TestableOutcome derivative assigned to it.
   std::unique_ptr<TestableOutcome> createOutcome() const override;
@@ -198,6 +198,38 @@ bool RBoxConstraint<N>::isSatisfied(
   return true;
 }
 
+//==============================================================================
+template <int N>
+bool RBoxConstraint<N>::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::vector<bool>& results,
+    bool stopOnFailure) const
+{
+  results.assign(states.size(), false);
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    // getValue() maps the state in place, so no tangent buffer is needed.
+    const auto value = mSpace->getValue(
+        static_cast<const typename statespace::R<N>::State*>(states[i]));
+
+    // Written in terms of the violations, rather than the bounds, so NaNs are
+    // treated the same way as in isSatisfied().
+    results[i] = !(value.array() < mLowerLimits.array()).any()
+                 && !(value.array() > mUpperLimits.array()).any();
+
+    if (!results[i])
+    {
+      allSatisfied = false;
+      if (stopOnFailure)
+        break;
+    }
+  }
+
+  return allSatisfied;
+}
+
 //==============================================================================
 template <int N>
 std::unique_ptr<TestableOutcome> RBoxConstraint<N>::createOutcome() const
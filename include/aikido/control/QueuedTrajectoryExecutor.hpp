@@ -1,6 +1,7 @@
 #ifndef AIKIDO_CONTROL_QUEUEDTRAJECTORYEXECUTOR_HPP_
 #define AIKIDO_CONTROL_QUEUEDTRAJECTORYEXECUTOR_HPP_
 
+#include <functional>
 #include <queue>
 #include <dart/dart.hpp>
 #include "aikido/control/TrajectoryExecutor.hpp"
@@ -8,15 +9,45 @@
 namespace aikido {
 namespace control {
 
+namespace detail {
+class SplicedTrajectory;
+}
+
 /// Wraps a TrajectoryExecutor to enable queuing trajectories for execution.
+///
+/// By default, a queued trajectory is started once the underlying executor
+/// reports that the previous one has finished, which is one step after it
+/// reached its end. In look-ahead mode, a queued trajectory that starts where
+/// the previous one ends is appended to the trajectory being executed
+/// instead, so it starts at the exact end time of the previous one, within
+/// the same step. This requires the underlying executor to evaluate the
+/// trajectory while it executes it, e.g. KinematicSimulationTrajectoryExecutor.
 class QueuedTrajectoryExecutor : public TrajectoryExecutor
 {
 public:
+  /// Function that blends the junction between two trajectories executed
+  /// back to back in look-ahead mode, e.g. by retiming \c next with the
+  /// parabolic timer so it continues from the velocity at the end of
+  /// \c previous. It returns the trajectory to execute after \c previous in
+  /// place of \c next.
+  using JunctionBlender = std::function<trajectory::TrajectoryPtr(
+      const trajectory::Trajectory& previous, trajectory::TrajectoryPtr next)>;
+
   /// Constructor
   ///
   /// \param executor Underlying TrajectoryExecutor
+  /// \param lookAhead Whether to append queued trajectories to the trajectory
+  /// being executed
+  /// \param junctionTolerance Maximum distance between the end of a
+  /// trajectory and the start of the next one for them to be executed back to
+  /// back in look-ahead mode
+  /// \param blender Optional function that blends the junction between
+  /// trajectories executed back to back in look-ahead mode
   explicit QueuedTrajectoryExecutor(
-      std::shared_ptr<TrajectoryExecutor> executor);
+      std::shared_ptr<TrajectoryExecutor> executor,
+      bool lookAhead = false,
+      double junctionTolerance = 1e-6,
+      JunctionBlender blender = nullptr);
 
   virtual ~QueuedTrajectoryExecutor();
 
@@ -42,12 +73,47 @@ public:
   void abort() override;
 
 private:
+  /// In look-ahead mode, appends queued trajectories that start where the
+  /// trajectory being executed ends to it. Requires mMutex to be locked.
+  void spliceQueuedTrajectories();
+
+  /// Returns whether \c next starts within mJunctionTolerance of the end of
+  /// \c previous.
+  bool isContinuous(
+      const trajectory::Trajectory& previous,
+      const trajectory::Trajectory& next) const;
+
+  /// Sets all promises to an exception and clears the queues. Requires
+  /// mMutex to be locked.
+  void abortQueue();
+
   /// Underlying TrajectoryExecutor
   std::shared_ptr<TrajectoryExecutor> mExecutor;
 
+  /// Whether queued trajectories are appended to the trajectory being
+  /// executed
+  bool mLookAhead;
+
+  /// Maximum distance between trajectories executed back to back
+  double mJunctionTolerance;
+
+  /// Blends the junction between trajectories executed back to back
+  JunctionBlender mBlender;
+
   /// Whether a trajectory is currently being executed
   bool mInProgress;
 
+  /// Number of promises at the front of mPromiseQueue that belong to the
+  /// trajectory being executed
+  std::size_t mNumInProgress;
+
+  /// Trajectory being executed in look-ahead mode
+  std::shared_ptr<detail::SplicedTrajectory> mSplicedTrajectory;
+
+  /// Whether the front of mTrajectoryQueue cannot be appended to
+  /// mSplicedTrajectory
+  bool mSplicingStopped;
+
   /// Future from wrapped executor
   std::future<void> mFuture;
 
@@ -57,7 +123,8 @@ private:
   /// Queue of promises made by this to the client
   std::queue<std::shared_ptr<std::promise<void>>> mPromiseQueue;
 
-  /// Manages access to mInProgress, mFuture, mTrajectoryQueue, mPromiseQueue
+  /// Manages access to mInProgress, mNumInProgress, mSplicedTrajectory,
+  /// mSplicingStopped, mFuture, mTrajectoryQueue, mPromiseQueue
   std::mutex mMutex;
 };
 
@@ -7,10 +7,13 @@
 #include "planner/ompl/CRRTConnect.hpp"
 #include "planner/ompl/GeometricStateSpace.hpp"
 #include "planner/ompl/GoalRegion.hpp"
+#include "planner/ompl/LazySP.hpp"
 #include "planner/ompl/MotionValidator.hpp"
 #include "planner/ompl/Planner.hpp"
+#include "planner/ompl/RoadmapPlanner.hpp"
 #include "planner/ompl/StateSampler.hpp"
 #include "planner/ompl/StateValidityChecker.hpp"
 #include "planner/ompl/dart.hpp"
+#include "planner/parabolic/OnlineShortcutTrajectory.hpp"
 #include "planner/parabolic/ParabolicSmoother.hpp"
 #include "planner/parabolic/ParabolicTimer.hpp"
@@ -140,6 +140,14 @@ public:
   /// Return the Aikido StateSpace that this OMPL StateSpace wraps
   statespace::StateSpacePtr getAikidoStateSpace() const;
 
+  /// Prepares to interpolate repeatedly between two states, using the
+  /// \c Interpolator::prepareEdge of the wrapped interpolator. The edge
+  /// interpolates the wrapped aikido states.
+  /// \param _from The state at the start of the edge
+  /// \param _to The state at the end of the edge
+  std::unique_ptr<statespace::Interpolator::Edge> prepareEdge(
+      const ::ompl::base::State* _from, const ::ompl::base::State* _to) const;
+
 private:
   statespace::StateSpacePtr mStateSpace;
   statespace::InterpolatorPtr mInterpolator;
@@ -0,0 +1,293 @@
+#ifndef AIKIDO_PLANNER_OMPL_LAZYSP_HPP_
+#define AIKIDO_PLANNER_OMPL_LAZYSP_HPP_
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <ompl/base/Planner.h>
+#include <ompl/datastructures/NearestNeighbors.h>
+#include <ompl/geometric/planners/PlannerIncludes.h>
+
+#include "../../planner/ompl/BackwardCompatibility.hpp"
+#include "../../planner/ompl/GeometricStateSpace.hpp"
+
+namespace aikido {
+namespace planner {
+namespace ompl {
+
+/// Lazy shortest path planner on a roadmap.
+///
+/// The roadmap is built without checking the validity of its vertices or
+/// edges. To answer a query, the planner repeatedly searches the roadmap for
+/// the shortest path that does not contain any vertex or edge known to be
+/// invalid, and only then checks the vertices and edges of that path. Edges
+/// are checked in decreasing order of their estimated probability of being
+/// invalid, which grows with their length and with the number of invalid
+/// vertices and edges around them, so that a bad path is rejected after as
+/// few checks as possible. If an edge is invalid, the planner searches again.
+/// If no path is found, the roadmap is grown by a batch of samples.
+///
+/// The roadmap and the validity of its vertices and edges are kept across
+/// queries, so a planner can be reused for several queries in a static
+/// scene. Setting a new problem definition only removes the start and goal
+/// vertices of the previous query from the roadmap, while \c clear discards
+/// the roadmap. If the
+/// scene changes, \c resetValidity lets the planner check the vertices and
+/// edges of the roadmap again as they are needed. The roadmap can be saved to
+/// and loaded from a stream if the planner operates in a
+/// GeometricStateSpace.
+///
+/// See:
+/// Dellin, Christopher M., and Siddhartha S. Srinivasa. "A Unifying
+/// Formalism for Shortest Path Problems with Expensive Edge Evaluations via
+/// Lazy Best-First Search over Paths with Edge Selectors." ICAPS 2016.
+class LazySP : public ::ompl::base::Planner
+{
+public:
+  /// Constructor
+  /// \param _si Information about the planning space
+  explicit LazySP(const ::ompl::base::SpaceInformationPtr& _si);
+
+  /// Constructor
+  /// \param _si Information about the planning space
+  /// \param _name A name for this planner
+  LazySP(
+      const ::ompl::base::SpaceInformationPtr& _si, const std::string& _name);
+
+  /// Destructor
+  virtual ~LazySP();
+
+  /// Get the roadmap. Vertices and edges known to be invalid are omitted.
+  /// \param[out] _data Data about the roadmap
+  void getPlannerData(::ompl::base::PlannerData& _data) const override;
+
+  /// Function that can solve the motion planning problem. This function can be
+  /// called multiple times on the same problem, without calling clear() in
+  /// between, to continue work on an unsolved problem. The function
+  /// terminates if the call to ptc returns true.
+  /// \param _ptc Conditions for terminating planning before a solution is found
+  ::ompl::base::PlannerStatus solve(
+      const ::ompl::base::PlannerTerminationCondition& _ptc) override;
+
+  /// Solve the motion planning problem in the given time
+  /// \param _solveTime The maximum allowable time to solve the planning problem
+  ::ompl::base::PlannerStatus solve(double _solveTime);
+
+  /// Set the problem definition, removing the start and goal vertices of the
+  /// previous query from the roadmap but keeping the rest of it.
+  /// \param _pdef The problem definition
+  void setProblemDefinition(
+      const ::ompl::base::ProblemDefinitionPtr& _pdef) override;
+
+  /// Remove the start and goal vertices of the current query, and their
+  /// edges, from the roadmap, but keep the rest of it.
+  void clearQuery();
+
+  /// Clear all internal datastructures, including the roadmap. Planner
+  /// settings are not affected.
+  void clear() override;
+
+  /// Set the number of states sampled each time the roadmap is grown.
+  /// \param _batchSize Number of states, must be positive
+  void setBatchSize(unsigned int _batchSize);
+
+  /// Get the number of states sampled each time the roadmap is grown.
+  unsigned int getBatchSize() const;
+
+  /// Set the maximum number of nearest neighbors each new vertex is connected
+  /// to.
+  /// \param _maxNumNeighbors Number of neighbors, must be positive
+  void setMaxNumNeighbors(unsigned int _maxNumNeighbors);
+
+  /// Get the maximum number of nearest neighbors each new vertex is connected
+  /// to.
+  unsigned int getMaxNumNeighbors() const;
+
+  /// Get the number of vertices in the roadmap, including invalid ones and
+  /// those of the current query.
+  std::size_t getNumVertices() const;
+
+  /// Get the number of edges in the roadmap, including invalid ones.
+  std::size_t getNumEdges() const;
+
+  /// Get the number of vertices and edges whose validity was checked since the
+  /// roadmap was last cleared.
+  std::size_t getNumEvaluations() const;
+
+  /// Mark all vertices and edges of the roadmap as not checked, e.g. after
+  /// obstacles moved. This discards every validity result; the planner checks
+  /// vertices and edges again only once they are on a candidate path.
+  void resetValidity();
+
+  /// Write the roadmap, including the validity of its vertices and edges, to
+  /// a binary stream. The format depends on the architecture. The start and
+  /// goal states of the current query are saved as regular vertices.
+  /// \param _stream Stream to write to
+  /// \throws std::invalid_argument if the planner does not operate in a
+  /// GeometricStateSpace.
+  /// \throws std::runtime_error if writing fails.
+  void saveRoadmap(std::ostream& _stream) const;
+
+  /// Replace the roadmap with one written by saveRoadmap for the same
+  /// StateSpace. This also clears the current query.
+  /// \param _stream Stream to read from
+  /// \throws std::invalid_argument if the planner does not operate in a
+  /// GeometricStateSpace.
+  /// \throws std::runtime_error if the stream does not contain a roadmap of
+  /// this StateSpace. The roadmap is empty in that case.
+  void loadRoadmap(std::istream& _stream);
+
+  /// Perform extra configuration steps, if needed. This call will also issue a
+  /// call to ompl::base::SpaceInformation::setup() if needed. This must be
+  /// called before solving.
+  void setup() override;
+
+protected:
+  /// Validity of a vertex or an edge.
+  enum class Status
+  {
+    UNKNOWN,
+    VALID,
+    INVALID
+  };
+
+  /// Vertex of the roadmap.
+  struct Vertex
+  {
+    /// State of the vertex.
+    ::ompl::base::State* mState;
+
+    /// Validity of the state.
+    Status mStatus;
+
+    /// Indices of the edges incident to this vertex.
+    std::vector<std::size_t> mEdges;
+
+    /// Number of invalid vertices and edges found adjacent to this vertex.
+    std::size_t mNumInvalidNeighbors;
+  };
+
+  /// Edge of the roadmap.
+  struct Edge
+  {
+    /// Indices of the vertices of the edge.
+    std::size_t mSource;
+    std::size_t mTarget;
+
+    /// Distance between the states of the vertices.
+    double mLength;
+
+    /// Validity of the motion between the states of the vertices.
+    Status mStatus;
+  };
+
+  /// Free the memory allocated by this planner
+  virtual void freeMemory();
+
+  /// Create the nearest-neighbors datastructure, if needed, and set its
+  /// distance function.
+  void setupNearestNeighbors();
+
+  /// Returns the state space of the planner.
+  /// \throws std::invalid_argument if it is not a GeometricStateSpace.
+  ompl_shared_ptr<GeometricStateSpace> getGeometricStateSpace() const;
+
+  /// Compute distance between the states of two vertices
+  double distanceFunction(std::size_t _a, std::size_t _b) const;
+
+  /// Add a vertex to the roadmap, and connect it to its nearest neighbors.
+  /// \param _state State of the vertex, copied into the roadmap
+  /// \param _status Validity of the state
+  /// \return Index of the new vertex
+  std::size_t addVertex(const ::ompl::base::State* _state, Status _status);
+
+  /// Add a valid start or goal vertex to the roadmap, and connect it to its
+  /// nearest neighbors. Unlike other vertices, it can be removed again.
+  /// \param _state State of the vertex, copied into the roadmap
+  /// \return Index of the new vertex
+  std::size_t addQueryVertex(const ::ompl::base::State* _state);
+
+  /// Remove a vertex added by addQueryVertex, and its edges, from the roadmap.
+  /// Its index and those of its edges are reused by later vertices and edges.
+  /// \param _index Index of the vertex
+  void removeQueryVertex(std::size_t _index);
+
+  /// Store a new vertex, without connecting it.
+  /// \param _state State of the vertex, copied into the roadmap
+  /// \param _status Validity of the state
+  /// \return Index of the new vertex
+  std::size_t createVertex(const ::ompl::base::State* _state, Status _status);
+
+  /// Connect a vertex to its nearest neighbors, and to the query vertices
+  /// that are as close as them.
+  /// \param _index Index of the vertex
+  /// \param _neighbors Indices of the nearest neighbors
+  void connectVertex(std::size_t _index, std::vector<std::size_t> _neighbors);
+
+  /// Add a batch of samples to the roadmap.
+  /// \param _ptc Conditions for terminating planning
+  void growRoadmap(const ::ompl::base::PlannerTerminationCondition& _ptc);
+
+  /// Search for the shortest path from a start vertex to a goal vertex that
+  /// does not contain any vertex or edge known to be invalid.
+  /// \param[out] _path Indices of the vertices of the path
+  /// \return Whether a path was found
+  bool findShortestPath(std::vector<std::size_t>& _path) const;
+
+  /// Check the validity of the vertices and edges of a path, stopping at the
+  /// first invalid one.
+  /// \param _path Indices of the vertices of the path
+  /// \param _ptc Conditions for terminating planning
+  /// \return Whether all vertices and edges of the path are valid
+  bool evaluatePath(
+      const std::vector<std::size_t>& _path,
+      const ::ompl::base::PlannerTerminationCondition& _ptc);
+
+  /// Returns the index of the edge between two vertices.
+  std::size_t findEdge(std::size_t _source, std::size_t _target) const;
+
+  /// Mark a vertex as invalid.
+  void invalidateVertex(std::size_t _index);
+
+  /// Mark an edge as invalid.
+  void invalidateEdge(std::size_t _index);
+
+  /// State sampler
+  ::ompl::base::StateSamplerPtr mSampler;
+
+  /// A nearest-neighbors datastructure containing the vertices of the roadmap
+  ompl_shared_ptr<::ompl::NearestNeighbors<std::size_t>> mNearestNeighbors;
+
+  /// Vertices of the roadmap
+  std::vector<Vertex> mVertices;
+
+  /// Edges of the roadmap
+  std::vector<Edge> mEdges;
+
+  /// Indices of removed vertices, whose state is nullptr
+  std::vector<std::size_t> mFreeVertices;
+
+  /// Indices of removed edges, whose vertices are invalid indices
+  std::vector<std::size_t> mFreeEdges;
+
+  /// Indices of the start vertices of the current query
+  std::vector<std::size_t> mStartVertices;
+
+  /// Indices of the goal vertices of the current query
+  std::vector<std::size_t> mGoalVertices;
+
+  /// Number of states sampled each time the roadmap is grown
+  unsigned int mBatchSize;
+
+  /// Maximum number of nearest neighbors each new vertex is connected to
+  unsigned int mMaxNumNeighbors;
+
+  /// Number of vertices and edges whose validity was checked
+  std::size_t mNumEvaluations;
+};
+
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_OMPL_LAZYSP_HPP_
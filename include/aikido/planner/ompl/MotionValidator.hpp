@@ -1,7 +1,11 @@
 #ifndef AIKIDO_PLANNER_OMPL_MOTIONVALIDATOR_HPP_
 #define AIKIDO_PLANNER_OMPL_MOTIONVALIDATOR_HPP_
 
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <ompl/base/MotionValidator.h>
+#include "../../constraint/Testable.hpp"
 
 namespace aikido {
 namespace planner {
@@ -9,6 +13,18 @@ namespace ompl {
 
 /// Implement an OMPL MotionValidator.  This class checks the validity
 ///  of path segments between states.
+///
+/// Optionally, \c checkMotion can split the samples along a segment across a
+/// set of worker threads. Each worker tests its share of the samples against
+/// its own \c Testable, so that workers never share a \c MetaSkeleton or a
+/// collision detector, and all workers stop as soon as any of them finds an
+/// invalid sample. The calling thread takes part in the check using the
+/// \c StateValidityChecker of the \c SpaceInformation.
+///
+/// When segments are checked sequentially and the validity checker of the
+/// \c SpaceInformation is a \c StateValidityChecker, all samples along a
+/// segment are interpolated up front and tested with a single call to
+/// \c Testable::isSatisfiedBatch.
 class MotionValidator : public ::ompl::base::MotionValidator
 {
 public:
@@ -22,6 +38,25 @@ public:
       const ::ompl::base::SpaceInformationPtr& _si,
       double _maxDistBtwValidityChecks);
 
+  /// Constructs a MotionValidator that checks segments in parallel. One
+  /// worker thread is created per element of \c _workerConstraints.
+  ///
+  /// \param _si The SpaceInformation describing the planning space where this
+  /// MotionValidator will be used
+  /// \param _maxDistBtwValidityChecks The maximum distance (under the distance
+  /// metric defined on the planning StateSpace) between two points on the
+  /// segment checked for validity
+  /// \param _workerConstraints Validity constraints used by the worker
+  /// threads, one per worker. Each must be equivalent to the validity checker
+  /// of \c _si and must not share any mutable state (e.g. a MetaSkeleton or a
+  /// CollisionGroup) with it or with the other workers' constraints.
+  MotionValidator(
+      const ::ompl::base::SpaceInformationPtr& _si,
+      double _maxDistBtwValidityChecks,
+      std::vector<constraint::TestablePtr> _workerConstraints);
+
+  ~MotionValidator() override;
+
   /// Check if the path between two states, _s1 and _s2, is valid.  This
   /// function assumes _s1 is valid.
   /// \param _s1 The state at the start of the segment
@@ -34,6 +69,8 @@ public:
   // that was valid and the time of that state.  The time is used to
   // parameterize the motion from _s1 to _s2, _s1 being at t=0 and _s2 being at
   // t=1. The function assumes _s1 is valid.
+  /// \note This check is always run sequentially, since it needs to find the
+  /// first invalid state along the segment.
   /// \param _s1 The state at the start of the segment
   /// \param _s2 The state at the end of the segment
   /// \param[out] _lastValid The last valid state on the segment and the segment
@@ -43,8 +80,36 @@ public:
       const ::ompl::base::State* _s2,
       std::pair<::ompl::base::State*, double>& _lastValid) const override;
 
+  /// Returns the number of worker threads used by \c checkMotion, not
+  /// including the calling thread.
+  std::size_t getNumWorkers() const;
+
 private:
+  class WorkerPool;
+
+  /// Tests \c _samples along the segment from \c _s1 to \c _s2 with a single
+  /// batch call to \c _constraint.
+  bool checkMotionBatch(
+      const ::ompl::base::State* _s1,
+      const ::ompl::base::State* _s2,
+      const std::vector<double>& _samples,
+      const constraint::Testable& _constraint) const;
+
   double mSequenceResolution;
+
+  /// Space of the scratch states. Held here, since the scratch states are
+  /// freed after the \c SpaceInformation may have released it.
+  ::ompl::base::StateSpacePtr mStateSpace;
+
+  /// Scratch states reused by \c checkMotionBatch.
+  mutable std::vector<::ompl::base::State*> mBatchStates;
+
+  /// Protects \c mBatchStates.
+  mutable std::mutex mBatchMutex;
+
+  /// Worker threads used for parallel checking, or nullptr if segments are
+  /// checked sequentially.
+  std::unique_ptr<WorkerPool> mWorkerPool;
 };
 
 } // namespace ompl
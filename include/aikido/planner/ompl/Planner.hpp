@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <utility> // std::pair
+#include <vector>
 
 #include "../../constraint/Projectable.hpp"
 #include "../../constraint/Sampleable.hpp"
@@ -15,6 +16,7 @@
 #include "../../trajectory/Interpolated.hpp"
 
 #include <ompl/base/Planner.h>
+#include <ompl/base/PlannerTerminationCondition.h>
 #include <ompl/base/ProblemDefinition.h>
 #include <ompl/base/ScopedState.h>
 #include <ompl/base/SpaceInformation.h>
@@ -50,6 +52,9 @@ namespace ompl {
 /// solution
 /// \param _maxDistanceBtwValidityChecks The maximum distance (under dmetric)
 /// between validity checking two successive points on a tree extension
+/// \param _workerValidityConstraints If not empty, edges are checked in
+/// parallel by one worker thread per constraint in this list. See
+/// getSpaceInformation.
 template <class PlannerType>
 trajectory::InterpolatedPtr planOMPL(
     const statespace::StateSpace::State* _start,
@@ -62,7 +67,9 @@ trajectory::InterpolatedPtr planOMPL(
     constraint::TestablePtr _boundsConstraint,
     constraint::ProjectablePtr _boundsProjector,
     double _maxPlanTime,
-    double _maxDistanceBtwValidityChecks);
+    double _maxDistanceBtwValidityChecks,
+    std::vector<constraint::TestablePtr> _workerValidityConstraints
+    = std::vector<constraint::TestablePtr>());
 
 /// Use the template OMPL Planner type to plan a trajectory that moves from the
 /// start to a goal region. Returns nullptr on planning failure.
@@ -228,6 +235,11 @@ trajectory::InterpolatedPtr planCRRTConnect(
 /// valid bounds defined on the StateSpace
 /// \param _maxDistanceBtwValidityChecks The maximum distance (under dmetric)
 /// between validity checking two successive points on a tree extension
+/// \param _workerValidityConstraints If not empty, edges are checked in
+/// parallel by one worker thread per constraint in this list. Each constraint
+/// must be equivalent to \c _validityConstraint, but must not share any
+/// mutable state (e.g. a MetaSkeleton or collision groups) with it or with
+/// any other constraint in the list. The bounds constraint is added to each.
 ::ompl::base::SpaceInformationPtr getSpaceInformation(
     statespace::StateSpacePtr _stateSpace,
     statespace::InterpolatorPtr _interpolator,
@@ -236,7 +248,9 @@ trajectory::InterpolatedPtr planCRRTConnect(
     constraint::TestablePtr _validityConstraint,
     constraint::TestablePtr _boundsConstraint,
     constraint::ProjectablePtr _boundsProjector,
-    double _maxDistanceBtwValidityChecks);
+    double _maxDistanceBtwValidityChecks,
+    std::vector<constraint::TestablePtr> _workerValidityConstraints
+    = std::vector<constraint::TestablePtr>());
 
 /// Create an OMPL GoalRegion from a Testable and Sampler that describe the goal
 /// region
@@ -269,6 +283,25 @@ trajectory::InterpolatedPtr planOMPL(
     statespace::InterpolatorPtr _interpolator,
     double _maxPlanTime);
 
+/// Use the template OMPL Planner type to plan in a custom OMPL Space
+/// Information and problem definition and return an aikido Trajectory.
+/// Returns nullptr on planning failure.
+/// \param _planner Points to some OMPL planner.
+/// \param _pdef The ProblemDefintion. This contains start and goal conditions
+/// for the planner.
+/// \param _sspace The aikido StateSpace to plan against. Used for constructing
+/// the return trajectory.
+/// \param _interpolator An aikido interpolator that can be used with the
+/// _stateSpace.
+/// \param _terminationCondition Condition that stops the planner, e.g. to
+/// cancel planning from another thread
+trajectory::InterpolatedPtr planOMPL(
+    const ::ompl::base::PlannerPtr& _planner,
+    const ::ompl::base::ProblemDefinitionPtr& _pdef,
+    statespace::StateSpacePtr _sspace,
+    statespace::InterpolatorPtr _interpolator,
+    const ::ompl::base::PlannerTerminationCondition& _terminationCondition);
+
 /// Take in an aikido trajectory and simplify it using OMPL methods
 /// \param _stateSpace The StateSpace that the planner must plan within
 /// \param _interpolator An Interpolator defined on the StateSpace. This is used
@@ -0,0 +1,144 @@
+#ifndef AIKIDO_PLANNER_OMPL_ROADMAPPLANNER_HPP_
+#define AIKIDO_PLANNER_OMPL_ROADMAPPLANNER_HPP_
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <Eigen/Core>
+#include <dart/dynamics/dynamics.hpp>
+#include "../../common/RNG.hpp"
+#include "../../constraint/Testable.hpp"
+#include "../../planner/World.hpp"
+#include "../../planner/ompl/BackwardCompatibility.hpp"
+#include "../../planner/ompl/LazySP.hpp"
+#include "../../statespace/Interpolator.hpp"
+#include "../../statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "../../trajectory/Interpolated.hpp"
+
+namespace aikido {
+namespace planner {
+namespace ompl {
+
+/// Multi-query planner for a MetaSkeleton in a World whose obstacles rarely
+/// move, e.g. a static workcell.
+///
+/// All queries share a LazySP roadmap, so that later queries mostly search
+/// the roadmap and reuse its checked edges instead of planning from scratch.
+/// The roadmap can be saved to a file and loaded again at startup.
+///
+/// Before each query, the planner compares the configurations of the
+/// Skeletons in the World, other than the controlled degrees of freedom of
+/// the MetaSkeleton, with those the roadmap was checked against. If any of
+/// them changed, or Skeletons were added or removed, all vertices and edges
+/// of the roadmap are marked as not checked, since the planner does not know
+/// which of them a change affects. LazySP then only checks them again as they
+/// are used. Other changes, e.g. to collision shapes, are not detected; call
+/// \c invalidate after them.
+///
+/// Planning locks the Skeleton of the MetaSkeleton and restores its
+/// configuration afterwards.
+class RoadmapPlanner
+{
+public:
+  /// Constructor.
+  /// \param _stateSpace The StateSpace of the MetaSkeleton
+  /// \param _metaSkeleton The MetaSkeleton to plan for
+  /// \param _world The World containing the Skeleton of the MetaSkeleton and
+  /// the obstacles
+  /// \param _collisionTestable A constraint used to test validity during
+  /// planning, usually a CollisionFree constraint between the MetaSkeleton
+  /// and the obstacles in the World
+  /// \param _rng Random number generator used to sample the roadmap
+  /// \param _maxDistanceBtwValidityChecks The maximum distance (under the
+  /// default distance metric of the StateSpace) between validity checking two
+  /// successive points on an edge
+  RoadmapPlanner(
+      statespace::dart::MetaSkeletonStateSpacePtr _stateSpace,
+      ::dart::dynamics::MetaSkeletonPtr _metaSkeleton,
+      WorldPtr _world,
+      constraint::TestablePtr _collisionTestable,
+      std::unique_ptr<common::RNG> _rng,
+      double _maxDistanceBtwValidityChecks = 0.1);
+
+  /// Plan a trajectory from the start to the goal state, growing the roadmap
+  /// if needed. The start and goal states are removed from the roadmap again
+  /// afterwards. Returns nullptr on planning failure.
+  /// \param _start The start state
+  /// \param _goal The goal state
+  /// \param _maxPlanTime The maximum time to allow the planner to search for
+  /// a solution
+  trajectory::InterpolatedPtr plan(
+      const statespace::StateSpace::State* _start,
+      const statespace::StateSpace::State* _goal,
+      double _maxPlanTime);
+
+  /// Mark all vertices and edges of the roadmap as not checked.
+  void invalidate();
+
+  /// Write the roadmap, and the configurations of the World it was checked
+  /// against, to a binary stream.
+  /// \param _stream Stream to write to
+  /// \throws std::runtime_error if writing fails.
+  void saveRoadmap(std::ostream& _stream) const;
+
+  /// Write the roadmap to a file. See saveRoadmap(std::ostream&).
+  /// \param _filename Name of the file
+  void saveRoadmap(const std::string& _filename) const;
+
+  /// Replace the roadmap with one written by saveRoadmap for the same
+  /// StateSpace. If the World changed since, the roadmap is checked again as
+  /// it is used.
+  /// \param _stream Stream to read from
+  /// \throws std::runtime_error if the stream does not contain a roadmap of
+  /// this StateSpace. The roadmap is empty in that case.
+  void loadRoadmap(std::istream& _stream);
+
+  /// Replace the roadmap with one read from a file. See
+  /// loadRoadmap(std::istream&).
+  /// \param _filename Name of the file
+  void loadRoadmap(const std::string& _filename);
+
+  /// Returns the planner that maintains the roadmap.
+  const ompl_shared_ptr<LazySP>& getPlanner() const;
+
+  /// Returns the StateSpace of the MetaSkeleton.
+  const statespace::dart::MetaSkeletonStateSpacePtr& getStateSpace() const;
+
+  /// Returns the MetaSkeleton to plan for.
+  const ::dart::dynamics::MetaSkeletonPtr& getMetaSkeleton() const;
+
+  /// Returns the constraint used to test validity during planning.
+  const constraint::TestablePtr& getCollisionTestable() const;
+
+  /// Returns the Interpolator of the StateSpace used by the trajectories.
+  const statespace::InterpolatorPtr& getInterpolator() const;
+
+private:
+  /// Positions of the Skeletons in the World, except for the controlled
+  /// degrees of freedom of the MetaSkeleton, by Skeleton name.
+  using WorldConfiguration = std::map<std::string, Eigen::VectorXd>;
+
+  /// Returns the current configuration of the World.
+  WorldConfiguration getWorldConfiguration() const;
+
+  /// Invalidates the roadmap if the World changed since it was checked.
+  void updateValidity();
+
+  statespace::dart::MetaSkeletonStateSpacePtr mStateSpace;
+  ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+  WorldPtr mWorld;
+  constraint::TestablePtr mCollisionTestable;
+  statespace::InterpolatorPtr mInterpolator;
+  ::ompl::base::SpaceInformationPtr mSpaceInformation;
+  ompl_shared_ptr<LazySP> mPlanner;
+
+  /// Configuration of the World the roadmap was checked against.
+  WorldConfiguration mWorldConfiguration;
+};
+
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_OMPL_ROADMAPPLANNER_HPP_
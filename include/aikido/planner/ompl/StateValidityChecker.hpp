@@ -31,6 +31,9 @@ public:
   /// \param _state The state to check
   bool isValid(const ::ompl::base::State* _state) const override;
 
+  /// Returns the constraint tested by this ValidityChecker.
+  constraint::TestablePtr getConstraint() const;
+
 private:
   constraint::TestablePtr mConstraint;
 };
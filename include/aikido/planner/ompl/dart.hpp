@@ -1,6 +1,7 @@
 #ifndef AIKIDO_PLANNER_OMPL_DART_HPP_
 #define AIKIDO_PLANNER_OMPL_DART_HPP_
 
+#include <vector>
 #include <ompl/base/SpaceInformation.h>
 #include <aikido/constraint/Testable.hpp>
 #include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
@@ -19,11 +20,17 @@ namespace ompl {
 /// \param _maxDistanceBtwValidityChecks The maximum distance (under dmetric)
 /// between validity checking two successive points on a tree extension
 /// \param _rng A random number generator to be used by state samplers
+/// \param _workerValidityConstraints If not empty, edges are checked in
+/// parallel by one worker thread per constraint in this list. Each constraint
+/// must be equivalent to \c _validityConstraint, but operate on its own copy
+/// of the MetaSkeleton and collision groups.
 ::ompl::base::SpaceInformationPtr createSpaceInformation(
     statespace::dart::MetaSkeletonStateSpacePtr _stateSpace,
     constraint::TestablePtr _validityConstraint,
     double _maxDistanceBtwValidityChecks,
-    std::unique_ptr<common::RNG> _rng);
+    std::unique_ptr<common::RNG> _rng,
+    std::vector<constraint::TestablePtr> _workerValidityConstraints
+    = std::vector<constraint::TestablePtr>());
 
 } // namespace ompl
 } // namespace planner
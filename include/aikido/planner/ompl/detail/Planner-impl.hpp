@@ -22,7 +22,8 @@ trajectory::InterpolatedPtr planOMPL(
     constraint::TestablePtr _boundsConstraint,
     constraint::ProjectablePtr _boundsProjector,
     double _maxPlanTime,
-    double _maxDistanceBtwValidityChecks)
+    double _maxDistanceBtwValidityChecks,
+    std::vector<constraint::TestablePtr> _workerValidityConstraints)
 {
   // Create a SpaceInformation.  This function will ensure state space matching
   auto si = getSpaceInformation(
@@ -33,7 +34,8 @@ trajectory::InterpolatedPtr planOMPL(
       std::move(_validityConstraint),
       std::move(_boundsConstraint),
       std::move(_boundsProjector),
-      _maxDistanceBtwValidityChecks);
+      _maxDistanceBtwValidityChecks,
+      std::move(_workerValidityConstraints));
 
   // Start and states
   auto pdef = ompl_make_shared<::ompl::base::ProblemDefinition>(si);
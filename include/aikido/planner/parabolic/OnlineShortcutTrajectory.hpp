@@ -0,0 +1,161 @@
+#ifndef AIKIDO_PLANNER_PARABOLIC_ONLINESHORTCUTTRAJECTORY_HPP_
+#define AIKIDO_PLANNER_PARABOLIC_ONLINESHORTCUTTRAJECTORY_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <Eigen/Dense>
+#include "aikido/common/RNG.hpp"
+#include "aikido/constraint/Testable.hpp"
+#include "aikido/planner/parabolic/ParabolicSmoother.hpp"
+#include "aikido/trajectory/Spline.hpp"
+#include "aikido/trajectory/Trajectory.hpp"
+
+namespace aikido {
+namespace planner {
+namespace parabolic {
+
+/// Timed trajectory that is shortcut using parabolic splines in a background
+/// thread while it is being executed.
+///
+/// The trajectory can be executed immediately: until a shortcut is found, it
+/// is the trajectory it was constructed from. A shortcut is only spliced in
+/// if it starts at least \c _leadTime after the latest time at which this
+/// trajectory has been evaluated, so an executor that evaluates it while
+/// executing it, e.g. KinematicSimulationTrajectoryExecutor, never sees the
+/// part it has already executed change. Executors that evaluate the whole
+/// trajectory up front end shortcutting instead.
+///
+/// \c _feasibilityCheck is evaluated from the background thread, so it must
+/// not share a MetaSkeleton with the executor. For example, use the collision
+/// testable of a context of robot::PlanningContextPool.
+class OnlineShortcutTrajectory : public trajectory::Trajectory
+{
+public:
+  /// Starts shortcutting \c _inputTrajectory in a background thread.
+  ///
+  /// \param _inputTrajectory input timed trajectory
+  /// \param _feasibilityCheck Check whether a position is feasible
+  /// \param _maxVelocity maximum velocity for each dimension
+  /// \param _maxAcceleration maximum acceleration for each dimension
+  /// \param _rng A random generator for sampling time in shortcut.
+  /// \param _timelimit The maximum time to allow for doing shortcut
+  /// \param _leadTime minimum time between the latest evaluated time of this
+  /// trajectory and the start of a shortcut. It should exceed the period at
+  /// which the trajectory is evaluated during execution.
+  /// \param _checkResolution the resolution in discretizing a segment in
+  /// checking the feasibility of the segment
+  /// \param _tolerance this tolerance is used in a piecewise linear
+  /// discretization that deviates no more than \c _tolerance
+  /// from the parabolic ramp along any axis, and then checks for
+  /// configuration and segment feasibility along that piecewise linear path.
+  OnlineShortcutTrajectory(
+      const trajectory::Spline& _inputTrajectory,
+      constraint::TestablePtr _feasibilityCheck,
+      const Eigen::VectorXd& _maxVelocity,
+      const Eigen::VectorXd& _maxAcceleration,
+      std::unique_ptr<common::RNG> _rng,
+      double _timelimit = DEFAULT_TIMELIMT,
+      double _leadTime = DEFAULT_LEAD_TIME,
+      double _checkResolution = DEFAULT_CHECK_RESOLUTION,
+      double _tolerance = DEFAULT_TOLERANCE);
+
+  /// Stops shortcutting.
+  virtual ~OnlineShortcutTrajectory();
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  std::size_t getNumDerivatives() const override;
+
+  // Documentation inherited.
+  double getDuration() const override;
+
+  // Documentation inherited.
+  double getStartTime() const override;
+
+  // Documentation inherited.
+  double getEndTime() const override;
+
+  // Documentation inherited.
+  void evaluate(
+      double _t, statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  void evaluateDerivative(
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const override;
+
+  /// Returns the current trajectory. It is not changed by later shortcuts.
+  std::shared_ptr<const trajectory::Spline> getSpline() const;
+
+  /// Returns the latest time at which this trajectory has been evaluated.
+  double getExecutionTime() const;
+
+  /// Returns the number of shortcuts spliced in so far.
+  std::size_t getNumShortcuts() const;
+
+  /// Returns whether the background thread is still shortcutting.
+  bool isShortcutting() const;
+
+  /// Waits until shortcutting ends.
+  void wait();
+
+  /// Stops shortcutting and waits for the background thread to finish.
+  void stop();
+
+private:
+  /// Returns the current trajectory, after advancing mExecutionTime to _t.
+  std::shared_ptr<const trajectory::Spline> advanceTo(double _t) const;
+
+  /// Replaces the current trajectory with _spline, which shortcuts it from
+  /// _shortcutTime on, unless _shortcutTime is earlier than mExecutionTime +
+  /// mLeadTime. Returns whether the trajectory was replaced.
+  bool splice(
+      std::unique_ptr<trajectory::Spline> _spline, double _shortcutTime);
+
+  /// State space of the trajectory.
+  statespace::ConstStateSpacePtr mStateSpace;
+
+  /// Number of derivatives of the trajectory.
+  std::size_t mNumDerivatives;
+
+  /// Start time of the trajectory, which shortcuts do not change.
+  double mStartTime;
+
+  /// Set to the value of \c _leadTime.
+  double mLeadTime;
+
+  /// Current trajectory.
+  std::shared_ptr<const trajectory::Spline> mSpline;
+
+  /// Latest time at which the trajectory has been evaluated.
+  mutable double mExecutionTime;
+
+  /// Number of shortcuts spliced in.
+  std::size_t mNumShortcuts;
+
+  /// Whether shortcutting has been stopped.
+  bool mStopped;
+
+  /// Manages access to mSpline, mExecutionTime, mNumShortcuts and mStopped.
+  mutable std::mutex mMutex;
+
+  /// Whether the background thread is running.
+  std::atomic_bool mRunning;
+
+  /// Serializes joining mThread.
+  std::mutex mThreadMutex;
+
+  /// Background thread shortcutting the trajectory.
+  std::thread mThread;
+};
+
+} // namespace parabolic
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_PARABOLIC_ONLINESHORTCUTTRAJECTORY_HPP_
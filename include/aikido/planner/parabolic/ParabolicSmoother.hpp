@@ -1,6 +1,7 @@
 #ifndef AIKIDO_PLANNER_PARABOLIC_PARABOLICSMOOTHER_HPP_
 #define AIKIDO_PLANNER_PARABOLIC_PARABOLICSMOOTHER_HPP_
 
+#include <vector>
 #include <Eigen/Dense>
 #include "aikido/planner/TrajectoryPostProcessor.hpp"
 #include "aikido/trajectory/Interpolated.hpp"
@@ -15,6 +16,9 @@ constexpr double DEFAULT_BLEND_RADIUS = 0.5;
 constexpr int DEFAULT_BLEND_ITERATIONS = 4;
 constexpr double DEFAULT_CHECK_RESOLUTION = 1e-4;
 constexpr double DEFAULT_TOLERANCE = 1e-3;
+constexpr double DEFAULT_LEAD_TIME = 0.1;
+
+class OnlineShortcutTrajectory;
 
 /// Shortcut waypoints in a trajectory using parabolic splines.
 ///
@@ -53,6 +57,46 @@ std::unique_ptr<trajectory::Spline> doShortcut(
     double _checkResolution = DEFAULT_CHECK_RESOLUTION,
     double _tolerance = DEFAULT_TOLERANCE);
 
+/// Shortcut waypoints in a trajectory using parabolic splines, checking
+/// shortcuts in parallel.
+///
+/// This function smooths `_inputTrajectory' like doShortcut, but samples and
+/// checks shortcuts in one thread per element of \c _feasibilityChecks,
+/// in rounds:
+///
+/// while _timelimit is not out:
+/// - In each thread, sample two times uniformly at random until the
+///   time-optimal parabolic spline connecting them is feasible.
+/// - Replace the portions of the trajectory between the pairs of times by
+///   their splines, starting from the spline that saves the most time and
+///   skipping those that overlap a replaced portion.
+///
+/// \param _inputTrajectory input piecewise Geodesic trajectory
+/// \param _feasibilityChecks Check whether a position is feasible, one per
+/// thread. They are called concurrently, so they must not share state, e.g.
+/// a MetaSkeleton; robot::PlanningContextPool provides such testables.
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _rng A random generator, from which the generators of the threads
+/// are cloned.
+/// \param _timelimit The maximum time to allow for doing shortcut
+/// \param _checkResolution the resolution in discretizing a segment in
+/// checking the feasibility of the segment
+/// \param _tolerance this tolerance is used in a piecewise linear
+/// discretization that deviates no more than \c _tolerance
+/// from the parabolic ramp along any axis, and then checks for
+/// configuration and segment feasibility along that piecewise linear path.
+/// \return smoothed trajectory that satisfies acceleration constraints
+std::unique_ptr<trajectory::Spline> doShortcutParallel(
+    const trajectory::Spline& _inputTrajectory,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit = DEFAULT_TIMELIMT,
+    double _checkResolution = DEFAULT_CHECK_RESOLUTION,
+    double _tolerance = DEFAULT_TOLERANCE);
+
 /// Blend around waypoints in a trajectory using parabolic splines.
 ///
 /// This function smooths `_inputTrajectory` by blending around
@@ -181,7 +225,46 @@ public:
       const aikido::common::RNG& _rng,
       const aikido::constraint::TestablePtr& _collisionTestable) override;
 
+  /// Performs parabolic timing on an input trajectory and returns it without
+  /// waiting for shortcutting, which continues in a background thread for
+  /// the shortcut timelimit while the trajectory is executed. Blending is not
+  /// performed. See OnlineShortcutTrajectory, which must be included to use
+  /// the result.
+  /// \param _inputTraj The untimed trajectory for the arm to process.
+  /// \param _rng Random number generator.
+  /// \param _collisionTestable Collision constraint that must be satisfied
+  ///        after processing. It is evaluated from the background thread.
+  /// \param _leadTime Minimum time between the latest evaluated time of the
+  ///        trajectory and the start of a shortcut.
+  std::unique_ptr<OnlineShortcutTrajectory> postprocessOnline(
+      const aikido::trajectory::Interpolated& _inputTraj,
+      const aikido::common::RNG& _rng,
+      const aikido::constraint::TestablePtr& _collisionTestable,
+      double _leadTime = DEFAULT_LEAD_TIME);
+
+  /// Performs parabolic timing on an input *spline* trajectory and returns it
+  /// without waiting for shortcutting. See the overload above.
+  /// \param _inputTraj The untimed trajectory for the arm to process.
+  /// \param _rng Random number generator.
+  /// \param _collisionTestable Collision constraint that must be satisfied
+  ///        after processing. It is evaluated from the background thread.
+  /// \param _leadTime Minimum time between the latest evaluated time of the
+  ///        trajectory and the start of a shortcut.
+  std::unique_ptr<OnlineShortcutTrajectory> postprocessOnline(
+      const aikido::trajectory::Spline& _inputTraj,
+      const aikido::common::RNG& _rng,
+      const aikido::constraint::TestablePtr& _collisionTestable,
+      double _leadTime = DEFAULT_LEAD_TIME);
+
 private:
+  /// Starts shortcutting a timed trajectory in a background thread, as
+  /// dictated by mEnableShortcut.
+  std::unique_ptr<OnlineShortcutTrajectory> handleOnlineShortcut(
+      const aikido::trajectory::Spline& _timedTraj,
+      const aikido::common::RNG& _rng,
+      const aikido::constraint::TestablePtr& _collisionTestable,
+      double _leadTime);
+
   /// Common logic to do shortcutting and/or blending on the input trajectory
   /// as dictated by mEnableShortcut and mEnableBlend.
   std::unique_ptr<aikido::trajectory::Spline> handleShortcutOrBlend(
@@ -2,6 +2,7 @@
 #define AIKIDO_PLANNER_VECTORFIELD_BODYNODEPOSEVECTORFIELD_HPP_
 
 #include <dart/dynamics/BodyNode.hpp>
+#include <aikido/common/BoundedLeastSquares.hpp>
 #include <aikido/planner/vectorfield/VectorField.hpp>
 #include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
 
@@ -119,6 +120,15 @@ protected:
 
   /// Enfoce joint velocity limits
   bool mEnforceJointVelocityLimits;
+
+  /// Solver mapping twists to joint velocities. Together with
+  /// mPreviousVelocity, it makes evaluateVelocity() unsafe to call from
+  /// multiple threads at once.
+  mutable common::BoundedLeastSquaresSolver mSolver;
+
+  /// Joint velocities of the last call to evaluateVelocity(), used as the
+  /// initial guess of the next call.
+  mutable Eigen::VectorXd mPreviousVelocity;
 };
 
 } // namespace vectorfield
@@ -2,6 +2,7 @@
 #define AIKIDO_PLANNER_VECTORFIELD_VECTORFIELDUTIL_HPP_
 
 #include <dart/dynamics/BodyNode.hpp>
+#include <aikido/common/BoundedLeastSquares.hpp>
 #include <aikido/common/Spline.hpp>
 #include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
 #include <aikido/trajectory/Interpolated.hpp>
@@ -27,7 +28,7 @@ namespace vectorfield {
 /// \param[in] stepSize Step size in second. It is used in evaluating
 /// position bounds violation. It assumes that whether moving the time of
 /// stepSize by maximum joint velocity will reach the limit.
-/// \return Whether a joint velocity is found
+/// \return Whether the solver converged to a finite joint velocity
 bool computeJointVelocityFromTwist(
     Eigen::VectorXd& jointVelocity,
     const Eigen::Vector6d& desiredTwist,
@@ -39,6 +40,40 @@ bool computeJointVelocityFromTwist(
     bool enforceJointVelocityLimits,
     double stepSize);
 
+/// Compute joint velocity from a given twist, starting from the joint
+/// velocity passed in, e.g. the one computed at the previous integration
+/// step. Among the joint velocities that achieve the twist equally well,
+/// e.g. for a redundant kinematic chain, the result stays close to it.
+///
+/// \param[in,out] jointVelocity Initial guess, which is replaced by zeros if
+/// its size does not match the number of DOFs. Calculated joint velocities
+/// on output.
+/// \param[in] desiredTwist Desired twist, which consists of angular velocity
+/// and linear velocity.
+/// \param[in] metaSkeleton MetaSkeleton to plan with
+/// \param[in] bodyNode Body node of the end-effector.
+/// \param[in] jointLimitPadding If less then this distance to joint
+/// limit, velocity is bounded in that direction to 0.
+/// \param[in] jointVelocityLowerLimits Joint velocity lower bounds.
+/// \param[in] jointVelocityUpperLimits Joint velocity upper bounds.
+/// \param[in] enforceJointVelocityLimits Whether joint velocity limits are
+/// considered in computation.
+/// \param[in] stepSize Step size in second. It is used in evaluating
+/// position bounds violation.
+/// \param[in] solver Solver whose workspace is reused across calls.
+/// \return Whether the solver converged to a finite joint velocity
+bool computeJointVelocityFromTwist(
+    Eigen::VectorXd& jointVelocity,
+    const Eigen::Vector6d& desiredTwist,
+    const dart::dynamics::MetaSkeletonPtr metaSkeleton,
+    const dart::dynamics::BodyNodePtr bodyNode,
+    double jointLimitPadding,
+    const Eigen::VectorXd& jointVelocityLowerLimits,
+    const Eigen::VectorXd& jointVelocityUpperLimits,
+    bool enforceJointVelocityLimits,
+    double stepSize,
+    common::BoundedLeastSquaresSolver& solver);
+
 /// Compute the twist in global coordinate that corresponds to the gradient of
 /// the geodesic distance between two transforms.
 ///
@@ -0,0 +1,155 @@
+#ifndef AIKIDO_ROBOT_PLANNINGCONTEXTPOOL_HPP_
+#define AIKIDO_ROBOT_PLANNINGCONTEXTPOOL_HPP_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <dart/dynamics/dynamics.hpp>
+#include "aikido/common/pointers.hpp"
+#include "aikido/constraint/Testable.hpp"
+#include "aikido/planner/World.hpp"
+#include "aikido/robot/util.hpp"
+#include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
+
+namespace aikido {
+namespace robot {
+
+AIKIDO_DECLARE_POINTERS(PlanningContextPool)
+
+/// Clone of a World in which a robot can be planned for without modifying,
+/// or locking, the original robot.
+struct PlanningContext
+{
+  /// Clone of the World.
+  planner::WorldPtr mWorld;
+
+  /// Clone of the robot in \c mWorld.
+  dart::dynamics::SkeletonPtr mRobot;
+
+  /// Controlled MetaSkeleton of \c mRobot.
+  dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+
+  /// Collision constraint of \c mMetaSkeleton in \c mWorld.
+  constraint::TestablePtr mCollisionTestable;
+};
+
+/// Pool of planning contexts, each holding its own clone of a World that
+/// contains a robot, so that several threads can plan for the robot at once.
+///
+/// A context is checked out with \c acquire and returned to the pool when
+/// its handle is destroyed. On checkout, the configurations of the Skeletons
+/// in the clone are set to those in the World. If Skeletons were added to
+/// or removed from the World, or changed structure, the World is cloned
+/// again.
+class PlanningContextPool
+{
+public:
+  /// Checked out planning context. It is returned to its pool on
+  /// destruction, so it must not outlive the pool.
+  class Handle
+  {
+  public:
+    Handle(const Handle&) = delete;
+    Handle(Handle&& other);
+    Handle& operator=(const Handle&) = delete;
+    Handle& operator=(Handle&&) = delete;
+
+    ~Handle();
+
+    /// Returns the planning context.
+    PlanningContext& operator*() const;
+
+    /// Returns the planning context.
+    PlanningContext* operator->() const;
+
+  private:
+    friend class PlanningContextPool;
+
+    Handle(
+        PlanningContextPool* pool, std::unique_ptr<PlanningContext> context);
+
+    PlanningContextPool* mPool;
+    std::unique_ptr<PlanningContext> mContext;
+  };
+
+  /// Constructor. Clones \c world \c numContexts times, locking \c world and
+  /// the robot of \c metaSkeleton meanwhile.
+  /// \param[in] space The StateSpace for the metaskeleton
+  /// \param[in] metaSkeleton MetaSkeleton to plan with. Its Skeleton must be
+  /// in \c world.
+  /// \param[in] world World containing the robot and the obstacles
+  /// \param[in] collisionTestableFactory Creates the collision constraint for
+  /// a clone of \c metaSkeleton in a clone of \c world
+  /// \param[in] numContexts Number of contexts. Zero creates one context per
+  /// hardware thread.
+  PlanningContextPool(
+      statespace::dart::MetaSkeletonStateSpacePtr space,
+      dart::dynamics::MetaSkeletonPtr metaSkeleton,
+      planner::WorldPtr world,
+      util::CollisionTestableFactory collisionTestableFactory,
+      std::size_t numContexts = 0);
+
+  PlanningContextPool(const PlanningContextPool&) = delete;
+  PlanningContextPool& operator=(const PlanningContextPool&) = delete;
+
+  virtual ~PlanningContextPool() = default;
+
+  /// Checks out a context, waiting until one is available, and synchronizes
+  /// it with the World.
+  /// \return Handle to the context.
+  Handle acquire();
+
+  /// Checks out \c numContexts contexts at once, waiting until that many are
+  /// available, and synchronizes them with the World. Contexts are never
+  /// held while waiting, so concurrent callers cannot deadlock.
+  /// \param[in] numContexts Number of contexts to check out. Must not exceed
+  /// the number of contexts in this pool.
+  /// \return Handles to the contexts.
+  std::vector<Handle> acquire(std::size_t numContexts);
+
+  /// Returns the number of contexts in this pool.
+  std::size_t getNumContexts() const;
+
+  /// Returns the StateSpace for the metaskeleton.
+  const statespace::dart::MetaSkeletonStateSpacePtr& getStateSpace() const;
+
+  /// Returns the MetaSkeleton that the contexts are clones of.
+  const dart::dynamics::MetaSkeletonPtr& getMetaSkeleton() const;
+
+  /// Returns the World that the contexts are clones of.
+  const planner::WorldPtr& getWorld() const;
+
+private:
+  /// Clones the World into a new context. The caller must lock the World and
+  /// the robot.
+  std::unique_ptr<PlanningContext> createContext() const;
+
+  /// Sets the configurations of \c context to those of the World, cloning
+  /// the World again if its Skeletons have changed.
+  void synchronize(PlanningContext& context) const;
+
+  /// Returns \c context to the pool.
+  void release(std::unique_ptr<PlanningContext> context);
+
+  statespace::dart::MetaSkeletonStateSpacePtr mStateSpace;
+  dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+  dart::dynamics::SkeletonPtr mRobot;
+  planner::WorldPtr mWorld;
+  util::CollisionTestableFactory mCollisionTestableFactory;
+  std::size_t mNumContexts;
+
+  /// Protects \c mAvailableContexts.
+  std::mutex mMutex;
+
+  /// Signaled when a context is returned to the pool.
+  std::condition_variable mContextReturned;
+
+  /// Contexts that are not checked out.
+  std::vector<std::unique_ptr<PlanningContext>> mAvailableContexts;
+};
+
+} // namespace robot
+} // namespace aikido
+
+#endif // AIKIDO_ROBOT_PLANNINGCONTEXTPOOL_HPP_
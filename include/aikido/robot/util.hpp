@@ -1,6 +1,7 @@
 #ifndef AIKIDO_ROBOT_UTIL_HPP_
 #define AIKIDO_ROBOT_UTIL_HPP_
 
+#include <functional>
 #include <dart/dart.hpp>
 #include <dart/dynamics/dynamics.hpp>
 #include "aikido/common/ExecutorThread.hpp"
@@ -10,6 +11,8 @@
 #include "aikido/constraint/dart/TSR.hpp"
 #include "aikido/control/TrajectoryExecutor.hpp"
 #include "aikido/io/yaml.hpp"
+#include "aikido/planner/World.hpp"
+#include "aikido/planner/ompl/RoadmapPlanner.hpp"
 #include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
 #include "aikido/trajectory/Interpolated.hpp"
 #include "aikido/trajectory/Spline.hpp"
@@ -18,6 +21,8 @@
 namespace aikido {
 namespace robot {
 
+class PlanningContextPool;
+
 // TODO: These are planning methods used in Robot classes. These will be
 // removed once we have a Planner API.
 namespace util {
@@ -90,6 +95,31 @@ struct CRRTPlannerParameters
   double projectionTolerance;
 };
 
+struct ParallelPlannerParameters
+{
+  ParallelPlannerParameters(
+      std::size_t numWorkers = 0, bool returnFirstSolution = true)
+    : numWorkers(numWorkers), returnFirstSolution(returnFirstSolution){
+          // Do nothing
+      };
+
+  /// Number of planning threads, including the calling thread. Each thread
+  /// plans on its own clone of the World. Zero uses one thread per hardware
+  /// thread.
+  std::size_t numWorkers;
+
+  /// Whether to stop planning as soon as any goal is reached. Otherwise, every
+  /// goal is planned to and the shortest solution is returned.
+  bool returnFirstSolution;
+};
+
+/// Creates the collision constraint for a \c MetaSkeleton in a \c World. This
+/// is used to create an independent constraint for each clone of a World.
+using CollisionTestableFactory = std::function<constraint::TestablePtr(
+    const statespace::dart::MetaSkeletonStateSpacePtr& space,
+    const dart::dynamics::MetaSkeletonPtr& metaSkeleton,
+    const planner::WorldPtr& world)>;
+
 /// Plan the robot to a specific configuration.
 /// Restores the robot to its initial configuration after planning.
 /// \param[in] space The StateSpace for the metaskeleton
@@ -106,6 +136,39 @@ trajectory::InterpolatedPtr planToConfiguration(
     common::RNG* rng,
     double timelimit);
 
+/// Plan the robot of \c roadmapPlanner from its current configuration to a
+/// specific configuration, using a lazy planner that only checks the edges of
+/// candidate paths for collision. The roadmap of \c roadmapPlanner is reused
+/// across calls, so this is faster than planToConfiguration when collision
+/// checking dominates planning time and the planner is kept between queries.
+/// Restores the robot to its initial configuration after planning.
+/// \param[in] roadmapPlanner Roadmap planner for the robot.
+/// \param[in] goalState Goal state
+/// \param[in] timelimit Max time to spend planning
+/// \return Trajectory to the goal state, or nullptr if planning fails.
+trajectory::InterpolatedPtr planToConfigurationLazy(
+    planner::ompl::RoadmapPlanner& roadmapPlanner,
+    const statespace::StateSpace::State* goalState,
+    double timelimit);
+
+/// Plan the robot to a specific configuration in a context checked out of
+/// \c pool, so that several threads can plan for the same robot at once.
+/// The robot itself is not modified or locked during planning.
+/// \param[in] pool Pool of planning contexts for the robot
+/// \param[in] goalState Goal state
+/// \param[in] rng Random number generator
+/// \param[in] timelimit Max time to spend per planning to each IK
+/// \param[in] numEdgeCheckWorkers Number of additional contexts checked out
+/// of \c pool to collision check each edge in parallel. Zero checks edges on
+/// the calling thread only.
+/// \return Trajectory to the goal state, or nullptr if planning fails.
+trajectory::InterpolatedPtr planToConfiguration(
+    PlanningContextPool& pool,
+    const statespace::StateSpace::State* goalState,
+    common::RNG* rng,
+    double timelimit,
+    std::size_t numEdgeCheckWorkers = 0);
+
 /// Plan the robot to a set of configurations.
 /// Restores the robot to its initial configuration after planning.
 /// \param[in] space The StateSpace for the metaskeleton
@@ -122,6 +185,34 @@ trajectory::InterpolatedPtr planToConfigurations(
     common::RNG* rng,
     double timelimit);
 
+/// Plan the robot to a set of configurations using several threads.
+///
+/// Each thread plans on its own clone of \c world, using a collision
+/// constraint created by \c collisionTestableFactory for that clone. Snap
+/// plans to all goals are tried first. If none succeeds, RRTConnect is run
+/// concurrently for several goals. The robot is not modified.
+///
+/// \param[in] space The StateSpace for the metaskeleton
+/// \param[in] metaSkeleton MetaSkeleton to plan with. Its Skeleton must be in
+/// \c world.
+/// \param[in] goalStates Goal states
+/// \param[in] world World containing the robot and the obstacles
+/// \param[in] collisionTestableFactory Creates the collision constraint for a
+/// clone of \c metaSkeleton in a clone of \c world
+/// \param[in] rng Random number generator
+/// \param[in] timelimit Max time to spend per planning to each IK
+/// \param[in] parameters Parallel planning parameters
+/// \return Trajectory to one of the goals, or nullptr if planning fails.
+trajectory::InterpolatedPtr planToConfigurationsParallel(
+    const statespace::dart::MetaSkeletonStateSpacePtr& space,
+    const dart::dynamics::MetaSkeletonPtr& metaSkeleton,
+    const std::vector<statespace::StateSpace::State*>& goalStates,
+    const planner::WorldPtr& world,
+    const CollisionTestableFactory& collisionTestableFactory,
+    common::RNG* rng,
+    double timelimit,
+    const ParallelPlannerParameters& parameters = ParallelPlannerParameters());
+
 /// Plan the configuration of the metakeleton such that
 /// the specified bodynode is set to a sample in TSR
 /// \param[in] space The StateSpace for the metaskeleton.
@@ -143,6 +234,60 @@ trajectory::InterpolatedPtr planToTSR(
     double timelimit,
     std::size_t maxNumTrials);
 
+/// Plan the configuration of the metakeleton such that the specified bodynode
+/// is set to a sample in TSR, in a context checked out of \c pool.
+/// \param[in] pool Pool of planning contexts for the robot
+/// \param[in] bodyNode Bodynode of the robot whose frame for which TSR is
+/// constructed. The bodynode with the same name in the context is used.
+/// \param[in] tsr TSR to plan to.
+/// \param[in] rng Random number generator
+/// \param[in] timelimit Max time (seconds) to spend per planning to each IK
+/// \param[in] maxNumTrials Number of retries before failure.
+/// \return Trajectory to a sample in TSR, or nullptr if planning fails.
+trajectory::InterpolatedPtr planToTSR(
+    PlanningContextPool& pool,
+    const dart::dynamics::BodyNodePtr& bodyNode,
+    const constraint::dart::TSRPtr& tsr,
+    common::RNG* rng,
+    double timelimit,
+    std::size_t maxNumTrials);
+
+/// Plan the configuration of the metakeleton such that the specified bodynode
+/// is set to a sample in TSR, using several threads.
+///
+/// Each thread runs an IK sampler on its own clone of \c world, with its own
+/// random number stream and a collision constraint created by
+/// \c collisionTestableFactory for that clone. Sampled goals are shared
+/// between threads and the ones closest to the start are planned to first,
+/// with Snap Planner and then with RRTConnect. The robot is not modified.
+///
+/// \param[in] space The StateSpace for the metaskeleton.
+/// \param[in] metaSkeleton MetaSkeleton to plan with. Its Skeleton must be in
+/// \c world.
+/// \param[in] bodyNode Bodynode whose frame for which TSR is constructed.
+/// \param[in] tsr TSR to plan to.
+/// \param[in] world World containing the robot and the obstacles
+/// \param[in] collisionTestableFactory Creates the collision constraint for a
+/// clone of \c metaSkeleton in a clone of \c world
+/// \param[in] rng Random number generator
+/// \param[in] timelimit Max time (seconds) to spend planning
+/// \param[in] maxNumTrials Number of IK retries per sample.
+/// \param[in] parameters Parallel planning parameters. \c numWorkers sets the
+/// number of threads, and thus the number of clones of \c world; zero uses
+/// one per hardware thread. The first solution found is always returned.
+/// \return Trajectory to a sample in TSR, or nullptr if planning fails.
+trajectory::InterpolatedPtr planToTSRParallel(
+    const statespace::dart::MetaSkeletonStateSpacePtr& space,
+    const dart::dynamics::MetaSkeletonPtr& metaSkeleton,
+    const dart::dynamics::BodyNodePtr& bodyNode,
+    const constraint::dart::TSRPtr& tsr,
+    const planner::WorldPtr& world,
+    const CollisionTestableFactory& collisionTestableFactory,
+    common::RNG* rng,
+    double timelimit,
+    std::size_t maxNumTrials,
+    const ParallelPlannerParameters& parameters = ParallelPlannerParameters());
+
 /// Returns a Trajectory that moves the configuration of the metakeleton such
 /// that the specified bodynode is set to a sample in a goal TSR and
 /// the trajectory is constrained to a constraint TSR
@@ -166,6 +311,26 @@ trajectory::InterpolatedPtr planToTSRwithTrajectoryConstraint(
     double timelimit,
     const CRRTPlannerParameters& crrtParameters = CRRTPlannerParameters());
 
+/// Returns a Trajectory that moves the configuration of the metakeleton such
+/// that the specified bodynode is set to a sample in a goal TSR and
+/// the trajectory is constrained to a constraint TSR, planning in a context
+/// checked out of \c pool. Uses CRRTPlanner.
+/// \param[in] pool Pool of planning contexts for the robot
+/// \param[in] bodyNode Bodynode of the robot whose frame is meant for TSR.
+/// The bodynode with the same name in the context is used.
+/// \param[in] goalTsr The goal TSR to move to
+/// \param[in] constraintTsr The constraint TSR for the trajectory
+/// \param[in] timelimit Timelimit for planning
+/// \param[in] crrtParameters Parameters to use in planning.
+/// \return Trajectory to a sample in TSR, or nullptr if planning fails.
+trajectory::InterpolatedPtr planToTSRwithTrajectoryConstraint(
+    PlanningContextPool& pool,
+    const dart::dynamics::BodyNodePtr& bodyNode,
+    const constraint::dart::TSRPtr& goalTsr,
+    const constraint::dart::TSRPtr& constraintTsr,
+    double timelimit,
+    const CRRTPlannerParameters& crrtParameters = CRRTPlannerParameters());
+
 /// Plan to a desired end-effector offset with fixed orientation.
 /// \param[in] space StateSpace for the metaskeleton
 /// \param[in] metaSkeleton Metaskeleton to plan with
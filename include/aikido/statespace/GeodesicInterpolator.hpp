@@ -53,8 +53,51 @@ public:
       double _alpha,
       Eigen::VectorXd& _tangentVector) const override;
 
+  /// Prepares to interpolate repeatedly between \c _from and \c _to. The
+  /// tangent vector is computed once, so each interpolated state costs one
+  /// \c expMap and one \c compose, without allocating memory. If the state
+  /// space is made up of \c Rn and \c SO2 spaces only, e.g. a
+  /// \c CartesianProduct of those, states are linearly interpolated in place.
+  ///
+  /// \param _from start state in \c getStateSpace()
+  /// \param _to end state in \c getStateSpace()
+  /// \return edge between \c _from and \c _to
+  std::unique_ptr<Edge> prepareEdge(
+      const statespace::StateSpace::State* _from,
+      const statespace::StateSpace::State* _to) const override;
+
 private:
+  class GeodesicEdge;
+  class LinearEdge;
+
+  /// Location of a tangent space coordinate in a state of a space whose
+  /// geodesics are straight lines in its coordinates.
+  struct LinearCoordinate
+  {
+    /// Offset in bytes of the coordinate in a state.
+    std::size_t mOffset;
+
+    /// Whether the coordinate is the angle of a \c SO2 state, rather than a
+    /// value of an \c Rn state.
+    bool mIsAngle;
+  };
+
+  /// Appends the coordinates of \c _space, whose states start \c _offset
+  /// bytes into a state, to \c _coordinates.
+  ///
+  /// \return whether the geodesics of \c _space are straight lines
+  static bool getLinearCoordinates(
+      const StateSpace& _space,
+      std::size_t _offset,
+      std::vector<LinearCoordinate>& _coordinates);
+
   statespace::StateSpacePtr mStateSpace;
+
+  /// Whether \c mLinearCoordinates describes all states of \c mStateSpace.
+  bool mIsLinear;
+
+  /// Location of each tangent space coordinate of \c mStateSpace in a state.
+  std::vector<LinearCoordinate> mLinearCoordinates;
 };
 
 } // namespace statespace
@@ -14,6 +14,8 @@ AIKIDO_DECLARE_POINTERS(Interpolator)
 class Interpolator
 {
 public:
+  class Edge;
+
   virtual ~Interpolator() = default;
 
   /// Gets the \c StateSpace on which this \c Interpolator operates.
@@ -52,6 +54,40 @@ public:
       std::size_t _derivative,
       double _alpha,
       Eigen::VectorXd& _tangentVector) const = 0;
+
+  /// Prepares to interpolate repeatedly along the path that connects \c _from
+  /// to \c _to, e.g. to check many states along an edge. The returned
+  /// \c Edge computes the same states as \c interpolate, but may do the work
+  /// that only depends on \c _from and \c _to once, up front.
+  ///
+  /// The default implementation copies \c _from and \c _to and calls
+  /// \c interpolate. The edge must not outlive this interpolator.
+  ///
+  /// \param _from start state in \c getStateSpace()
+  /// \param _to end state in \c getStateSpace()
+  /// \return edge between \c _from and \c _to
+  virtual std::unique_ptr<Edge> prepareEdge(
+      const statespace::StateSpace::State* _from,
+      const statespace::StateSpace::State* _to) const;
+};
+
+/// Path between two fixed states, created by \c Interpolator::prepareEdge.
+/// An edge keeps copies of its states, so they may change or be freed after
+/// the edge is created. An edge must not be used concurrently from multiple
+/// threads.
+class Interpolator::Edge
+{
+public:
+  virtual ~Edge() = default;
+
+  /// Computes the state that lies at path parameter \c _alpha along this
+  /// edge. This is equivalent to \c Interpolator::interpolate with the states
+  /// this edge was created from.
+  ///
+  /// \param _alpha path parameter in the range [0, 1]
+  /// \param[out] _state output interpolated state
+  virtual void interpolate(
+      double _alpha, statespace::StateSpace::State* _state) = 0;
 };
 
 } // namespace statespace
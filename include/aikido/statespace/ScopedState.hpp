@@ -1,13 +1,17 @@
 #ifndef AIKIDO_STATESPACE_SCOPEDSTATE_HPP_
 #define AIKIDO_STATESPACE_SCOPEDSTATE_HPP_
 #include <memory>
+#include "StateBufferPool.hpp"
 #include "StateHandle.hpp"
 
 namespace aikido {
 namespace statespace {
 
 /// CRTP RAII wrapper for a \c StateHandle. The constructor of \c ScopedState
-/// allocates a state and the destructor destroys it.
+/// allocates a state and the destructor destroys it. The memory backing the
+/// state is drawn from, and returned to, the thread-local
+/// \c StateBufferPool, so creating temporary states in a loop does not hit
+/// the heap.
 ///
 /// \tparam _Handle \c StateHandle class being wrapped.
 template <class _Handle>
@@ -35,7 +39,7 @@ public:
   ScopedState& operator=(ScopedState&&) = default;
 
 private:
-  std::unique_ptr<char[]> mBuffer;
+  std::unique_ptr<char[], StateBufferDeleter> mBuffer;
 };
 
 } // namespace statespace
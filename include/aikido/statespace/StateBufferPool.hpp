@@ -0,0 +1,77 @@
+#ifndef AIKIDO_STATESPACE_STATEBUFFERPOOL_HPP_
+#define AIKIDO_STATESPACE_STATEBUFFERPOOL_HPP_
+
+#include <cstddef>
+
+namespace aikido {
+namespace statespace {
+
+/// Thread-local free list of raw memory blocks used to store \c State objects.
+///
+/// Temporary states (e.g. those created by \c StateSpace::createState) are
+/// short-lived and created at a high rate in planning loops. Rather than going
+/// to the heap every time, buffers are returned to a per-thread cache that is
+/// bucketed by size. Since buffers are only raw memory, any two state spaces
+/// whose states have the same size share a bucket.
+///
+/// A buffer may be released on a different thread than the one that acquired
+/// it; it is then cached by the releasing thread. Buffers larger than
+/// \c MAX_POOLED_SIZE bytes are never cached.
+class StateBufferPool
+{
+public:
+  /// Largest buffer size, in bytes, that is cached by the pool.
+  static constexpr std::size_t MAX_POOLED_SIZE{4096};
+
+  /// Maximum number of free buffers cached per size bucket and thread.
+  static constexpr std::size_t MAX_BUFFERS_PER_BUCKET{64};
+
+  /// Returns a buffer of at least \c size bytes. The buffer must be returned
+  /// with \c release using the same \c size.
+  ///
+  /// \param size size of the requested buffer, in bytes
+  /// \return buffer with at least \c size bytes of memory
+  static char* acquire(std::size_t size);
+
+  /// Returns a buffer previously obtained from \c acquire to the pool of the
+  /// calling thread. It is undefined behavior to access \c buffer after
+  /// calling this function.
+  ///
+  /// \param buffer buffer obtained from \c acquire
+  /// \param size size that was passed to \c acquire
+  static void release(char* buffer, std::size_t size);
+
+  /// Frees all buffers cached by the calling thread.
+  static void clear();
+
+  /// Returns the number of free buffers cached by the calling thread.
+  ///
+  /// \return number of cached buffers
+  static std::size_t getNumCachedBuffers();
+};
+
+/// Deleter that returns a buffer obtained from \c StateBufferPool::acquire to
+/// the pool. This is intended to be used with \c std::unique_ptr<char[]>.
+struct StateBufferDeleter
+{
+  /// Constructs a deleter for buffers of \c size bytes.
+  ///
+  /// \param size size that was passed to \c StateBufferPool::acquire
+  explicit StateBufferDeleter(std::size_t size = 0u) : mSize(size)
+  {
+    // Do nothing
+  }
+
+  /// Returns \c buffer to the pool.
+  void operator()(char* buffer) const
+  {
+    StateBufferPool::release(buffer, mSize);
+  }
+
+  std::size_t mSize;
+};
+
+} // namespace statespace
+} // namespace aikido
+
+#endif // ifndef AIKIDO_STATESPACE_STATEBUFFERPOOL_HPP_
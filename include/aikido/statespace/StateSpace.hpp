@@ -58,8 +58,8 @@ public:
   ScopedState createState() const;
 
   /// Allocate a new state. This must be deleted with \c freeState. This is a
-  /// helper function that allocates memory, uses \c allocateStateInBuffer to
-  /// create a \c State, and returns that pointer.
+  /// helper function that acquires memory from the \c StateBufferPool, uses
+  /// \c allocateStateInBuffer to create a \c State, and returns that pointer.
   ///
   /// \return state in this space
   virtual State* allocateState() const;
@@ -198,7 +198,40 @@ public:
       const ::dart::dynamics::SkeletonPtr& _skeleton) const;
 
 private:
+  /// How the positions of a joint are stored in its substate.
+  enum class JointStorage
+  {
+    /// Positions are stored as a vector of doubles, as in \c Rn.
+    Vector,
+
+    /// The position is stored as an angle, as in \c SO2.
+    Angle,
+
+    /// Positions are converted by the \c JointStateSpace of the joint.
+    Generic
+  };
+
   Properties mProperties;
+
+  /// State space of each joint.
+  std::vector<const JointStateSpace*> mJointSpaces;
+
+  /// How the positions of each joint are stored in its substate.
+  std::vector<JointStorage> mJointStorage;
+
+  /// Offset in bytes of the substate of each joint in a \c State.
+  std::vector<std::size_t> mSubStateOffsets;
+
+  /// Index in \c mDofIndices of the first DOF of each joint, followed by the
+  /// total number of DOFs.
+  std::vector<std::size_t> mJointDofOffsets;
+
+  /// MetaSkeleton DOF index of each DOF, ordered by joint.
+  std::vector<std::size_t> mDofIndices;
+
+  /// Whether a \c State stores the positions of all DOFs as a contiguous
+  /// array of doubles, in MetaSkeleton DOF order.
+  bool mIsContiguous;
 };
 
 } // namespace dart
@@ -5,7 +5,9 @@ template <class _Handle>
 ScopedState<_Handle>::ScopedState(const StateSpace* _space)
 {
   this->mSpace = _space;
-  mBuffer.reset(new char[_space->getStateSizeInBytes()]);
+  const auto size = _space->getStateSizeInBytes();
+  mBuffer = std::unique_ptr<char[], StateBufferDeleter>(
+      StateBufferPool::acquire(size), StateBufferDeleter(size));
   this->mState = static_cast<ScopedState::State*>(
       _space->allocateStateInBuffer(mBuffer.get()));
 }
@@ -13,7 +15,9 @@ ScopedState<_Handle>::ScopedState(const StateSpace* _space)
 template <class _Handle>
 ScopedState<_Handle>::~ScopedState()
 {
-  this->mSpace->freeStateInBuffer(this->mState);
+  // A moved-from ScopedState no longer owns its state.
+  if (mBuffer)
+    this->mSpace->freeStateInBuffer(this->mState);
 }
 
 } // namespace statespace
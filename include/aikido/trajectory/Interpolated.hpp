@@ -1,6 +1,7 @@
 #ifndef AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 #define AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 
+#include <memory>
 #include "aikido/common/pointers.hpp"
 #include "../statespace/GeodesicInterpolator.hpp"
 #include "Trajectory.hpp"
@@ -11,6 +12,10 @@ namespace trajectory {
 AIKIDO_DECLARE_POINTERS(Interpolated)
 
 /// Trajectory that uses an \c Interpolator to interpolate between waypoints.
+///
+/// Waypoints are stored contiguously, sorted by time: the times in one array
+/// and the states in one buffer, at a fixed stride. Adding a waypoint at or
+/// after the end of the trajectory takes amortized constant time.
 class Interpolated : public Trajectory
 {
 public:
@@ -22,13 +27,24 @@ public:
       statespace::ConstStateSpacePtr _stateSpace,
       statespace::ConstInterpolatorPtr _interpolator);
 
-  /// Add a waypoint to the trajectory at the given time.
+  virtual ~Interpolated();
+
+  /// Add a waypoint to the trajectory at the given time. This invalidates the
+  /// states previously returned by \c getWaypoint.
   ///
   /// \param _t time of the waypoint
   /// \param _state state at the waypoint
   void addWaypoint(double _t, const statespace::StateSpace::State* _state);
 
-  /// Gets a waypoint.
+  /// Reserves storage for \c _numWaypoints waypoints, so that adding up to
+  /// that many waypoints does not reallocate. This invalidates the states
+  /// previously returned by \c getWaypoint if it reallocates.
+  ///
+  /// \param _numWaypoints number of waypoints to reserve storage for
+  void reserve(std::size_t _numWaypoints);
+
+  /// Gets a waypoint. The state remains valid until the next waypoint is
+  /// added to the trajectory.
   ///
   /// \param _index waypoint index
   /// \return state of the waypoint at index \c _index
@@ -70,30 +86,45 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
-private:
-  /// Waypoint in the trajectory.
-  struct Waypoint
-  {
-    Waypoint(double _t, statespace::StateSpace::State* _state);
-
-    /// Comparator to allow sorting waypoints based on time
-    bool operator<(const Waypoint& rhs) const;
+  // Documentation inherited
+  void evaluateBatch(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd& _output,
+      const std::vector<int>& _derivatives
+      = std::vector<int>{0}) const override;
 
-    /// Comparator to allow sorting waypoints based on time
-    bool operator<(double rhs) const;
+private:
+  /// Returns the state of waypoint \c _index.
+  statespace::StateSpace::State* getWaypointState(std::size_t _index) const;
 
-    double t;
-    statespace::StateSpace::State* state;
-  };
+  /// Moves the waypoint states to a buffer with room for \c _capacity states.
+  void reallocate(std::size_t _capacity);
 
   /// Get the index of the first waypoint whose time value is larger than _t.
   /// Throws std::domain_error if _t is larger than last waypoint in the
   /// trajectory.
   int getWaypointIndexAfterTime(double _t) const;
 
+  /// Get the index of the first waypoint whose time value is not smaller than
+  /// _t, or the number of waypoints if _t is larger than the time of the last
+  /// waypoint. Waypoints _hint and _hint + 1 are checked before searching all
+  /// waypoints.
+  std::size_t getWaypointIndexAfterTime(double _t, std::size_t _hint) const;
+
   statespace::ConstStateSpacePtr mStateSpace;
   statespace::ConstInterpolatorPtr mInterpolator;
-  std::vector<Waypoint> mWaypoints;
+
+  /// Times of the waypoints, in increasing order.
+  std::vector<double> mWaypointTimes;
+
+  /// States of the waypoints, in the same order as \c mWaypointTimes.
+  std::unique_ptr<char[]> mStateBuffer;
+
+  /// Number of bytes between consecutive states in \c mStateBuffer.
+  std::size_t mStateStride;
+
+  /// Number of states that fit in \c mStateBuffer.
+  std::size_t mStateCapacity;
 };
 
 } // namespace trajectory
@@ -25,6 +25,8 @@ AIKIDO_DECLARE_POINTERS(Spline)
 class Spline : public Trajectory
 {
 public:
+  class Cursor;
+
   /// Constructs an empty trajectory.
   ///
   /// \param _stateSpace state space this trajectory is defined in
@@ -106,6 +108,13 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
+  // Documentation inherited.
+  void evaluateBatch(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd& _output,
+      const std::vector<int>& _derivatives
+      = std::vector<int>{0}) const override;
+
   /// Gets the number of waypoints.
   /// \return The number of waypoints
   std::size_t getNumWaypoints() const;
@@ -140,14 +149,101 @@ private:
     double mDuration;
   };
 
-  static Eigen::VectorXd evaluatePolynomial(
-      const Eigen::MatrixXd& _coefficients, double _t, int _derivative);
+  /// Evaluates a derivative of the polynomial with \c _coefficients at time
+  /// \c _t using Horner's scheme. This does not allocate memory if
+  /// \c _output already has the right size.
+  ///
+  /// \param _coefficients polynomial coefficients, as in \c addSegment
+  /// \param _t time parameter
+  /// \param _derivative order of derivative, zero for the value
+  /// \param[out] _output value of the derivative for each dimension
+  static void evaluatePolynomial(
+      const Eigen::MatrixXd& _coefficients,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _output);
+
+  /// Returns the index of the segment that contains time \c _t.
+  std::size_t getSegmentIndexForTime(double _t) const;
 
-  std::pair<std::size_t, double> getSegmentForTime(double _t) const;
+  /// Returns the index of the segment that contains time \c _t, checking
+  /// segment \c _hint and the segment after it before searching all segments.
+  std::size_t getSegmentIndexForTime(double _t, std::size_t _hint) const;
+
+  /// Returns whether time \c _t falls in segment \c _index.
+  bool isTimeInSegment(double _t, std::size_t _index) const;
+
+  /// Evaluates segment \c _index at time \c _t, using the scratch buffers
+  /// \c _tangentVector and \c _relativeState.
+  void evaluateSegment(
+      std::size_t _index,
+      double _t,
+      statespace::StateSpace::State* _state,
+      Eigen::VectorXd& _tangentVector,
+      statespace::StateSpace::State* _relativeState) const;
+
+  void evaluateSegmentDerivative(
+      std::size_t _index,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const;
 
   statespace::ConstStateSpacePtr mStateSpace;
   double mStartTime;
   std::vector<PolynomialSegment> mSegments;
+
+  /// Start time of each segment, followed by the end time of the trajectory.
+  std::vector<double> mSegmentStartTimes;
+};
+
+/// Evaluates a \c Spline at a sequence of times. The cursor remembers the
+/// segment of the previous query, so sweeping through the spline with
+/// monotonic times, e.g. during playback, finds each segment in constant time.
+/// Other queries fall back to a binary search over the segments.
+///
+/// The cursor keeps the spline alive, along with scratch buffers that are
+/// reused by every evaluation. A cursor must not be used concurrently from
+/// multiple threads.
+class Spline::Cursor
+{
+public:
+  /// Constructs a cursor at the start of \c _spline.
+  ///
+  /// \param _spline spline to evaluate
+  explicit Cursor(ConstSplinePtr _spline);
+
+  /// Gets the spline evaluated by this cursor.
+  ///
+  /// \return spline evaluated by this cursor
+  ConstSplinePtr getSpline() const;
+
+  /// Evaluates the spline at time \c _t. Equivalent to \c Spline::evaluate.
+  ///
+  /// \param _t time parameter
+  /// \param[out] _state output state of the spline at time \c _t
+  void evaluate(double _t, statespace::StateSpace::State* _state);
+
+  /// Evaluates a derivative of the spline at time \c _t. Equivalent to
+  /// \c Spline::evaluateDerivative.
+  ///
+  /// \param _t time parameter
+  /// \param _derivative order of derivative
+  /// \param[out] _tangentVector output tangent vector in the local frame
+  void evaluateDerivative(
+      double _t, int _derivative, Eigen::VectorXd& _tangentVector);
+
+  /// Gets the index of the segment of the most recent query.
+  ///
+  /// \return segment index
+  std::size_t getSegmentIndex() const;
+
+private:
+  ConstSplinePtr mSpline;
+  std::size_t mSegmentIndex;
+
+  /// Scratch buffers reused by every evaluation.
+  Eigen::VectorXd mTangentVector;
+  std::unique_ptr<statespace::StateSpace::ScopedState> mRelativeState;
 };
 
 } // namespace trajectory
@@ -1,6 +1,7 @@
 #ifndef AIKIDO_TRAJECTORY_TRAJECTORY_HPP_
 #define AIKIDO_TRAJECTORY_TRAJECTORY_HPP_
 
+#include <vector>
 #include <Eigen/Core>
 #include "aikido/common/pointers.hpp"
 #include <aikido/trajectory/TrajectoryMetadata.hpp>
@@ -71,6 +72,24 @@ public:
   virtual void evaluateDerivative(
       double _t, int _derivative, Eigen::VectorXd& _tangentVector) const = 0;
 
+  /// Evaluates the trajectory at each time in \c _times. Column \c i of
+  /// \c _output holds the evaluation at \c _times[i], with one block of
+  /// \c getStateSpace()->getDimension() rows per element of \c _derivatives,
+  /// in the same order. Derivative order zero stores the \c logMap of the
+  /// state, i.e. the joint positions in a \c MetaSkeletonStateSpace. Higher
+  /// orders store the tangent vector of \c evaluateDerivative.
+  ///
+  /// The default implementation calls \c evaluate and \c evaluateDerivative
+  /// for each time. Implementations may be faster if \c _times are sorted.
+  ///
+  /// \param _times time parameters
+  /// \param[out] _output evaluations, one column per time
+  /// \param _derivatives orders of derivative to evaluate
+  virtual void evaluateBatch(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd& _output,
+      const std::vector<int>& _derivatives = std::vector<int>{0}) const;
+
   /// Trajectory metadata
   TrajectoryMetadata metadata;
 };
@@ -0,0 +1,148 @@
+#include <aikido/common/BoundedLeastSquares.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace aikido {
+namespace common {
+
+//==============================================================================
+BoundedLeastSquaresSolver::BoundedLeastSquaresSolver(
+    int maxIterations, double tolerance)
+  : mMaxIterations(maxIterations), mTolerance(tolerance), mNumIterations(0)
+{
+  if (mMaxIterations <= 0)
+    throw std::invalid_argument("Maximum iterations must be positive.");
+
+  if (mTolerance < 0.0)
+    throw std::invalid_argument("Tolerance must be non-negative.");
+}
+
+//==============================================================================
+bool BoundedLeastSquaresSolver::solve(
+    const Eigen::MatrixXd& A,
+    const Eigen::VectorXd& b,
+    const Eigen::VectorXd& lower,
+    const Eigen::VectorXd& upper,
+    Eigen::VectorXd& x)
+{
+  const auto numVariables = A.cols();
+  if (b.size() != A.rows())
+    throw std::invalid_argument("Target size does not match matrix rows.");
+
+  if (lower.size() != numVariables || upper.size() != numVariables
+      || x.size() != numVariables)
+  {
+    throw std::invalid_argument(
+        "Bounds or initial guess size does not match matrix columns.");
+  }
+
+  if ((lower.array() > upper.array()).any())
+    throw std::invalid_argument("Lower bound exceeds upper bound.");
+
+  x = x.cwiseMax(lower).cwiseMin(upper);
+
+  // Gradients below this are treated as zero.
+  const double gradientScale = (A.transpose() * b).lpNorm<Eigen::Infinity>();
+  const double gradientTolerance = mTolerance * std::max(1.0, gradientScale);
+
+  // Start with every variable that is at a bound held there.
+  mIsHeld.assign(numVariables, false);
+  for (int i = 0; i < numVariables; ++i)
+    mIsHeld[i] = x[i] == lower[i] || x[i] == upper[i];
+
+  for (mNumIterations = 1; mNumIterations <= mMaxIterations; ++mNumIterations)
+  {
+    mFreeIndices.clear();
+    for (int i = 0; i < numVariables; ++i)
+    {
+      if (!mIsHeld[i])
+        mFreeIndices.push_back(i);
+    }
+
+    if (!mFreeIndices.empty())
+    {
+      const auto numFree = static_cast<int>(mFreeIndices.size());
+      mFreeColumns.resize(A.rows(), numFree);
+      for (int k = 0; k < numFree; ++k)
+        mFreeColumns.col(k) = A.col(mFreeIndices[k]);
+
+      // Smallest step of the free variables that minimizes the objective.
+      mResidual.noalias() = b - A * x;
+      mSvd.compute(mFreeColumns, Eigen::ComputeThinU | Eigen::ComputeThinV);
+      mStep = mSvd.solve(mResidual);
+
+      // Move as far along the step as the bounds allow.
+      double stepFraction = 1.0;
+      int blockingIndex = -1;
+      double blockingBound = 0.0;
+      for (int k = 0; k < numFree; ++k)
+      {
+        const int i = mFreeIndices[k];
+        const double target = x[i] + mStep[k];
+        const double bound = target > upper[i] ? upper[i] : lower[i];
+        if (target <= upper[i] && target >= lower[i])
+          continue;
+
+        const double fraction = (bound - x[i]) / mStep[k];
+        if (fraction < stepFraction)
+        {
+          stepFraction = fraction;
+          blockingIndex = i;
+          blockingBound = bound;
+        }
+      }
+
+      for (int k = 0; k < numFree; ++k)
+      {
+        const int i = mFreeIndices[k];
+        x[i] = std::min(
+            std::max(x[i] + stepFraction * mStep[k], lower[i]), upper[i]);
+      }
+
+      if (blockingIndex >= 0)
+      {
+        x[blockingIndex] = blockingBound;
+        mIsHeld[blockingIndex] = true;
+        continue;
+      }
+    }
+
+    // The free variables are optimal. Release the held variable whose
+    // gradient pulls it into the box the most, if any.
+    mGradient.noalias() = A.transpose() * (A * x - b);
+
+    int releasedIndex = -1;
+    double largestPull = gradientTolerance;
+    for (int i = 0; i < numVariables; ++i)
+    {
+      if (!mIsHeld[i] || lower[i] == upper[i])
+        continue;
+
+      const double pull = x[i] == lower[i] ? -mGradient[i] : mGradient[i];
+      if (pull > largestPull)
+      {
+        largestPull = pull;
+        releasedIndex = i;
+      }
+    }
+
+    if (releasedIndex < 0)
+      return true;
+
+    mIsHeld[releasedIndex] = false;
+  }
+
+  mNumIterations = mMaxIterations;
+  return false;
+}
+
+//==============================================================================
+int BoundedLeastSquaresSolver::getNumIterations() const
+{
+  return mNumIterations;
+}
+
+} // namespace common
+} // namespace aikido
@@ -0,0 +1,205 @@
+#include "aikido/constraint/CachedTestable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <Eigen/Core>
+
+namespace aikido {
+namespace constraint {
+
+namespace {
+
+//==============================================================================
+/// Scrambles the bits of \c value, so that hashes that differ in a few bits
+/// select different stripes.
+std::uint64_t mix(std::uint64_t value)
+{
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdull;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ull;
+  value ^= value >> 33;
+  return value;
+}
+
+} // namespace
+
+//==============================================================================
+std::size_t CachedTestable::KeyHash::operator()(const Key& key) const
+{
+  std::uint64_t hash = key.size();
+  for (const auto coordinate : key)
+    hash = mix(hash ^ static_cast<std::uint64_t>(coordinate));
+  return static_cast<std::size_t>(hash);
+}
+
+//==============================================================================
+CachedTestable::CachedTestable(
+    TestablePtr testable,
+    double resolution,
+    std::size_t capacity,
+    std::size_t numStripes)
+  : mTestable(std::move(testable))
+  , mResolution(resolution)
+  , mCapacity(capacity)
+  , mNumHits(0)
+  , mNumMisses(0)
+{
+  if (!mTestable)
+    throw std::invalid_argument("Testable is nullptr.");
+
+  if (!(mResolution > 0.))
+    throw std::invalid_argument("Resolution must be positive.");
+
+  if (mCapacity == 0)
+    throw std::invalid_argument("Capacity must be positive.");
+
+  if (numStripes == 0)
+    throw std::invalid_argument("Number of stripes must be positive.");
+
+  mStateSpace = mTestable->getStateSpace();
+
+  numStripes = std::min(numStripes, mCapacity);
+  mStripeCapacity = (mCapacity + numStripes - 1) / numStripes;
+
+  mStripes.reserve(numStripes);
+  for (std::size_t i = 0; i < numStripes; ++i)
+    mStripes.emplace_back(new Stripe);
+}
+
+//==============================================================================
+bool CachedTestable::isSatisfied(
+    const statespace::StateSpace::State* state,
+    TestableOutcome* outcome) const
+{
+  // The wrapped Testable may be a CachedTestable too, so the key must not be
+  // shared with other calls.
+  Key key;
+  computeKey(state, key);
+
+  if (!outcome)
+  {
+    auto& stripe = getStripe(key);
+    std::lock_guard<std::mutex> lock(stripe.mMutex);
+
+    const auto it = stripe.mResults.find(key);
+    if (it != stripe.mResults.end())
+    {
+      ++mNumHits;
+      return it->second;
+    }
+  }
+
+  // The stripe is not locked while testing, so that other threads can use it
+  // meanwhile. Two threads may then test the same cell, which is harmless.
+  ++mNumMisses;
+  const bool satisfied = mTestable->isSatisfied(state, outcome);
+  insert(key, satisfied);
+  return satisfied;
+}
+
+//==============================================================================
+statespace::StateSpacePtr CachedTestable::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+std::unique_ptr<TestableOutcome> CachedTestable::createOutcome() const
+{
+  return mTestable->createOutcome();
+}
+
+//==============================================================================
+TestablePtr CachedTestable::getTestable() const
+{
+  return mTestable;
+}
+
+//==============================================================================
+double CachedTestable::getResolution() const
+{
+  return mResolution;
+}
+
+//==============================================================================
+std::size_t CachedTestable::getCapacity() const
+{
+  return mCapacity;
+}
+
+//==============================================================================
+CachedTestable::CacheStatistics CachedTestable::getStatistics() const
+{
+  CacheStatistics statistics;
+  statistics.numHits = mNumHits;
+  statistics.numMisses = mNumMisses;
+
+  for (const auto& stripe : mStripes)
+  {
+    std::lock_guard<std::mutex> lock(stripe->mMutex);
+    statistics.numEntries += stripe->mResults.size();
+  }
+
+  return statistics;
+}
+
+//==============================================================================
+void CachedTestable::clear()
+{
+  for (const auto& stripe : mStripes)
+  {
+    std::lock_guard<std::mutex> lock(stripe->mMutex);
+    stripe->mResults.clear();
+    stripe->mKeys.clear();
+  }
+
+  mNumHits = 0;
+  mNumMisses = 0;
+}
+
+//==============================================================================
+void CachedTestable::computeKey(
+    const statespace::StateSpace::State* state, Key& key) const
+{
+  static thread_local Eigen::VectorXd tangent;
+  mStateSpace->logMap(state, tangent);
+
+  key.resize(static_cast<std::size_t>(tangent.size()));
+  for (std::size_t i = 0; i < key.size(); ++i)
+    key[i] = static_cast<std::int64_t>(std::round(tangent[i] / mResolution));
+}
+
+//==============================================================================
+CachedTestable::Stripe& CachedTestable::getStripe(const Key& key) const
+{
+  // Rehash so that the stripe does not depend on the same bits as the bucket
+  // of the key in the stripe.
+  const auto hash = mix(KeyHash()(key) + 0x9e3779b97f4a7c15ull);
+  return *mStripes[hash % mStripes.size()];
+}
+
+//==============================================================================
+void CachedTestable::insert(const Key& key, bool satisfied) const
+{
+  auto& stripe = getStripe(key);
+  std::lock_guard<std::mutex> lock(stripe.mMutex);
+
+  const auto result = stripe.mResults.emplace(key, satisfied);
+  if (!result.second)
+  {
+    result.first->second = satisfied;
+    return;
+  }
+
+  stripe.mKeys.emplace_back(key);
+  if (stripe.mKeys.size() > mStripeCapacity)
+  {
+    stripe.mResults.erase(stripe.mKeys.front());
+    stripe.mKeys.pop_front();
+  }
+}
+
+} // namespace constraint
+} // namespace aikido
@@ -9,6 +9,27 @@
 namespace aikido {
 namespace constraint {
 
+namespace {
+
+/// Maximum number of times the line search halves a damped least-squares
+/// step before giving up.
+constexpr int MAX_LINE_SEARCH_ITERATIONS{10};
+
+/// Buffers reused by successive projections on the same thread.
+struct ProjectionWorkspace
+{
+  Eigen::VectorXd mValue;
+  Eigen::MatrixXd mJacobian;
+  Eigen::VectorXd mViolation;
+  Eigen::VectorXd mTrialValue;
+  Eigen::MatrixXd mTrialJacobian;
+  Eigen::VectorXd mTrialViolation;
+  Eigen::MatrixXd mDampedNormal;
+  Eigen::VectorXd mTangentStep;
+};
+
+} // namespace
+
 //==============================================================================
 NewtonsMethodProjectable::NewtonsMethodProjectable(
     DifferentiablePtr _differentiable,
@@ -19,6 +40,8 @@ NewtonsMethodProjectable::NewtonsMethodProjectable(
   , mTolerance(std::move(_tolerance))
   , mMaxIteration(_maxIteration)
   , mMinStepSize(_minStepSize)
+  , mStepMethod(StepMethod::PSEUDOINVERSE)
+  , mDamping(1e-3)
 {
   if (!mDifferentiable)
     throw std::invalid_argument("_differentiable is nullptr.");
@@ -45,27 +68,23 @@ NewtonsMethodProjectable::NewtonsMethodProjectable(
     throw std::invalid_argument("_minStepsize should be positive.");
 
   mStateSpace = mDifferentiable->getStateSpace();
+  mConstraintTypes = mDifferentiable->getConstraintTypes();
 }
 
 //==============================================================================
-bool NewtonsMethodProjectable::contains(
-    const statespace::StateSpace::State* _s) const
+bool NewtonsMethodProjectable::contains(const Eigen::VectorXd& _values) const
 {
-  Eigen::VectorXd values;
-  mDifferentiable->getValue(_s, values);
-  std::vector<ConstraintType> types = mDifferentiable->getConstraintTypes();
-
-  for (int i = 0; i < values.size(); i++)
+  for (int i = 0; i < _values.size(); i++)
   {
-    if (types.at(i) == ConstraintType::EQUALITY)
+    if (mConstraintTypes.at(i) == ConstraintType::EQUALITY)
     {
-      if (std::abs(values(i)) > mTolerance.at(i))
+      if (std::abs(_values(i)) > mTolerance.at(i))
         return false;
     }
     else
     {
       // Inequality constraints are satisfied when value <= 0.
-      if (values(i) > mTolerance.at(i))
+      if (_values(i) > mTolerance.at(i))
         return false;
     }
   }
@@ -73,47 +92,131 @@ bool NewtonsMethodProjectable::contains(
   return true;
 }
 
+//==============================================================================
+void NewtonsMethodProjectable::computeViolation(
+    const Eigen::VectorXd& _values, Eigen::VectorXd& _violation) const
+{
+  _violation.resize(_values.size());
+  for (int i = 0; i < _values.size(); i++)
+  {
+    if (mConstraintTypes.at(i) == ConstraintType::EQUALITY)
+      _violation(i) = _values(i);
+    else
+      _violation(i) = std::max(_values(i), 0.);
+  }
+}
+
 //==============================================================================
 bool NewtonsMethodProjectable::project(
     const statespace::StateSpace::State* _s,
     statespace::StateSpace::State* _out) const
+{
+  return project(_s, _out, nullptr);
+}
+
+//==============================================================================
+bool NewtonsMethodProjectable::project(
+    const statespace::StateSpace::State* _s,
+    statespace::StateSpace::State* _out,
+    ProjectionStatistics* _statistics) const
 {
   using StateSpace = statespace::StateSpace;
 
+  static thread_local ProjectionWorkspace workspace;
+  auto& value = workspace.mValue;
+  auto& jac = workspace.mJacobian;
+  auto& violation = workspace.mViolation;
+  auto& tangentStep = workspace.mTangentStep;
+
   int iteration = 0;
+  int numEvaluations = 1;
 
   // Initialize _out.
   mStateSpace->copyState(_s, _out);
+  mDifferentiable->getValueAndJacobian(_out, value, jac);
+  bool isSatisfied = contains(value);
 
   StateSpace::ScopedState step(mStateSpace.get());
+  StateSpace::ScopedState trial(mStateSpace.get());
 
   /// Newton's method on mDifferentiable
-  while (!contains(_out) && iteration < mMaxIteration)
+  while (!isSatisfied && iteration < mMaxIteration)
   {
     iteration++;
 
-    Eigen::VectorXd value;
-    mDifferentiable->getValue(_out, value);
-    Eigen::MatrixXd jac;
-    mDifferentiable->getJacobian(_out, jac);
-
     // Minimization step in tangent space.
-    Eigen::VectorXd tangentStep = -1 * common::pseudoinverse(jac) * value;
+    if (mStepMethod == StepMethod::PSEUDOINVERSE)
+    {
+      tangentStep = -1 * common::pseudoinverse(jac) * value;
+    }
+    else
+    {
+      // Solve (J J^T + damping I) y = violation, for the minimum-norm step
+      // -J^T y of the damped least-squares problem.
+      computeViolation(value, violation);
+      auto& dampedNormal = workspace.mDampedNormal;
+      dampedNormal.noalias() = jac * jac.transpose();
+      dampedNormal.diagonal().array() += mDamping;
+      tangentStep.noalias()
+          = -jac.transpose() * dampedNormal.ldlt().solve(violation);
+    }
 
     // Break if tangent step is too small.
     if (tangentStep.maxCoeff() < mMinStepSize
         && (-1 * tangentStep).maxCoeff() < mMinStepSize)
       break;
 
-    // Minimization step in state space.
-    mStateSpace->expMap(tangentStep, step);
-    mStateSpace->compose(_out, step);
+    if (mStepMethod == StepMethod::PSEUDOINVERSE)
+    {
+      // Minimization step in state space.
+      mStateSpace->expMap(tangentStep, step);
+      mStateSpace->compose(_out, step);
+
+      mDifferentiable->getValueAndJacobian(_out, value, jac);
+      ++numEvaluations;
+      isSatisfied = contains(value);
+      continue;
+    }
+
+    // Backtrack until the step reduces the constraint violation.
+    auto& trialValue = workspace.mTrialValue;
+    auto& trialJac = workspace.mTrialJacobian;
+    auto& trialViolation = workspace.mTrialViolation;
+
+    const double currentViolation = violation.squaredNorm();
+    bool isDescent = false;
+    for (int i = 0; i < MAX_LINE_SEARCH_ITERATIONS && !isDescent; ++i)
+    {
+      mStateSpace->expMap(tangentStep, step);
+      mStateSpace->compose(_out, step, trial);
+
+      mDifferentiable->getValueAndJacobian(trial, trialValue, trialJac);
+      ++numEvaluations;
+      computeViolation(trialValue, trialViolation);
+
+      isDescent = trialViolation.squaredNorm() < currentViolation;
+      tangentStep *= 0.5;
+    }
+
+    if (!isDescent)
+      break;
+
+    mStateSpace->copyState(trial, _out);
+    value.swap(trialValue);
+    jac.swap(trialJac);
+    isSatisfied = contains(value);
   }
 
-  if (!contains(_out))
-    return false;
+  if (_statistics)
+  {
+    computeViolation(value, violation);
+    _statistics->numIterations = iteration;
+    _statistics->numEvaluations = numEvaluations;
+    _statistics->violation = violation.norm();
+    _statistics->converged = isSatisfied;
+  }
 
-  return true;
+  return isSatisfied;
 }
 
 //==============================================================================
@@ -122,5 +225,33 @@ statespace::StateSpacePtr NewtonsMethodProjectable::getStateSpace() const
   return mDifferentiable->getStateSpace();
 }
 
+//==============================================================================
+void NewtonsMethodProjectable::setStepMethod(StepMethod _stepMethod)
+{
+  mStepMethod = _stepMethod;
+}
+
+//==============================================================================
+NewtonsMethodProjectable::StepMethod NewtonsMethodProjectable::getStepMethod()
+    const
+{
+  return mStepMethod;
+}
+
+//==============================================================================
+void NewtonsMethodProjectable::setDamping(double _damping)
+{
+  if (_damping <= 0)
+    throw std::invalid_argument("_damping should be positive.");
+
+  mDamping = _damping;
+}
+
+//==============================================================================
+double NewtonsMethodProjectable::getDamping() const
+{
+  return mDamping;
+}
+
 } // namespace constraint
 } // namespace aikido
@@ -0,0 +1,30 @@
+#include "aikido/constraint/Testable.hpp"
+
+namespace aikido {
+namespace constraint {
+
+//==============================================================================
+bool Testable::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::vector<bool>& results,
+    bool stopOnFailure) const
+{
+  results.assign(states.size(), false);
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    results[i] = isSatisfied(states[i]);
+    if (!results[i])
+    {
+      allSatisfied = false;
+      if (stopOnFailure)
+        break;
+    }
+  }
+
+  return allSatisfied;
+}
+
+} // namespace constraint
+} // namespace aikido
@@ -1,21 +1,71 @@
 #include <aikido/constraint/TestableIntersection.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 
 namespace aikido {
 namespace constraint {
 
+namespace {
+
+/// Number of states tested between two reorderings in adaptive mode.
+constexpr std::size_t REORDER_INTERVAL{64};
+
+/// Lower bound on the mean duration of a constraint, in seconds.
+constexpr double MIN_MEAN_DURATION{1e-9};
+
+//==============================================================================
+double getElapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+//==============================================================================
+/// Returns the expected cost of a constraint per state it rejects. Testing
+/// constraints in increasing order of this rank minimizes the expected cost of
+/// testing a state, if the constraints fail independently.
+double getRank(const TestableIntersection::ConstraintStatistics& statistics)
+{
+  // Test constraints without statistics first, so that they get measured.
+  if (statistics.numEvaluations == 0)
+    return 0.;
+
+  const auto numEvaluations = static_cast<double>(statistics.numEvaluations);
+  // Constraints that are faster than the clock resolution still have a cost.
+  const auto meanDuration = std::max(
+      statistics.totalDuration / numEvaluations, MIN_MEAN_DURATION);
+
+  // Laplace's rule of succession keeps the rejection rate away from zero.
+  const auto rejectionRate
+      = (statistics.numRejections + 1.) / (numEvaluations + 2.);
+
+  return meanDuration / rejectionRate;
+}
+
+} // namespace
+
 //==============================================================================
 TestableIntersection::TestableIntersection(
     statespace::StateSpacePtr _stateSpace,
     std::vector<std::shared_ptr<Testable>> _constraints)
-  : mStateSpace(std::move(_stateSpace)), mConstraints(std::move(_constraints))
+  : mStateSpace(std::move(_stateSpace))
+  , mConstraints(std::move(_constraints))
+  , mAdaptiveOrdering(false)
+  , mOrder(mConstraints.size())
+  , mStatistics(mConstraints.size())
+  , mNumEvaluationsSinceReorder(0)
 {
   if (!mStateSpace)
     throw std::invalid_argument("_statespace is nullptr.");
 
   for (auto c : mConstraints)
     testConstraintStateSpaceOrThrow(c);
+
+  for (std::size_t i = 0; i < mOrder.size(); ++i)
+    mOrder[i] = i;
 }
 
 //==============================================================================
@@ -26,9 +76,34 @@ bool TestableIntersection::isSatisfied(
   auto defaultOutcomeObject
       = dynamic_cast_or_throw<DefaultTestableOutcome>(outcome);
 
-  for (auto c : mConstraints)
+  if (!mAdaptiveOrdering)
   {
-    if (!c->isSatisfied(_state))
+    for (auto c : mConstraints)
+    {
+      if (!c->isSatisfied(_state))
+      {
+        if (defaultOutcomeObject)
+          defaultOutcomeObject->setSatisfiedFlag(false);
+        return false;
+      }
+    }
+  }
+  else
+  {
+    bool satisfied = true;
+    for (const auto index : mOrder)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      satisfied = mConstraints[index]->isSatisfied(_state);
+      recordEvaluations(index, 1, satisfied ? 0 : 1, getElapsedSeconds(start));
+
+      if (!satisfied)
+        break;
+    }
+
+    updateOrder();
+
+    if (!satisfied)
     {
       if (defaultOutcomeObject)
         defaultOutcomeObject->setSatisfiedFlag(false);
@@ -41,6 +116,89 @@ bool TestableIntersection::isSatisfied(
   return true;
 }
 
+//==============================================================================
+bool TestableIntersection::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::vector<bool>& results,
+    bool stopOnFailure) const
+{
+  results.assign(states.size(), true);
+
+  // States that satisfied all constraints tested so far, and their indices in
+  // the original batch.
+  std::vector<const statespace::StateSpace::State*> remainingStates(states);
+  std::vector<std::size_t> remainingIndices(states.size());
+  for (std::size_t i = 0; i < remainingIndices.size(); ++i)
+    remainingIndices[i] = i;
+
+  std::vector<bool> constraintResults;
+  bool allSatisfied = true;
+
+  for (const auto index : mOrder)
+  {
+    if (remainingStates.empty())
+      break;
+
+    const auto& constraint = mConstraints[index];
+    const auto start = std::chrono::steady_clock::now();
+    const bool satisfied = constraint->isSatisfiedBatch(
+        remainingStates, constraintResults, stopOnFailure);
+    const auto duration = getElapsedSeconds(start);
+
+    // The constraint tested every remaining state, unless it stopped at the
+    // first state that does not satisfy it.
+    std::size_t numTested = remainingStates.size();
+    if (!satisfied)
+    {
+      allSatisfied = false;
+
+      if (stopOnFailure)
+      {
+        const auto firstFailure = std::find(
+            constraintResults.begin(), constraintResults.end(), false);
+        numTested = static_cast<std::size_t>(
+                        firstFailure - constraintResults.begin())
+                    + 1;
+
+        // The states following the first failure are not tested any further.
+        for (std::size_t i = numTested; i < remainingStates.size(); ++i)
+          results[remainingIndices[i]] = false;
+      }
+    }
+
+    if (mAdaptiveOrdering)
+    {
+      const auto numRejections = static_cast<std::size_t>(std::count(
+          constraintResults.begin(),
+          constraintResults.begin() + numTested,
+          false));
+      recordEvaluations(index, numTested, numRejections, duration);
+    }
+
+    std::size_t numRemaining = 0;
+    for (std::size_t i = 0; i < numTested; ++i)
+    {
+      if (constraintResults[i])
+      {
+        remainingStates[numRemaining] = remainingStates[i];
+        remainingIndices[numRemaining] = remainingIndices[i];
+        ++numRemaining;
+      }
+      else
+      {
+        results[remainingIndices[i]] = false;
+      }
+    }
+    remainingStates.resize(numRemaining);
+    remainingIndices.resize(numRemaining);
+  }
+
+  if (mAdaptiveOrdering)
+    updateOrder();
+
+  return allSatisfied;
+}
+
 //==============================================================================
 std::unique_ptr<TestableOutcome> TestableIntersection::createOutcome() const
 {
@@ -58,6 +216,8 @@ void TestableIntersection::addConstraint(TestablePtr _constraint)
 {
   if (_constraint->getStateSpace() == mStateSpace)
   {
+    mOrder.emplace_back(mConstraints.size());
+    mStatistics.emplace_back();
     mConstraints.emplace_back(std::move(_constraint));
   }
   else
@@ -67,6 +227,72 @@ void TestableIntersection::addConstraint(TestablePtr _constraint)
   }
 }
 
+//==============================================================================
+void TestableIntersection::setAdaptiveOrdering(bool adaptive)
+{
+  mAdaptiveOrdering = adaptive;
+
+  if (!mAdaptiveOrdering)
+  {
+    for (std::size_t i = 0; i < mOrder.size(); ++i)
+      mOrder[i] = i;
+  }
+}
+
+//==============================================================================
+bool TestableIntersection::isAdaptiveOrdering() const
+{
+  return mAdaptiveOrdering;
+}
+
+//==============================================================================
+std::vector<TestableIntersection::ConstraintStatistics>
+TestableIntersection::getConstraintStatistics() const
+{
+  return mStatistics;
+}
+
+//==============================================================================
+void TestableIntersection::resetConstraintStatistics()
+{
+  mStatistics.assign(mConstraints.size(), ConstraintStatistics());
+  mNumEvaluationsSinceReorder = 0;
+}
+
+//==============================================================================
+void TestableIntersection::recordEvaluations(
+    std::size_t index,
+    std::size_t numEvaluations,
+    std::size_t numRejections,
+    double duration) const
+{
+  auto& statistics = mStatistics[index];
+  statistics.numEvaluations += numEvaluations;
+  statistics.numRejections += numRejections;
+  statistics.totalDuration += duration;
+
+  mNumEvaluationsSinceReorder += numEvaluations;
+}
+
+//==============================================================================
+void TestableIntersection::updateOrder() const
+{
+  if (mNumEvaluationsSinceReorder < REORDER_INTERVAL)
+    return;
+
+  mNumEvaluationsSinceReorder = 0;
+
+  std::vector<double> ranks;
+  ranks.reserve(mStatistics.size());
+  for (const auto& statistics : mStatistics)
+    ranks.emplace_back(getRank(statistics));
+
+  std::stable_sort(
+      mOrder.begin(), mOrder.end(), [&ranks](std::size_t a, std::size_t b) {
+        return ranks[a] < ranks[b];
+      });
+}
+
 //==============================================================================
 void TestableIntersection::testConstraintStateSpaceOrThrow(
     const TestablePtr& constraint)
@@ -85,6 +85,54 @@ bool CollisionFree::isSatisfied(
   return true;
 }
 
+//==============================================================================
+bool CollisionFree::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::vector<bool>& results,
+    bool stopOnFailure) const
+{
+  using MetaSkeletonState
+      = aikido::statespace::dart::MetaSkeletonStateSpace::State;
+
+  results.assign(states.size(), false);
+
+  const std::size_t numChecks
+      = mGroupsToPairwiseCheck.size() + mGroupsToSelfCheck.size();
+
+  // Index of the check that detected the most recent collision.
+  std::size_t lastCollidingCheck = 0u;
+  ::dart::collision::CollisionResult collisionResult;
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    mMetaSkeletonStateSpace->setState(
+        mMetaSkeleton.get(), static_cast<const MetaSkeletonState*>(states[i]));
+
+    bool collision = false;
+    for (std::size_t j = 0; j < numChecks; ++j)
+    {
+      const std::size_t check = (lastCollidingCheck + j) % numChecks;
+      if (collide(check, &collisionResult))
+      {
+        collision = true;
+        lastCollidingCheck = check;
+        break;
+      }
+    }
+
+    results[i] = !collision;
+    if (collision)
+    {
+      allSatisfied = false;
+      if (stopOnFailure)
+        break;
+    }
+  }
+
+  return allSatisfied;
+}
+
 //==============================================================================
 std::unique_ptr<TestableOutcome> CollisionFree::createOutcome() const
 {
@@ -139,6 +187,22 @@ void CollisionFree::removeSelfCheck(
       mGroupsToSelfCheck.end());
 }
 
+//==============================================================================
+bool CollisionFree::collide(
+    std::size_t index, ::dart::collision::CollisionResult* result) const
+{
+  if (index < mGroupsToPairwiseCheck.size())
+  {
+    const auto& groups = mGroupsToPairwiseCheck[index];
+    return mCollisionDetector->collide(
+        groups.first.get(), groups.second.get(), mCollisionOptions, result);
+  }
+
+  const auto& group
+      = mGroupsToSelfCheck[index - mGroupsToPairwiseCheck.size()];
+  return mCollisionDetector->collide(group.get(), mCollisionOptions, result);
+}
+
 } // namespace dart
 } // namespace constraint
 } // namespace aikido
@@ -19,6 +19,90 @@ namespace aikido {
 namespace constraint {
 namespace dart {
 
+namespace {
+
+/// Angle below which the coefficients of the exponential map are replaced by
+/// the leading terms of their Taylor series.
+constexpr double SMALL_ANGLE{1e-2};
+
+/// Cosine of the pitch below which roll and yaw are considered to rotate
+/// about the same axis.
+constexpr double GIMBAL_LOCK_TOLERANCE{1e-9};
+
+/// Returns the left jacobian J of the SE(3) exponential map at _twist, such
+/// that exp(_twist + delta) ~= exp(J * delta) * exp(_twist). Twists are
+/// ordered [angular; linear], as in dart::math::expMap.
+Eigen::Matrix6d computeExpMapLeftJacobian(const Eigen::Vector6d& _twist)
+{
+  using ::dart::math::makeSkewSymmetric;
+
+  const Eigen::Matrix3d W = makeSkewSymmetric(_twist.head<3>());
+  const Eigen::Matrix3d V = makeSkewSymmetric(_twist.tail<3>());
+  const Eigen::Matrix3d WW = W * W;
+  const Eigen::Matrix3d WVW = W * V * W;
+  const double theta = _twist.head<3>().norm();
+  const double theta2 = theta * theta;
+
+  double a, b, c, d;
+  if (theta < SMALL_ANGLE)
+  {
+    a = 1. / 2. - theta2 / 24.;
+    b = 1. / 6. - theta2 / 120.;
+    c = 1. / 24. - theta2 / 720.;
+    d = 1. / 120. - theta2 / 2520.;
+  }
+  else
+  {
+    const double sinTheta = std::sin(theta);
+    const double cosTheta = std::cos(theta);
+    a = (1. - cosTheta) / theta2;
+    b = (theta - sinTheta) / (theta2 * theta);
+    c = (theta2 + 2. * cosTheta - 2.) / (2. * theta2 * theta2);
+    d = (2. * theta - 3. * sinTheta + theta * cosTheta)
+        / (2. * theta2 * theta2 * theta);
+  }
+
+  // See Barfoot, "State Estimation for Robotics", section 7.1.5.
+  const Eigen::Matrix3d J = Eigen::Matrix3d::Identity() + a * W + b * WW;
+  const Eigen::Matrix3d Q = 0.5 * V + b * (W * V + V * W + WVW)
+                            + c * (WW * V + V * WW - 3. * WVW)
+                            + d * (WVW * W + W * WVW);
+
+  Eigen::Matrix6d jacobian;
+  jacobian << J, Eigen::Matrix3d::Zero(), Q, J;
+  return jacobian;
+}
+
+/// Returns the matrix that maps an angular velocity w, with dR = [w] * R, to
+/// rates of the roll, pitch and yaw angles _rollPitchYaw of the rotation
+/// R = Rz(yaw) * Ry(pitch) * Rx(roll).
+Eigen::Matrix3d computeEulerRateJacobian(const Eigen::Vector3d& _rollPitchYaw)
+{
+  const double cosPitch = std::cos(_rollPitchYaw[1]);
+  const double sinPitch = std::sin(_rollPitchYaw[1]);
+  const double cosYaw = std::cos(_rollPitchYaw[2]);
+  const double sinYaw = std::sin(_rollPitchYaw[2]);
+
+  // Roll and yaw rotate about the same axis at pitch = +-pi/2.
+  if (std::abs(cosPitch) < GIMBAL_LOCK_TOLERANCE)
+  {
+    // Columns are the axes that roll, pitch and yaw rotate about.
+    Eigen::Matrix3d rateToVelocity;
+    rateToVelocity << cosYaw * cosPitch, -sinYaw, 0., sinYaw * cosPitch,
+        cosYaw, 0., -sinPitch, 0., 1.;
+    return rateToVelocity
+        .jacobiSvd(Eigen::ComputeFullU | Eigen::ComputeFullV)
+        .solve(Eigen::Matrix3d::Identity());
+  }
+
+  Eigen::Matrix3d velocityToRate;
+  velocityToRate << cosYaw / cosPitch, sinYaw / cosPitch, 0., -sinYaw, cosYaw,
+      0., cosYaw * sinPitch / cosPitch, sinYaw * sinPitch / cosPitch, 1.;
+  return velocityToRate;
+}
+
+} // namespace
+
 class TSRSampleGenerator : public SampleGenerator
 {
 public:
@@ -96,6 +180,7 @@ TSR::TSR(
   , mStateSpace(std::make_shared<SE3>())
 {
   validate();
+  updateInverseTransforms();
 }
 
 //==============================================================================
@@ -114,6 +199,7 @@ TSR::TSR(
   , mStateSpace(std::make_shared<SE3>())
 {
   validate();
+  updateInverseTransforms();
 }
 
 //==============================================================================
@@ -126,6 +212,7 @@ TSR::TSR(const TSR& other)
   , mStateSpace(std::make_shared<SE3>())
 {
   validate();
+  updateInverseTransforms();
 }
 
 //==============================================================================
@@ -138,6 +225,7 @@ TSR::TSR(TSR&& other)
   , mStateSpace(std::make_shared<SE3>())
 {
   validate();
+  updateInverseTransforms();
 }
 
 //==============================================================================
@@ -149,6 +237,7 @@ TSR& TSR::operator=(const TSR& other)
   mTw_e = other.mTw_e;
   mTestableTolerance = other.mTestableTolerance;
   mRng = other.mRng->clone();
+  updateInverseTransforms();
 
   // Intentionally don't assign StateSpace.
 
@@ -164,6 +253,7 @@ TSR& TSR::operator=(TSR&& other)
   mTestableTolerance = other.mTestableTolerance;
   mRng = std::move(other.mRng);
   mStateSpace = std::move(other.mStateSpace);
+  updateInverseTransforms();
 
   return *this;
 }
@@ -267,38 +357,153 @@ std::size_t TSR::getConstraintDimension() const
 void TSR::getValue(
     const statespace::StateSpace::State* _s, Eigen::VectorXd& _out) const
 {
-  using SE3 = statespace::SE3;
-  using SE3State = SE3::State;
+  using SE3State = statespace::SE3::State;
+
+  auto se3state = static_cast<const SE3State*>(_s);
+  const Eigen::Isometry3d Tw_s = computeTw_s(se3state->getIsometry());
+
+  Eigen::Vector6d slopes;
+  Eigen::Vector6d nearest;
+  computeDistance(Tw_s, _out, slopes, nearest);
+}
+
+//==============================================================================
+void TSR::getJacobian(
+    const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const
+{
+  Eigen::VectorXd value;
+  getValueAndJacobian(_s, value, _out);
+}
+
+//==============================================================================
+void TSR::getValueAndJacobian(
+    const statespace::StateSpace::State* _s,
+    Eigen::VectorXd& _val,
+    Eigen::MatrixXd& _jac) const
+{
+  using SE3State = statespace::SE3::State;
 
   auto se3state = static_cast<const SE3State*>(_s);
-  Eigen::Isometry3d se3 = se3state->getIsometry();
+  const Eigen::Isometry3d T0_s = se3state->getIsometry();
+  const Eigen::Isometry3d Tw_s = computeTw_s(T0_s);
+
+  Eigen::Vector6d slopes;
+  Eigen::Vector6d nearest;
+  computeDistance(Tw_s, _val, slopes, nearest);
+  computeJacobian(T0_s, Tw_s, slopes, _jac);
+}
+
+//==============================================================================
+std::vector<ConstraintType> TSR::getConstraintTypes() const
+{
+  return std::vector<ConstraintType>(6, ConstraintType::INEQUALITY);
+}
 
+//==============================================================================
+bool TSR::project(
+    const statespace::StateSpace::State* _s,
+    statespace::StateSpace::State* _out) const
+{
+  using SE3State = statespace::SE3::State;
+
+  auto se3state = static_cast<const SE3State*>(_s);
+  const Eigen::Isometry3d Tw_s = computeTw_s(se3state->getIsometry());
+
+  Eigen::VectorXd distance;
+  Eigen::Vector6d slopes;
+  Eigen::Vector6d nearest;
+  computeDistance(Tw_s, distance, slopes, nearest);
+
+  Eigen::Isometry3d projectedTw_s;
+  projectedTw_s.setIdentity();
+  projectedTw_s.translation() = nearest.head<3>();
+  projectedTw_s.linear()
+      = ::dart::math::eulerZYXToMatrix(nearest.tail<3>().reverse());
+
+  const Eigen::Isometry3d T0_s(mT0_w * projectedTw_s * mTw_e);
+  mStateSpace->setIsometry(static_cast<SE3State*>(_out), T0_s);
+
+  return true;
+}
+
+//==============================================================================
+void TSR::updateInverseTransforms()
+{
   using TransformTraits = Eigen::TransformTraits;
 
-  Eigen::Isometry3d T0_w_inv = mT0_w.inverse(TransformTraits::Isometry);
-  Eigen::Isometry3d Tw_e_inv = mTw_e.inverse(TransformTraits::Isometry);
-  Eigen::Isometry3d Tw_s = T0_w_inv * se3 * Tw_e_inv;
+  mT0_wInverse = mT0_w.inverse(TransformTraits::Isometry);
+  mTw_eInverse = mTw_e.inverse(TransformTraits::Isometry);
+  mInvertedT0_w = mT0_w;
+  mInvertedTw_e = mTw_e;
+}
+
+//==============================================================================
+Eigen::Isometry3d TSR::getT0_wInverse() const
+{
+  // mT0_w may have been assigned since its inverse was computed.
+  if (mT0_w.affine() == mInvertedT0_w.affine())
+    return mT0_wInverse;
+
+  return mT0_w.inverse(Eigen::TransformTraits::Isometry);
+}
+
+//==============================================================================
+Eigen::Isometry3d TSR::getTw_eInverse() const
+{
+  // mTw_e may have been assigned since its inverse was computed.
+  if (mTw_e.affine() == mInvertedTw_e.affine())
+    return mTw_eInverse;
+
+  return mTw_e.inverse(Eigen::TransformTraits::Isometry);
+}
+
+//==============================================================================
+Eigen::Isometry3d TSR::computeTw_s(const Eigen::Isometry3d& _T0_s) const
+{
+  return getT0_wInverse() * _T0_s * getTw_eInverse();
+}
 
-  Eigen::Vector3d translation = Tw_s.translation();
-  Eigen::Vector3d eulerOrig = ::dart::math::matrixToEulerZYX(Tw_s.linear());
+//==============================================================================
+void TSR::computeDistance(
+    const Eigen::Isometry3d& _Tw_s,
+    Eigen::VectorXd& _distance,
+    Eigen::Vector6d& _slopes,
+    Eigen::Vector6d& _nearest) const
+{
+  Eigen::Vector3d translation = _Tw_s.translation();
+  Eigen::Vector3d eulerOrig = ::dart::math::matrixToEulerZYX(_Tw_s.linear());
   Eigen::Vector3d eulerZYX = eulerOrig.reverse();
 
-  _out.resize(6);
+  _distance.resize(6);
 
   for (int i = 0; i < 3; ++i)
   {
     if (translation(i) < mBw(i, 0))
-      _out(i) = std::abs(translation(i) - mBw(i, 0));
-
+    {
+      _distance(i) = std::abs(translation(i) - mBw(i, 0));
+      _slopes(i) = -1;
+      _nearest(i) = mBw(i, 0);
+    }
     else if (translation(i) > mBw(i, 1))
-      _out(i) = std::abs(translation(i) - mBw(i, 1));
-
+    {
+      _distance(i) = std::abs(translation(i) - mBw(i, 1));
+      _slopes(i) = 1;
+      _nearest(i) = mBw(i, 1);
+    }
     else
-      _out(i) = 0;
+    {
+      _distance(i) = 0;
+      _slopes(i) = 0;
+      _nearest(i) = translation(i);
+    }
   }
 
   for (int i = 3; i < 6; ++i)
   {
+    _distance(i) = 0;
+    _slopes(i) = 0;
+    _nearest(i) = eulerZYX(i - 3);
+
     // Find n such that: 2*n*pi <= mBw(i, 0) < 2*(n+1)*pi
     int n = mBw(i, 0) / (2 * M_PI);
 
@@ -309,75 +514,73 @@ void TSR::getValue(
     if ((angle >= mBw(i, 0) && angle <= mBw(i, 1))
         || (angle + M_PI * 2 >= mBw(i, 0) && angle + M_PI * 2 <= mBw(i, 1))
         || (angle - M_PI * 2 >= mBw(i, 0) && angle - M_PI * 2 <= mBw(i, 1)))
-    {
-      _out(i) = 0;
       continue;
-    }
 
     // Take min-distance between angle and either side of bound
+    double toLower, toUpper;
     if (angle < mBw(i, 0))
-      _out(i) = std::min(mBw(i, 0) - angle, angle - (mBw(i, 1) - 2 * M_PI));
-
-    else if (mBw(i, 1) < angle)
-      _out(i) = std::min(angle - mBw(i, 1), mBw(i, 0) + 2 * M_PI - angle);
-  }
-}
-
-//==============================================================================
-void TSR::getJacobian(
-    const statespace::StateSpace::State* _s, Eigen::MatrixXd& _out) const
-{
-  using SE3 = statespace::SE3;
-  using SE3State = SE3::State;
-
-  _out.resize(6, 6);
-
-  auto se3state = static_cast<const SE3State*>(_s);
-  Eigen::Isometry3d se3 = se3state->getIsometry();
-
-  Eigen::Vector6d twist = ::dart::math::logMap(se3);
-
-  Eigen::Vector6d posit(twist), negat(twist);
-
-  static constexpr double eps = 1e-5;
-
-  auto se3posit = mStateSpace->createState();
-  auto se3negat = mStateSpace->createState();
-
-  // Finite Differencing.
-  for (int i = 0; i < 6; ++i)
-  {
-    posit(i) = twist(i) + eps;
-    negat(i) = twist(i) - eps;
-
-    se3posit.setIsometry(::dart::math::expMap(posit));
-    se3negat.setIsometry(::dart::math::expMap(negat));
-
-    Eigen::VectorXd positValue, negatValue;
-    getValue(se3posit, positValue);
-    getValue(se3negat, negatValue);
-
-    Eigen::Vector6d diff = positValue - negatValue;
-    _out.col(i) = diff / (2 * eps);
+    {
+      toLower = mBw(i, 0) - angle;
+      toUpper = angle - (mBw(i, 1) - 2 * M_PI);
+    }
+    else
+    {
+      toLower = mBw(i, 0) + 2 * M_PI - angle;
+      toUpper = angle - mBw(i, 1);
+    }
 
-    posit(i) = twist(i);
-    negat(i) = twist(i);
+    if (toLower <= toUpper)
+    {
+      _distance(i) = toLower;
+      _slopes(i) = -1;
+      _nearest(i) = mBw(i, 0);
+    }
+    else
+    {
+      _distance(i) = toUpper;
+      _slopes(i) = 1;
+      _nearest(i) = mBw(i, 1);
+    }
   }
 }
 
 //==============================================================================
-std::vector<ConstraintType> TSR::getConstraintTypes() const
-{
-  return std::vector<ConstraintType>(6, ConstraintType::INEQUALITY);
-}
-
-//==============================================================================
-bool TSR::project(
-    const statespace::StateSpace::State* /*_s*/,
-    statespace::StateSpace::State* /*_out*/) const
+void TSR::computeJacobian(
+    const Eigen::Isometry3d& _T0_s,
+    const Eigen::Isometry3d& _Tw_s,
+    const Eigen::Vector6d& _slopes,
+    Eigen::MatrixXd& _out) const
 {
-  // TODO
-  return false;
+  _out.setZero(6, 6);
+  if (_slopes.isZero())
+    return;
+
+  // Tw_s = T0_w^-1 * T0_s * Tw_e^-1, so perturbing T0_s to exp(eta) * T0_s,
+  // with eta = [w; v], perturbs Tw_s by eta transformed into the TSR frame:
+  //   d(translation) = [p - t] * R * w + R * v
+  //   d(roll, pitch, yaw) = E * R * w
+  // where (R, p) is T0_w^-1, t is the translation of Tw_s and E maps angular
+  // velocities to rates of roll, pitch and yaw.
+  const Eigen::Isometry3d T0_w_inv = getT0_wInverse();
+  const Eigen::Matrix3d& rotation = T0_w_inv.linear();
+  const Eigen::Vector3d eulerZYX
+      = ::dart::math::matrixToEulerZYX(_Tw_s.linear()).reverse();
+
+  Eigen::Matrix6d coordinateJacobian;
+  coordinateJacobian.topLeftCorner<3, 3>()
+      = ::dart::math::makeSkewSymmetric(
+            T0_w_inv.translation() - _Tw_s.translation())
+        * rotation;
+  coordinateJacobian.topRightCorner<3, 3>() = rotation;
+  coordinateJacobian.bottomLeftCorner<3, 3>()
+      = computeEulerRateJacobian(eulerZYX) * rotation;
+  coordinateJacobian.bottomRightCorner<3, 3>().setZero();
+
+  // The tangent vector of T0_s perturbs T0_s through the exponential map.
+  const Eigen::Vector6d twist = ::dart::math::logMap(_T0_s);
+
+  _out = _slopes.asDiagonal() * coordinateJacobian
+         * computeExpMapLeftJacobian(twist);
 }
 
 //==============================================================================
@@ -160,6 +160,42 @@ bool SE2BoxConstraint::isSatisfied(
   return true;
 }
 
+//==============================================================================
+bool SE2BoxConstraint::isSatisfiedBatch(
+    const std::vector<const statespace::StateSpace::State*>& states,
+    std::vector<bool>& results,
+    bool stopOnFailure) const
+{
+  results.assign(states.size(), false);
+
+  const auto start = mDimension - mRnDimension;
+  const auto lowerLimits = mLowerLimits.segment(start, mRnDimension).array();
+  const auto upperLimits = mUpperLimits.segment(start, mRnDimension).array();
+
+  // Reuse the same tangent vector for the whole batch.
+  Eigen::VectorXd tangent(mDimension);
+
+  bool allSatisfied = true;
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    mSpace->logMap(
+        static_cast<const statespace::SE2::State*>(states[i]), tangent);
+    const auto translation = tangent.segment(start, mRnDimension).array();
+
+    results[i] = !(translation < lowerLimits).any()
+                 && !(translation > upperLimits).any();
+
+    if (!results[i])
+    {
+      allSatisfied = false;
+      if (stopOnFailure)
+        break;
+    }
+  }
+
+  return allSatisfied;
+}
+
 //==============================================================================
 std::unique_ptr<TestableOutcome> SE2BoxConstraint::createOutcome() const
 {
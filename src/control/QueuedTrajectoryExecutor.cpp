@@ -1,16 +1,31 @@
 #include "aikido/control/QueuedTrajectoryExecutor.hpp"
 #include <chrono>
+#include "detail/SplicedTrajectory.hpp"
 
 namespace aikido {
 namespace control {
 
 //==============================================================================
 QueuedTrajectoryExecutor::QueuedTrajectoryExecutor(
-    std::shared_ptr<TrajectoryExecutor> executor)
-  : mExecutor{std::move(executor)}, mInProgress{false}, mMutex{}
+    std::shared_ptr<TrajectoryExecutor> executor,
+    bool lookAhead,
+    double junctionTolerance,
+    JunctionBlender blender)
+  : mExecutor{std::move(executor)}
+  , mLookAhead{lookAhead}
+  , mJunctionTolerance{junctionTolerance}
+  , mBlender{std::move(blender)}
+  , mInProgress{false}
+  , mNumInProgress{0}
+  , mSplicedTrajectory{nullptr}
+  , mSplicingStopped{false}
+  , mMutex{}
 {
   if (!mExecutor)
     throw std::invalid_argument("Executor is null.");
+
+  if (mJunctionTolerance < 0.0)
+    throw std::invalid_argument("Junction tolerance must be non-negative.");
 }
 
 //==============================================================================
@@ -38,7 +53,12 @@ std::future<void> QueuedTrajectoryExecutor::execute(
     // Queue the trajectory and promise that will need to be set
     mTrajectoryQueue.push(std::move(traj));
     mPromiseQueue.emplace(new std::promise<void>());
-    return mPromiseQueue.back()->get_future();
+    auto future = mPromiseQueue.back()->get_future();
+
+    // Append it to the running trajectory before execution reaches its end
+    spliceQueuedTrajectories();
+
+    return future;
   }
 }
 
@@ -46,6 +66,13 @@ std::future<void> QueuedTrajectoryExecutor::execute(
 void QueuedTrajectoryExecutor::step(
     const std::chrono::system_clock::time_point& timepoint)
 {
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    DART_UNUSED(lock); // Suppress unused variable warning
+
+    spliceQueuedTrajectories();
+  }
+
   mExecutor->step(timepoint);
 
   std::lock_guard<std::mutex> lock(mMutex);
@@ -54,27 +81,53 @@ void QueuedTrajectoryExecutor::step(
   // If a trajectory was executing, check if it has finished
   if (mInProgress)
   {
+    // In look-ahead mode, finish the trajectories that execution has passed.
+    // The last one finishes with the underlying executor.
+    if (mSplicedTrajectory)
+    {
+      const std::size_t numFinished = mSplicedTrajectory->getNumFinished();
+      const std::size_t numResolved
+          = mSplicedTrajectory->getNumTrajectories() - mNumInProgress;
+
+      for (std::size_t i = numResolved; i < numFinished && mNumInProgress > 1;
+           ++i)
+      {
+        mPromiseQueue.front()->set_value();
+        mPromiseQueue.pop();
+        --mNumInProgress;
+      }
+    }
+
     // Return if the trajectory is still executing
     if (mFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
       return;
 
     mInProgress = false;
+    mSplicedTrajectory.reset();
 
     // The promise corresponding to the trajectory that just finished must be
     // at the front of its queue.
     auto promise = mPromiseQueue.front();
     mPromiseQueue.pop();
+    --mNumInProgress;
 
     // Propagate the future's value or exception to the caller
     try
     {
       mFuture.get();
       promise->set_value();
+
+      // Execution has passed all the trajectories appended to it.
+      for (; mNumInProgress > 0; --mNumInProgress)
+      {
+        mPromiseQueue.front()->set_value();
+        mPromiseQueue.pop();
+      }
     }
     catch (const std::exception& e)
     {
       promise->set_exception(std::current_exception());
-      abort();
+      abortQueue();
     }
   }
 
@@ -84,8 +137,19 @@ void QueuedTrajectoryExecutor::step(
     trajectory::TrajectoryPtr traj = mTrajectoryQueue.front();
     mTrajectoryQueue.pop();
 
+    if (mLookAhead)
+    {
+      mSplicedTrajectory
+          = std::make_shared<detail::SplicedTrajectory>(std::move(traj));
+      traj = mSplicedTrajectory;
+    }
+
     mFuture = mExecutor->execute(std::move(traj));
     mInProgress = true;
+    mNumInProgress = 1;
+    mSplicingStopped = false;
+
+    spliceQueuedTrajectories();
   }
 }
 
@@ -95,31 +159,96 @@ void QueuedTrajectoryExecutor::abort()
   std::lock_guard<std::mutex> lock(mMutex);
   DART_UNUSED(lock); // Suppress unused variable warning
 
-  std::exception_ptr abort
-      = std::make_exception_ptr(std::runtime_error("Trajectory aborted."));
-
   if (mInProgress)
   {
     mExecutor->abort();
 
-    // Set our own exception, since abort may not be supported
-    auto promise = mPromiseQueue.front();
-    mPromiseQueue.pop();
-    promise->set_exception(abort);
-
     mInProgress = false;
+    mSplicedTrajectory.reset();
   }
 
-  // Trajectory and promise queue are now the same length
+  abortQueue();
+}
+
+//==============================================================================
+void QueuedTrajectoryExecutor::spliceQueuedTrajectories()
+{
+  if (!mInProgress || !mSplicedTrajectory || mSplicingStopped)
+    return;
+
+  while (!mTrajectoryQueue.empty())
+  {
+    const auto previous = mSplicedTrajectory->getLastTrajectory();
+    auto next = mTrajectoryQueue.front();
+
+    try
+    {
+      if (mBlender)
+        next = mBlender(*previous, std::move(next));
+
+      // Appended trajectories never reach mExecutor->execute(), so they are
+      // validated here instead.
+      mExecutor->validate(next);
+    }
+    catch (const std::exception& e)
+    {
+      dtwarn << "[QueuedTrajectoryExecutor] Failed to splice trajectories: "
+             << e.what() << "\n";
+      mSplicingStopped = true;
+      return;
+    }
+
+    // Otherwise the trajectory is started after the previous one finishes.
+    if (!next || next->getStateSpace() != mSplicedTrajectory->getStateSpace()
+        || !isContinuous(*previous, *next)
+        || !mSplicedTrajectory->append(next))
+    {
+      mSplicingStopped = true;
+      return;
+    }
+
+    mTrajectoryQueue.pop();
+    ++mNumInProgress;
+  }
+}
+
+//==============================================================================
+bool QueuedTrajectoryExecutor::isContinuous(
+    const trajectory::Trajectory& previous,
+    const trajectory::Trajectory& next) const
+{
+  const auto stateSpace = previous.getStateSpace();
+
+  auto difference = stateSpace->createState();
+  previous.evaluate(previous.getEndTime(), difference);
+  stateSpace->getInverse(difference);
+
+  auto nextStart = stateSpace->createState();
+  next.evaluate(next.getStartTime(), nextStart);
+  stateSpace->compose(difference, nextStart);
+
+  Eigen::VectorXd tangent;
+  stateSpace->logMap(difference, tangent);
+  return tangent.norm() <= mJunctionTolerance;
+}
+
+//==============================================================================
+void QueuedTrajectoryExecutor::abortQueue()
+{
+  std::exception_ptr abort
+      = std::make_exception_ptr(std::runtime_error("Trajectory aborted."));
+
   while (!mPromiseQueue.empty())
   {
     auto promise = mPromiseQueue.front();
     mPromiseQueue.pop();
     promise->set_exception(abort);
+  }
 
+  while (!mTrajectoryQueue.empty())
     mTrajectoryQueue.pop();
-  }
 
+  mNumInProgress = 0;
   mFuture = std::future<void>();
 }
 
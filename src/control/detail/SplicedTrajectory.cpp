@@ -0,0 +1,148 @@
+#include "SplicedTrajectory.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace aikido {
+namespace control {
+namespace detail {
+
+//==============================================================================
+SplicedTrajectory::SplicedTrajectory(trajectory::TrajectoryPtr trajectory)
+  : mExecutionTime{-std::numeric_limits<double>::infinity()}
+{
+  if (!trajectory)
+    throw std::invalid_argument("Trajectory is null.");
+
+  mStateSpace = trajectory->getStateSpace();
+  mEndTimes.push_back(trajectory->getEndTime());
+  mTrajectories.push_back(std::move(trajectory));
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr SplicedTrajectory::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+std::size_t SplicedTrajectory::getNumDerivatives() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  std::size_t numDerivatives = 0;
+  for (const auto& trajectory : mTrajectories)
+  {
+    numDerivatives
+        = std::max(numDerivatives, trajectory->getNumDerivatives());
+  }
+
+  return numDerivatives;
+}
+
+//==============================================================================
+double SplicedTrajectory::getDuration() const
+{
+  return getEndTime() - getStartTime();
+}
+
+//==============================================================================
+double SplicedTrajectory::getStartTime() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mTrajectories.front()->getStartTime();
+}
+
+//==============================================================================
+double SplicedTrajectory::getEndTime() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEndTimes.back();
+}
+
+//==============================================================================
+void SplicedTrajectory::evaluate(
+    double t, statespace::StateSpace::State* state) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mExecutionTime = std::max(mExecutionTime, t);
+
+  double localTime;
+  const std::size_t index = getIndex(t, localTime);
+  mTrajectories[index]->evaluate(localTime, state);
+}
+
+//==============================================================================
+void SplicedTrajectory::evaluateDerivative(
+    double t, int derivative, Eigen::VectorXd& tangentVector) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mExecutionTime = std::max(mExecutionTime, t);
+
+  double localTime;
+  const std::size_t index = getIndex(t, localTime);
+  mTrajectories[index]->evaluateDerivative(
+      localTime, derivative, tangentVector);
+}
+
+//==============================================================================
+bool SplicedTrajectory::append(trajectory::TrajectoryPtr trajectory)
+{
+  if (!trajectory)
+    throw std::invalid_argument("Trajectory is null.");
+
+  if (trajectory->getStateSpace() != mStateSpace)
+    throw std::invalid_argument("Trajectory is in a different state space.");
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mExecutionTime >= mEndTimes.back())
+    return false;
+
+  mEndTimes.push_back(mEndTimes.back() + trajectory->getDuration());
+  mTrajectories.push_back(std::move(trajectory));
+  return true;
+}
+
+//==============================================================================
+std::size_t SplicedTrajectory::getNumTrajectories() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mTrajectories.size();
+}
+
+//==============================================================================
+trajectory::ConstTrajectoryPtr SplicedTrajectory::getLastTrajectory() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mTrajectories.back();
+}
+
+//==============================================================================
+std::size_t SplicedTrajectory::getNumFinished() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return std::upper_bound(mEndTimes.begin(), mEndTimes.end(), mExecutionTime)
+         - mEndTimes.begin();
+}
+
+//==============================================================================
+std::size_t SplicedTrajectory::getIndex(double t, double& localTime) const
+{
+  const std::size_t index = std::min<std::size_t>(
+      std::upper_bound(mEndTimes.begin(), mEndTimes.end(), t)
+          - mEndTimes.begin(),
+      mEndTimes.size() - 1);
+
+  if (index == 0)
+    localTime = t;
+  else
+    localTime = t - mEndTimes[index - 1]
+                + mTrajectories[index]->getStartTime();
+
+  return index;
+}
+
+} // namespace detail
+} // namespace control
+} // namespace aikido
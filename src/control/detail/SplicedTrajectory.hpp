@@ -0,0 +1,93 @@
+#ifndef AIKIDO_CONTROL_DETAIL_SPLICEDTRAJECTORY_HPP_
+#define AIKIDO_CONTROL_DETAIL_SPLICEDTRAJECTORY_HPP_
+
+#include <mutex>
+#include <vector>
+#include "aikido/trajectory/Trajectory.hpp"
+
+namespace aikido {
+namespace control {
+namespace detail {
+
+/// Trajectory that executes a sequence of trajectories back to back, to
+/// which trajectories can be appended while it is being executed. Each
+/// trajectory starts at the end time of the previous one.
+///
+/// A trajectory can only be appended before this trajectory has been
+/// evaluated at or after its end time, so an executor that evaluates it
+/// while executing it, e.g. KinematicSimulationTrajectoryExecutor, either
+/// executes the appended trajectory without a gap or has already finished.
+class SplicedTrajectory : public trajectory::Trajectory
+{
+public:
+  /// Constructor.
+  ///
+  /// \param trajectory first trajectory to execute
+  explicit SplicedTrajectory(trajectory::TrajectoryPtr trajectory);
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  std::size_t getNumDerivatives() const override;
+
+  // Documentation inherited.
+  double getDuration() const override;
+
+  // Documentation inherited.
+  double getStartTime() const override;
+
+  // Documentation inherited.
+  double getEndTime() const override;
+
+  // Documentation inherited.
+  void evaluate(
+      double t, statespace::StateSpace::State* state) const override;
+
+  // Documentation inherited.
+  void evaluateDerivative(
+      double t, int derivative, Eigen::VectorXd& tangentVector) const override;
+
+  /// Appends \c trajectory, unless this trajectory has already been
+  /// evaluated at or after its end time.
+  ///
+  /// \param trajectory trajectory in the same state space
+  /// \return whether \c trajectory was appended
+  bool append(trajectory::TrajectoryPtr trajectory);
+
+  /// Returns the number of trajectories in the sequence.
+  std::size_t getNumTrajectories() const;
+
+  /// Returns the last trajectory in the sequence.
+  trajectory::ConstTrajectoryPtr getLastTrajectory() const;
+
+  /// Returns the number of trajectories in the sequence whose end time is at
+  /// or before the latest time at which this trajectory has been evaluated.
+  std::size_t getNumFinished() const;
+
+private:
+  /// Returns the index of the trajectory that contains time t and the time
+  /// in that trajectory that corresponds to t. Requires mMutex to be locked.
+  std::size_t getIndex(double t, double& localTime) const;
+
+  /// State space of the trajectories.
+  statespace::ConstStateSpacePtr mStateSpace;
+
+  /// Trajectories in the order they are executed.
+  std::vector<trajectory::TrajectoryPtr> mTrajectories;
+
+  /// End time of each trajectory in the time of this trajectory.
+  std::vector<double> mEndTimes;
+
+  /// Latest time at which this trajectory has been evaluated.
+  mutable double mExecutionTime;
+
+  /// Manages access to mTrajectories, mEndTimes and mExecutionTime.
+  mutable std::mutex mMutex;
+};
+
+} // namespace detail
+} // namespace control
+} // namespace aikido
+
+#endif // AIKIDO_CONTROL_DETAIL_SPLICEDTRAJECTORY_HPP_
@@ -159,42 +159,6 @@ void extractJointTrajectoryPoint(
   }
 }
 
-//==============================================================================
-void extractTrajectoryPoint(
-    const std::shared_ptr<const MetaSkeletonStateSpace>& space,
-    const aikido::trajectory::TrajectoryPtr& trajectory,
-    double timeFromStart,
-    trajectory_msgs::JointTrajectoryPoint& waypoint)
-{
-  const auto numDerivatives = std::min<int>(trajectory->getNumDerivatives(), 1);
-  const auto timeAbsolute = trajectory->getStartTime() + timeFromStart;
-  const int numDof = space->getDimension();
-  DART_UNUSED(numDof);
-
-  Eigen::VectorXd tangentVector;
-  auto state = space->createState();
-  trajectory->evaluate(timeAbsolute, state);
-  space->logMap(state, tangentVector);
-
-  assert(tangentVector.size() == numDof);
-
-  waypoint.time_from_start = ::ros::Duration(timeFromStart);
-  waypoint.positions.assign(
-      tangentVector.data(), tangentVector.data() + tangentVector.size());
-
-  assert(0 <= numDerivatives && numDerivatives <= 2);
-  const std::array<std::vector<double>*, 2> derivatives{
-      &waypoint.velocities, &waypoint.accelerations};
-  for (int iDerivative = 1; iDerivative <= numDerivatives; ++iDerivative)
-  {
-    trajectory->evaluateDerivative(timeAbsolute, iDerivative, tangentVector);
-    assert(tangentVector.size() == numDof);
-
-    derivatives[iDerivative - 1]->assign(
-        tangentVector.data(), tangentVector.data() + tangentVector.size());
-  }
-}
-
 //==============================================================================
 // The rows of inVector is reordered in outVector.
 void reorder(
@@ -495,15 +459,38 @@ trajectory_msgs::JointTrajectory toRosJointTrajectory(
     jointTrajectory.joint_names.emplace_back(jointDofName);
   }
 
-  // Evaluate trajectory at each timestep and insert it into jointTrajectory
+  // Evaluate positions, and velocities if available, at all timesteps at once
+  std::vector<double> times;
+  times.reserve(numWaypoints);
+  for (const auto timeFromStart : timeSequence)
+    times.emplace_back(trajectory->getStartTime() + timeFromStart);
+
+  std::vector<int> derivatives{0};
+  if (trajectory->getNumDerivatives() > 0)
+    derivatives.emplace_back(1);
+
+  Eigen::MatrixXd evaluations;
+  trajectory->evaluateBatch(times, evaluations, derivatives);
+
+  // Insert each evaluation into jointTrajectory
+  const auto numDofs = space->getDimension();
   jointTrajectory.points.reserve(numWaypoints);
+  std::size_t iWaypoint = 0;
   for (const auto timeFromStart : timeSequence)
   {
     trajectory_msgs::JointTrajectoryPoint waypoint;
+    waypoint.time_from_start = ::ros::Duration(timeFromStart);
 
-    extractTrajectoryPoint(space, trajectory, timeFromStart, waypoint);
+    const double* evaluation = evaluations.col(iWaypoint).data();
+    waypoint.positions.assign(evaluation, evaluation + numDofs);
+    if (derivatives.size() > 1)
+    {
+      waypoint.velocities.assign(
+          evaluation + numDofs, evaluation + 2 * numDofs);
+    }
 
     jointTrajectory.points.emplace_back(waypoint);
+    ++iWaypoint;
   }
 
   return jointTrajectory;
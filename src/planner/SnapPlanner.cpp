@@ -1,3 +1,4 @@
+#include <vector>
 #include <aikido/common/VanDerCorput.hpp>
 #include <aikido/constraint/Testable.hpp>
 #include <aikido/planner/PlanningResult.hpp>
@@ -25,16 +26,27 @@ trajectory::InterpolatedPtr planSnap(
   aikido::common::VanDerCorput vdc{1, true, true, 0.02}; // TODO junk resolution
   auto returnTraj
       = std::make_shared<trajectory::Interpolated>(stateSpace, interpolator);
-  auto testState = stateSpace->createState();
 
+  // Interpolate all the samples up front so the constraint can test the whole
+  // edge in a single batch.
+  std::vector<statespace::StateSpace::ScopedState> testStates;
+  std::vector<const statespace::StateSpace::State*> testStatePtrs;
+  testStates.reserve(vdc.getLength());
+  testStatePtrs.reserve(vdc.getLength());
+
+  const auto edge = interpolator->prepareEdge(startState, goalState);
   for (const auto alpha : vdc)
   {
-    interpolator->interpolate(startState, goalState, alpha, testState);
-    if (!constraint->isSatisfied(testState))
-    {
-      planningResult.message = "Collision detected";
-      return nullptr;
-    }
+    testStates.emplace_back(stateSpace->createState());
+    edge->interpolate(alpha, testStates.back());
+    testStatePtrs.emplace_back(testStates.back());
+  }
+
+  std::vector<bool> results;
+  if (!constraint->isSatisfiedBatch(testStatePtrs, results))
+  {
+    planningResult.message = "Collision detected";
+    return nullptr;
   }
 
   returnTraj->addWaypoint(0, startState);
@@ -205,6 +205,25 @@ void GeometricStateSpace::interpolate(
   mInterpolator->interpolate(from->mState, to->mState, _t, state->mState);
 }
 
+//==============================================================================
+std::unique_ptr<statespace::Interpolator::Edge>
+GeometricStateSpace::prepareEdge(
+    const ::ompl::base::State* _from, const ::ompl::base::State* _to) const
+{
+  auto from = static_cast<const StateType*>(_from);
+  if (from == nullptr || from->mState == nullptr)
+    throw std::invalid_argument("prepareEdge called with null from state");
+  auto to = static_cast<const StateType*>(_to);
+  if (to == nullptr || to->mState == nullptr)
+    throw std::invalid_argument("prepareEdge called with null to state");
+  if (!from->mValid)
+    throw std::invalid_argument("prepareEdge called with invalid from state");
+  if (!to->mValid)
+    throw std::invalid_argument("prepareEdge called with invalid to state");
+
+  return mInterpolator->prepareEdge(from->mState, to->mState);
+}
+
 //==============================================================================
 ::ompl::base::StateSamplerPtr GeometricStateSpace::allocDefaultStateSampler()
     const
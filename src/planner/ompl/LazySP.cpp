@@ -0,0 +1,819 @@
+#include <aikido/planner/ompl/LazySP.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <Eigen/Core>
+#include <ompl/base/goals/GoalSampleableRegion.h>
+#include <ompl/datastructures/NearestNeighborsGNAT.h>
+#include "detail/BinaryStream.hpp"
+
+namespace aikido {
+namespace planner {
+namespace ompl {
+
+using detail::readCount;
+using detail::readValue;
+using detail::writeValue;
+
+namespace {
+
+constexpr std::size_t NO_VERTEX = std::numeric_limits<std::size_t>::max();
+
+/// Identifies the format written by LazySP::saveRoadmap.
+constexpr std::uint32_t ROADMAP_MAGIC = 0x4c5a5350;
+constexpr std::uint32_t ROADMAP_VERSION = 1;
+
+} // namespace
+
+//==============================================================================
+LazySP::LazySP(const ::ompl::base::SpaceInformationPtr& _si)
+  : LazySP(_si, "LazySP")
+{
+}
+
+//==============================================================================
+LazySP::LazySP(
+    const ::ompl::base::SpaceInformationPtr& _si, const std::string& _name)
+  : ::ompl::base::Planner(_si, _name)
+  , mBatchSize(100)
+  , mMaxNumNeighbors(10)
+  , mNumEvaluations(0)
+{
+  specs_.approximateSolutions = false;
+  specs_.multipleStartStates = true;
+  specs_.optimizingPaths = false;
+
+  Planner::declareParam<unsigned int>(
+      "batch_size",
+      this,
+      &LazySP::setBatchSize,
+      &LazySP::getBatchSize,
+      "1:1:10000");
+  Planner::declareParam<unsigned int>(
+      "max_nearest_neighbors",
+      this,
+      &LazySP::setMaxNumNeighbors,
+      &LazySP::getMaxNumNeighbors,
+      "1:1:1000");
+}
+
+//==============================================================================
+LazySP::~LazySP()
+{
+  freeMemory();
+}
+
+//==============================================================================
+void LazySP::getPlannerData(::ompl::base::PlannerData& _data) const
+{
+  ::ompl::base::Planner::getPlannerData(_data);
+
+  for (const auto index : mStartVertices)
+    _data.addStartVertex(
+        ::ompl::base::PlannerDataVertex(mVertices[index].mState));
+
+  for (const auto index : mGoalVertices)
+    _data.addGoalVertex(
+        ::ompl::base::PlannerDataVertex(mVertices[index].mState));
+
+  for (const auto& vertex : mVertices)
+  {
+    if (vertex.mState && vertex.mStatus != Status::INVALID)
+      _data.addVertex(::ompl::base::PlannerDataVertex(vertex.mState));
+  }
+
+  for (const auto& edge : mEdges)
+  {
+    if (edge.mSource == NO_VERTEX || edge.mStatus == Status::INVALID
+        || mVertices[edge.mSource].mStatus == Status::INVALID
+        || mVertices[edge.mTarget].mStatus == Status::INVALID)
+      continue;
+
+    _data.addEdge(
+        ::ompl::base::PlannerDataVertex(mVertices[edge.mSource].mState),
+        ::ompl::base::PlannerDataVertex(mVertices[edge.mTarget].mState));
+  }
+}
+
+//==============================================================================
+::ompl::base::PlannerStatus LazySP::solve(
+    const ::ompl::base::PlannerTerminationCondition& _ptc)
+{
+  checkValidity();
+
+  auto goal = dynamic_cast<::ompl::base::GoalSampleableRegion*>(
+      pdef_->getGoal().get());
+  if (!goal)
+    return ::ompl::base::PlannerStatus::UNRECOGNIZED_GOAL_TYPE;
+
+  while (const ::ompl::base::State* st = pis_.nextStart())
+    mStartVertices.emplace_back(addQueryVertex(st));
+
+  if (mStartVertices.empty())
+    return ::ompl::base::PlannerStatus::INVALID_START;
+
+  // A goal region may have infinitely many states, so more are only added as
+  // the roadmap grows.
+  if (mGoalVertices.empty())
+  {
+    if (const ::ompl::base::State* st = pis_.nextGoal(_ptc))
+      mGoalVertices.emplace_back(addQueryVertex(st));
+  }
+
+  if (mGoalVertices.empty())
+    return ::ompl::base::PlannerStatus::INVALID_GOAL;
+
+  if (!mSampler)
+    mSampler = si_->allocStateSampler();
+
+  std::vector<std::size_t> path;
+  bool solved = false;
+  while (_ptc == false)
+  {
+    if (!findShortestPath(path))
+    {
+      if (pis_.haveMoreGoalStates())
+      {
+        if (const ::ompl::base::State* st = pis_.nextGoal())
+          mGoalVertices.emplace_back(addQueryVertex(st));
+      }
+
+      growRoadmap(_ptc);
+      continue;
+    }
+
+    if (evaluatePath(path, _ptc))
+    {
+      solved = true;
+      break;
+    }
+  }
+
+  if (solved)
+  {
+    auto solution = ompl_make_shared<::ompl::geometric::PathGeometric>(si_);
+    for (const auto index : path)
+      solution->append(mVertices[index].mState);
+    pdef_->addSolutionPath(solution, false, 0.0);
+  }
+
+  return ::ompl::base::PlannerStatus(solved, false);
+}
+
+//==============================================================================
+::ompl::base::PlannerStatus LazySP::solve(double _solveTime)
+{
+  return ::ompl::base::Planner::solve(_solveTime);
+}
+
+//==============================================================================
+void LazySP::setProblemDefinition(
+    const ::ompl::base::ProblemDefinitionPtr& _pdef)
+{
+  ::ompl::base::Planner::setProblemDefinition(_pdef);
+  clearQuery();
+}
+
+//==============================================================================
+void LazySP::clearQuery()
+{
+  for (const auto index : mStartVertices)
+    removeQueryVertex(index);
+
+  for (const auto index : mGoalVertices)
+    removeQueryVertex(index);
+
+  mStartVertices.clear();
+  mGoalVertices.clear();
+  pis_.clear();
+  pis_.use(pdef_);
+}
+
+//==============================================================================
+void LazySP::clear()
+{
+  ::ompl::base::Planner::clear();
+  mSampler.reset();
+  freeMemory();
+  if (mNearestNeighbors)
+    mNearestNeighbors->clear();
+  mVertices.clear();
+  mEdges.clear();
+  mFreeVertices.clear();
+  mFreeEdges.clear();
+  mStartVertices.clear();
+  mGoalVertices.clear();
+  mNumEvaluations = 0;
+}
+
+//==============================================================================
+void LazySP::setBatchSize(unsigned int _batchSize)
+{
+  if (_batchSize == 0)
+    throw std::invalid_argument("Batch size must be positive.");
+
+  mBatchSize = _batchSize;
+}
+
+//==============================================================================
+unsigned int LazySP::getBatchSize() const
+{
+  return mBatchSize;
+}
+
+//==============================================================================
+void LazySP::setMaxNumNeighbors(unsigned int _maxNumNeighbors)
+{
+  if (_maxNumNeighbors == 0)
+    throw std::invalid_argument("Number of neighbors must be positive.");
+
+  mMaxNumNeighbors = _maxNumNeighbors;
+}
+
+//==============================================================================
+unsigned int LazySP::getMaxNumNeighbors() const
+{
+  return mMaxNumNeighbors;
+}
+
+//==============================================================================
+std::size_t LazySP::getNumVertices() const
+{
+  return mVertices.size() - mFreeVertices.size();
+}
+
+//==============================================================================
+std::size_t LazySP::getNumEdges() const
+{
+  return mEdges.size() - mFreeEdges.size();
+}
+
+//==============================================================================
+std::size_t LazySP::getNumEvaluations() const
+{
+  return mNumEvaluations;
+}
+
+//==============================================================================
+void LazySP::resetValidity()
+{
+  for (auto& vertex : mVertices)
+  {
+    vertex.mStatus = Status::UNKNOWN;
+    vertex.mNumInvalidNeighbors = 0;
+  }
+
+  for (auto& edge : mEdges)
+    edge.mStatus = Status::UNKNOWN;
+
+  // PlannerInputStates only returns valid start and goal states.
+  for (const auto index : mStartVertices)
+    mVertices[index].mStatus = Status::VALID;
+
+  for (const auto index : mGoalVertices)
+    mVertices[index].mStatus = Status::VALID;
+}
+
+//==============================================================================
+void LazySP::saveRoadmap(std::ostream& _stream) const
+{
+  auto sspace = getGeometricStateSpace();
+  auto aikidoSpace = sspace->getAikidoStateSpace();
+
+  writeValue(_stream, ROADMAP_MAGIC);
+  writeValue(_stream, ROADMAP_VERSION);
+  writeValue<std::uint64_t>(_stream, aikidoSpace->getDimension());
+
+  // Removed query vertices leave unused vertices and edges behind, so the
+  // others are renumbered.
+  std::vector<std::size_t> indices(mVertices.size(), NO_VERTEX);
+  std::size_t numVertices = 0;
+  for (std::size_t i = 0; i < mVertices.size(); ++i)
+  {
+    if (mVertices[i].mState)
+      indices[i] = numVertices++;
+  }
+
+  Eigen::VectorXd tangent;
+  writeValue<std::uint64_t>(_stream, numVertices);
+  for (const auto& vertex : mVertices)
+  {
+    if (!vertex.mState)
+      continue;
+
+    aikidoSpace->logMap(
+        vertex.mState->as<GeometricStateSpace::StateType>()->mState, tangent);
+    writeValue(_stream, static_cast<std::uint8_t>(vertex.mStatus));
+    _stream.write(
+        reinterpret_cast<const char*>(tangent.data()),
+        tangent.size() * sizeof(double));
+  }
+
+  writeValue<std::uint64_t>(_stream, getNumEdges());
+  for (const auto& edge : mEdges)
+  {
+    if (edge.mSource == NO_VERTEX)
+      continue;
+
+    writeValue<std::uint64_t>(_stream, indices[edge.mSource]);
+    writeValue<std::uint64_t>(_stream, indices[edge.mTarget]);
+    writeValue(_stream, edge.mLength);
+    writeValue(_stream, static_cast<std::uint8_t>(edge.mStatus));
+  }
+
+  if (!_stream)
+    throw std::runtime_error("Failed to write roadmap.");
+}
+
+//==============================================================================
+void LazySP::loadRoadmap(std::istream& _stream)
+{
+  auto sspace = getGeometricStateSpace();
+  auto aikidoSpace = sspace->getAikidoStateSpace();
+
+  clear();
+  setupNearestNeighbors();
+
+  const auto readStatus = [&_stream]() {
+    const auto status = readValue<std::uint8_t>(_stream);
+    if (status > static_cast<std::uint8_t>(Status::INVALID))
+      throw std::runtime_error("Invalid status in roadmap.");
+    return static_cast<Status>(status);
+  };
+
+  try
+  {
+    if (readValue<std::uint32_t>(_stream) != ROADMAP_MAGIC)
+      throw std::runtime_error("Stream does not contain a roadmap.");
+
+    if (readValue<std::uint32_t>(_stream) != ROADMAP_VERSION)
+      throw std::runtime_error("Unsupported roadmap version.");
+
+    const auto dimension = readValue<std::uint64_t>(_stream);
+    if (dimension != aikidoSpace->getDimension())
+      throw std::runtime_error("Roadmap does not match StateSpace.");
+
+    // The counts are only trusted once they are checked against the size of
+    // the stream, so nothing is reserved up front.
+    Eigen::VectorXd tangent(dimension);
+    const auto numVertices = readCount(
+        _stream, sizeof(std::uint8_t) + dimension * sizeof(double));
+    for (std::uint64_t i = 0; i < numVertices; ++i)
+    {
+      Vertex vertex;
+      vertex.mStatus = readStatus();
+      vertex.mNumInvalidNeighbors = 0;
+      if (!_stream.read(
+              reinterpret_cast<char*>(tangent.data()),
+              dimension * sizeof(double)))
+        throw std::runtime_error("Unexpected end of roadmap.");
+
+      if (!tangent.allFinite())
+        throw std::runtime_error("Invalid vertex in roadmap.");
+
+      vertex.mState = si_->allocState();
+      mVertices.emplace_back(std::move(vertex));
+      aikidoSpace->expMap(
+          tangent,
+          mVertices.back()
+              .mState->as<GeometricStateSpace::StateType>()
+              ->mState);
+      mNearestNeighbors->add(mVertices.size() - 1);
+    }
+
+    const auto numEdges = readCount(
+        _stream,
+        2 * sizeof(std::uint64_t) + sizeof(double) + sizeof(std::uint8_t));
+    for (std::uint64_t i = 0; i < numEdges; ++i)
+    {
+      Edge edge;
+      edge.mSource = readValue<std::uint64_t>(_stream);
+      edge.mTarget = readValue<std::uint64_t>(_stream);
+      edge.mLength = readValue<double>(_stream);
+      edge.mStatus = readStatus();
+      if (edge.mSource >= mVertices.size() || edge.mTarget >= mVertices.size()
+          || !std::isfinite(edge.mLength) || edge.mLength < 0.)
+        throw std::runtime_error("Invalid edge in roadmap.");
+
+      mVertices[edge.mSource].mEdges.emplace_back(mEdges.size());
+      mVertices[edge.mTarget].mEdges.emplace_back(mEdges.size());
+      mEdges.emplace_back(edge);
+    }
+  }
+  catch (const std::runtime_error&)
+  {
+    clear();
+    throw;
+  }
+  catch (const std::exception& e)
+  {
+    clear();
+    throw std::runtime_error(
+        std::string("Failed to load roadmap: ") + e.what());
+  }
+
+  for (std::size_t i = 0; i < mVertices.size(); ++i)
+  {
+    if (mVertices[i].mStatus == Status::INVALID)
+      invalidateVertex(i);
+  }
+
+  for (std::size_t i = 0; i < mEdges.size(); ++i)
+  {
+    if (mEdges[i].mStatus == Status::INVALID)
+      invalidateEdge(i);
+  }
+}
+
+//==============================================================================
+void LazySP::setup()
+{
+  // A planner that is reused for several queries is set up for each of them.
+  if (!isSetup())
+    ::ompl::base::Planner::setup();
+  setupNearestNeighbors();
+}
+
+//==============================================================================
+void LazySP::setupNearestNeighbors()
+{
+  if (!mNearestNeighbors)
+    mNearestNeighbors.reset(new ::ompl::NearestNeighborsGNAT<std::size_t>);
+
+  mNearestNeighbors->setDistanceFunction(
+      ompl_bind(
+          &LazySP::distanceFunction,
+          this,
+          OMPL_PLACEHOLDER(_1),
+          OMPL_PLACEHOLDER(_2)));
+}
+
+//==============================================================================
+ompl_shared_ptr<GeometricStateSpace> LazySP::getGeometricStateSpace() const
+{
+  auto sspace
+      = ompl_dynamic_pointer_cast<GeometricStateSpace>(si_->getStateSpace());
+  if (!sspace)
+  {
+    throw std::invalid_argument(
+        "Saving and loading a roadmap requires a GeometricStateSpace");
+  }
+  return sspace;
+}
+
+//==============================================================================
+void LazySP::freeMemory()
+{
+  for (auto& vertex : mVertices)
+  {
+    if (vertex.mState)
+    {
+      si_->freeState(vertex.mState);
+      vertex.mState = nullptr;
+    }
+  }
+}
+
+//==============================================================================
+double LazySP::distanceFunction(std::size_t _a, std::size_t _b) const
+{
+  return si_->distance(mVertices[_a].mState, mVertices[_b].mState);
+}
+
+//==============================================================================
+std::size_t LazySP::addVertex(
+    const ::ompl::base::State* _state, Status _status)
+{
+  const auto index = createVertex(_state, _status);
+
+  std::vector<std::size_t> neighbors;
+  if (mNearestNeighbors->size() > 0)
+    mNearestNeighbors->nearestK(index, mMaxNumNeighbors, neighbors);
+  mNearestNeighbors->add(index);
+
+  connectVertex(index, neighbors);
+  return index;
+}
+
+//==============================================================================
+std::size_t LazySP::addQueryVertex(const ::ompl::base::State* _state)
+{
+  // PlannerInputStates only returns valid start and goal states.
+  const auto index = createVertex(_state, Status::VALID);
+
+  // The vertex is not added to mNearestNeighbors, so that it can be removed
+  // from the roadmap when the query is cleared.
+  std::vector<std::size_t> neighbors;
+  if (mNearestNeighbors->size() > 0)
+    mNearestNeighbors->nearestK(index, mMaxNumNeighbors, neighbors);
+
+  connectVertex(index, neighbors);
+  return index;
+}
+
+//==============================================================================
+void LazySP::removeQueryVertex(std::size_t _index)
+{
+  auto& vertex = mVertices[_index];
+  for (const auto edgeIndex : vertex.mEdges)
+  {
+    auto& edge = mEdges[edgeIndex];
+    auto& neighbor
+        = mVertices[edge.mSource == _index ? edge.mTarget : edge.mSource];
+    neighbor.mEdges.erase(
+        std::remove(neighbor.mEdges.begin(), neighbor.mEdges.end(), edgeIndex),
+        neighbor.mEdges.end());
+
+    // Query vertices are valid, so only their invalid edges are counted.
+    if (edge.mStatus == Status::INVALID)
+      --neighbor.mNumInvalidNeighbors;
+
+    edge.mSource = NO_VERTEX;
+    edge.mTarget = NO_VERTEX;
+    mFreeEdges.emplace_back(edgeIndex);
+  }
+
+  vertex.mEdges.clear();
+  si_->freeState(vertex.mState);
+  vertex.mState = nullptr;
+  mFreeVertices.emplace_back(_index);
+}
+
+//==============================================================================
+std::size_t LazySP::createVertex(
+    const ::ompl::base::State* _state, Status _status)
+{
+  std::size_t index;
+  if (mFreeVertices.empty())
+  {
+    index = mVertices.size();
+    mVertices.emplace_back();
+  }
+  else
+  {
+    index = mFreeVertices.back();
+    mFreeVertices.pop_back();
+  }
+
+  auto& vertex = mVertices[index];
+  vertex.mState = si_->allocState();
+  si_->copyState(vertex.mState, _state);
+  vertex.mStatus = _status;
+  vertex.mEdges.clear();
+  vertex.mNumInvalidNeighbors = 0;
+  return index;
+}
+
+//==============================================================================
+void LazySP::connectVertex(
+    std::size_t _index, std::vector<std::size_t> _neighbors)
+{
+  // Query vertices are not in mNearestNeighbors, so connect the vertex to
+  // those that are as close as its farthest neighbor as well.
+  double radius = std::numeric_limits<double>::infinity();
+  if (_neighbors.size() >= mMaxNumNeighbors)
+  {
+    radius = 0.;
+    for (const auto neighbor : _neighbors)
+      radius = std::max(radius, distanceFunction(neighbor, _index));
+  }
+
+  for (const auto queryVertices : {&mStartVertices, &mGoalVertices})
+  {
+    for (const auto queryVertex : *queryVertices)
+    {
+      if (distanceFunction(queryVertex, _index) <= radius)
+        _neighbors.emplace_back(queryVertex);
+    }
+  }
+
+  // The vertex is connected lazily, without checking the edges.
+  for (const auto neighbor : _neighbors)
+  {
+    Edge edge;
+    edge.mSource = neighbor;
+    edge.mTarget = _index;
+    edge.mLength = distanceFunction(neighbor, _index);
+    edge.mStatus = Status::UNKNOWN;
+
+    std::size_t edgeIndex;
+    if (mFreeEdges.empty())
+    {
+      edgeIndex = mEdges.size();
+      mEdges.emplace_back(edge);
+    }
+    else
+    {
+      edgeIndex = mFreeEdges.back();
+      mFreeEdges.pop_back();
+      mEdges[edgeIndex] = edge;
+    }
+
+    mVertices[neighbor].mEdges.emplace_back(edgeIndex);
+    mVertices[_index].mEdges.emplace_back(edgeIndex);
+  }
+}
+
+//==============================================================================
+void LazySP::growRoadmap(const ::ompl::base::PlannerTerminationCondition& _ptc)
+{
+  auto state = si_->allocState();
+  for (unsigned int i = 0; i < mBatchSize && _ptc == false; ++i)
+  {
+    mSampler->sampleUniform(state);
+    addVertex(state, Status::UNKNOWN);
+  }
+  si_->freeState(state);
+}
+
+//==============================================================================
+bool LazySP::findShortestPath(std::vector<std::size_t>& _path) const
+{
+  const auto infinity = std::numeric_limits<double>::infinity();
+
+  std::vector<bool> isGoal(mVertices.size(), false);
+  for (const auto index : mGoalVertices)
+    isGoal[index] = true;
+
+  // The distance to the nearest goal is an admissible heuristic, since
+  // si_->distance satisfies the triangle inequality.
+  const auto heuristic = [&](std::size_t index) {
+    double distance = infinity;
+    for (const auto goal : mGoalVertices)
+      distance = std::min(distance, distanceFunction(index, goal));
+    return distance;
+  };
+
+  using QueueEntry = std::pair<double, std::size_t>;
+  std::priority_queue<
+      QueueEntry,
+      std::vector<QueueEntry>,
+      std::greater<QueueEntry>>
+      queue;
+
+  std::vector<double> costs(mVertices.size(), infinity);
+  std::vector<std::size_t> parents(mVertices.size(), NO_VERTEX);
+  std::vector<bool> closed(mVertices.size(), false);
+
+  for (const auto index : mStartVertices)
+  {
+    costs[index] = 0.;
+    queue.emplace(heuristic(index), index);
+  }
+
+  std::size_t goalVertex = NO_VERTEX;
+  while (!queue.empty())
+  {
+    const auto index = queue.top().second;
+    queue.pop();
+
+    if (closed[index])
+      continue;
+    closed[index] = true;
+
+    if (isGoal[index])
+    {
+      goalVertex = index;
+      break;
+    }
+
+    for (const auto edgeIndex : mVertices[index].mEdges)
+    {
+      const auto& edge = mEdges[edgeIndex];
+      if (edge.mStatus == Status::INVALID)
+        continue;
+
+      const auto neighbor
+          = edge.mSource == index ? edge.mTarget : edge.mSource;
+      if (closed[neighbor] || mVertices[neighbor].mStatus == Status::INVALID)
+        continue;
+
+      const auto cost = costs[index] + edge.mLength;
+      if (cost < costs[neighbor])
+      {
+        costs[neighbor] = cost;
+        parents[neighbor] = index;
+        queue.emplace(cost + heuristic(neighbor), neighbor);
+      }
+    }
+  }
+
+  _path.clear();
+  if (goalVertex == NO_VERTEX)
+    return false;
+
+  for (auto index = goalVertex; index != NO_VERTEX; index = parents[index])
+    _path.emplace_back(index);
+  std::reverse(_path.begin(), _path.end());
+  return true;
+}
+
+//==============================================================================
+bool LazySP::evaluatePath(
+    const std::vector<std::size_t>& _path,
+    const ::ompl::base::PlannerTerminationCondition& _ptc)
+{
+  // Checking a vertex is cheaper than checking an edge, and an invalid vertex
+  // invalidates all of its edges.
+  for (const auto index : _path)
+  {
+    auto& vertex = mVertices[index];
+    if (vertex.mStatus != Status::UNKNOWN)
+      continue;
+
+    if (_ptc == true)
+      return false;
+
+    ++mNumEvaluations;
+    if (!si_->isValid(vertex.mState))
+    {
+      invalidateVertex(index);
+      return false;
+    }
+    vertex.mStatus = Status::VALID;
+  }
+
+  // Check the edges that are most likely to be invalid first, estimating the
+  // probability of an edge being invalid from its length and the number of
+  // invalid vertices and edges around it.
+  std::vector<std::pair<double, std::size_t>> edges;
+  for (std::size_t i = 0; i + 1 < _path.size(); ++i)
+  {
+    const auto edgeIndex = findEdge(_path[i], _path[i + 1]);
+    const auto& edge = mEdges[edgeIndex];
+    if (edge.mStatus != Status::UNKNOWN)
+      continue;
+
+    const auto numInvalidNeighbors
+        = mVertices[edge.mSource].mNumInvalidNeighbors
+          + mVertices[edge.mTarget].mNumInvalidNeighbors;
+    edges.emplace_back(edge.mLength * (1. + numInvalidNeighbors), edgeIndex);
+  }
+  std::sort(
+      edges.begin(),
+      edges.end(),
+      std::greater<std::pair<double, std::size_t>>());
+
+  for (const auto& entry : edges)
+  {
+    if (_ptc == true)
+      return false;
+
+    auto& edge = mEdges[entry.second];
+    ++mNumEvaluations;
+    if (!si_->checkMotion(
+            mVertices[edge.mSource].mState, mVertices[edge.mTarget].mState))
+    {
+      invalidateEdge(entry.second);
+      return false;
+    }
+    edge.mStatus = Status::VALID;
+  }
+
+  return true;
+}
+
+//==============================================================================
+std::size_t LazySP::findEdge(std::size_t _source, std::size_t _target) const
+{
+  for (const auto edgeIndex : mVertices[_source].mEdges)
+  {
+    const auto& edge = mEdges[edgeIndex];
+    if (edge.mSource == _target || edge.mTarget == _target)
+      return edgeIndex;
+  }
+
+  throw std::logic_error("Vertices are not adjacent.");
+}
+
+//==============================================================================
+void LazySP::invalidateVertex(std::size_t _index)
+{
+  auto& vertex = mVertices[_index];
+  vertex.mStatus = Status::INVALID;
+
+  for (const auto edgeIndex : vertex.mEdges)
+  {
+    const auto& edge = mEdges[edgeIndex];
+    const auto neighbor = edge.mSource == _index ? edge.mTarget : edge.mSource;
+    ++mVertices[neighbor].mNumInvalidNeighbors;
+  }
+}
+
+//==============================================================================
+void LazySP::invalidateEdge(std::size_t _index)
+{
+  auto& edge = mEdges[_index];
+  edge.mStatus = Status::INVALID;
+  ++mVertices[edge.mSource].mNumInvalidNeighbors;
+  ++mVertices[edge.mTarget].mNumInvalidNeighbors;
+}
+
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
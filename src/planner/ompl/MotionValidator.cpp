@@ -1,17 +1,261 @@
 #include <aikido/planner/ompl/MotionValidator.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <ompl/base/SpaceInformation.h>
 #include <aikido/common/StepSequence.hpp>
 #include <aikido/common/VanDerCorput.hpp>
+#include <aikido/planner/ompl/GeometricStateSpace.hpp>
+#include <aikido/planner/ompl/StateValidityChecker.hpp>
 
 namespace aikido {
 namespace planner {
 namespace ompl {
+
+namespace {
+
+//==============================================================================
+/// Interpolates along a segment. If the segment lies in a
+/// \c GeometricStateSpace, the work that only depends on its end points is
+/// done once, by \c GeometricStateSpace::prepareEdge.
+class SegmentInterpolator
+{
+public:
+  SegmentInterpolator(
+      const ::ompl::base::StateSpacePtr& _stateSpace,
+      const ::ompl::base::State* _s1,
+      const ::ompl::base::State* _s2)
+    : mStateSpace(_stateSpace), mS1(_s1), mS2(_s2)
+  {
+    const auto geometricSpace
+        = dynamic_cast<const GeometricStateSpace*>(mStateSpace.get());
+    if (geometricSpace)
+      mEdge = geometricSpace->prepareEdge(mS1, mS2);
+  }
+
+  void interpolate(double _t, ::ompl::base::State* _state)
+  {
+    if (mEdge)
+    {
+      mEdge->interpolate(
+          _t, static_cast<GeometricStateSpace::StateType*>(_state)->mState);
+    }
+    else
+    {
+      mStateSpace->interpolate(mS1, mS2, _t, _state);
+    }
+  }
+
+private:
+  const ::ompl::base::StateSpacePtr& mStateSpace;
+  const ::ompl::base::State* mS1;
+  const ::ompl::base::State* mS2;
+  std::unique_ptr<statespace::Interpolator::Edge> mEdge;
+};
+
+} // namespace
+
+//==============================================================================
+/// Persistent worker threads that split the samples along a segment between
+/// them. Worker \c i tests every (numWorkers + 1)-th sample, starting from
+/// sample i + 1, with its own constraint and scratch state; the calling thread
+/// takes the samples starting from sample 0. Since the samples come from a Van
+/// der Corput sequence, every worker sweeps the whole segment coarse-to-fine.
+class MotionValidator::WorkerPool
+{
+public:
+  WorkerPool(
+      ::ompl::base::StateSpacePtr stateSpace,
+      std::vector<constraint::TestablePtr> constraints)
+    : mStateSpace(std::move(stateSpace))
+    , mConstraints(std::move(constraints))
+    , mStop(false)
+    , mJobId(0u)
+    , mNumPending(0u)
+    , mS1(nullptr)
+    , mS2(nullptr)
+    , mSamples(nullptr)
+    , mFailed(false)
+  {
+    mCallerState = mStateSpace->allocState();
+    mWorkerStates.reserve(mConstraints.size());
+    for (std::size_t i = 0; i < mConstraints.size(); ++i)
+      mWorkerStates.emplace_back(mStateSpace->allocState());
+
+    mThreads.reserve(mConstraints.size());
+    for (std::size_t i = 0; i < mConstraints.size(); ++i)
+      mThreads.emplace_back(&WorkerPool::runWorker, this, i);
+  }
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mWorkAvailable.notify_all();
+
+    for (auto& thread : mThreads)
+      thread.join();
+
+    for (auto state : mWorkerStates)
+      mStateSpace->freeState(state);
+    mStateSpace->freeState(mCallerState);
+  }
+
+  std::size_t getNumWorkers() const
+  {
+    return mThreads.size();
+  }
+
+  /// Returns true if all samples in \c samples are valid. The share of the
+  /// calling thread is tested with \c si.
+  bool check(
+      const ::ompl::base::SpaceInformation* si,
+      const ::ompl::base::State* s1,
+      const ::ompl::base::State* s2,
+      const std::vector<double>& samples)
+  {
+    // Only one segment can be checked at a time.
+    std::lock_guard<std::mutex> jobLock(mJobMutex);
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mS1 = s1;
+      mS2 = s2;
+      mSamples = &samples;
+      mFailed.store(false);
+      mException = nullptr;
+      mNumPending = mThreads.size();
+      ++mJobId;
+    }
+    mWorkAvailable.notify_all();
+
+    // The workers read samples, s1 and s2, so wait for them even if the
+    // calling thread's share throws.
+    try
+    {
+      checkShare(0u, mCallerState, [si](const ::ompl::base::State* state) {
+        return si->isValid(state);
+      });
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mFailed.store(true);
+      if (!mException)
+        mException = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWorkDone.wait(lock, [this]() { return mNumPending == 0u; });
+
+    if (mException)
+      std::rethrow_exception(mException);
+
+    return !mFailed.load();
+  }
+
+private:
+  void runWorker(std::size_t index)
+  {
+    const auto& constraint = mConstraints[index];
+    auto validityFn = [&constraint](const ::ompl::base::State* state) {
+      auto st = static_cast<const GeometricStateSpace::StateType*>(state);
+      return st->mValid && constraint->isSatisfied(st->mState);
+    };
+
+    std::size_t lastJobId = 0u;
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWorkAvailable.wait(
+            lock, [this, lastJobId]() { return mStop || mJobId != lastJobId; });
+
+        if (mStop)
+          return;
+
+        lastJobId = mJobId;
+      }
+
+      try
+      {
+        checkShare(index + 1, mWorkerStates[index], validityFn);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFailed.store(true);
+        if (!mException)
+          mException = std::current_exception();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mNumPending == 0u)
+          mWorkDone.notify_all();
+      }
+    }
+  }
+
+  template <typename ValidityFn>
+  void checkShare(
+      std::size_t offset,
+      ::ompl::base::State* state,
+      const ValidityFn& isValid)
+  {
+    const auto stride = mThreads.size() + 1;
+    const auto& samples = *mSamples;
+    SegmentInterpolator interpolator(mStateSpace, mS1, mS2);
+
+    for (std::size_t i = offset; i < samples.size(); i += stride)
+    {
+      if (mFailed.load(std::memory_order_relaxed))
+        return;
+
+      interpolator.interpolate(samples[i], state);
+      if (!isValid(state))
+      {
+        mFailed.store(true);
+        return;
+      }
+    }
+  }
+
+  ::ompl::base::StateSpacePtr mStateSpace;
+  std::vector<constraint::TestablePtr> mConstraints;
+  std::vector<::ompl::base::State*> mWorkerStates;
+  ::ompl::base::State* mCallerState;
+  std::vector<std::thread> mThreads;
+
+  std::mutex mJobMutex;
+  std::mutex mMutex;
+  std::condition_variable mWorkAvailable;
+  std::condition_variable mWorkDone;
+
+  // The following are protected by mMutex.
+  bool mStop;
+  std::size_t mJobId;
+  std::size_t mNumPending;
+  const ::ompl::base::State* mS1;
+  const ::ompl::base::State* mS2;
+  const std::vector<double>* mSamples;
+  std::exception_ptr mException;
+
+  std::atomic<bool> mFailed;
+};
+
+//==============================================================================
 MotionValidator::MotionValidator(
     const ::ompl::base::SpaceInformationPtr& _si,
     double _maxDistBtwValidityChecks)
   : ::ompl::base::MotionValidator(_si)
   , mSequenceResolution(_maxDistBtwValidityChecks)
+  , mStateSpace(_si ? _si->getStateSpace() : nullptr)
 {
   if (_si == nullptr)
   {
@@ -25,6 +269,40 @@ MotionValidator::MotionValidator(
   }
 }
 
+//==============================================================================
+MotionValidator::MotionValidator(
+    const ::ompl::base::SpaceInformationPtr& _si,
+    double _maxDistBtwValidityChecks,
+    std::vector<constraint::TestablePtr> _workerConstraints)
+  : MotionValidator(_si, _maxDistBtwValidityChecks)
+{
+  for (const auto& constraint : _workerConstraints)
+  {
+    if (constraint == nullptr)
+      throw std::invalid_argument("Worker constraint is nullptr.");
+  }
+
+  if (!_workerConstraints.empty())
+  {
+    mWorkerPool.reset(
+        new WorkerPool(_si->getStateSpace(), std::move(_workerConstraints)));
+  }
+}
+
+//==============================================================================
+MotionValidator::~MotionValidator()
+{
+  for (auto state : mBatchStates)
+    mStateSpace->freeState(state);
+}
+
+//==============================================================================
+std::size_t MotionValidator::getNumWorkers() const
+{
+  return mWorkerPool ? mWorkerPool->getNumWorkers() : 0u;
+}
+
+//==============================================================================
 bool MotionValidator::checkMotion(
     const ::ompl::base::State* _s1, const ::ompl::base::State* _s2) const
 {
@@ -34,13 +312,34 @@ bool MotionValidator::checkMotion(
                                    true, // include endpoints
                                    mSequenceResolution / dist};
 
+  if (mWorkerPool)
+  {
+    const std::vector<double> samples(vdc.begin(), vdc.end());
+
+    // Short segments are not worth the synchronization overhead.
+    if (samples.size() >= 2 * (mWorkerPool->getNumWorkers() + 1))
+      return mWorkerPool->check(si_, _s1, _s2, samples);
+  }
+
   auto stateSpace = si_->getStateSpace();
+
+  const auto validityChecker = dynamic_cast<const StateValidityChecker*>(
+      si_->getStateValidityChecker().get());
+  if (validityChecker
+      && dynamic_cast<const GeometricStateSpace*>(stateSpace.get()))
+  {
+    const std::vector<double> samples(vdc.begin(), vdc.end());
+    return checkMotionBatch(
+        _s1, _s2, samples, *validityChecker->getConstraint());
+  }
+
   auto iState = stateSpace->allocState();
+  SegmentInterpolator interpolator(stateSpace, _s1, _s2);
 
   bool valid = true;
   for (double t : vdc)
   {
-    stateSpace->interpolate(_s1, _s2, t, iState);
+    interpolator.interpolate(t, iState);
     if (!si_->isValid(iState))
     {
       valid = false;
@@ -51,6 +350,7 @@ bool MotionValidator::checkMotion(
   return valid;
 }
 
+//==============================================================================
 bool MotionValidator::checkMotion(
     const ::ompl::base::State* _s1,
     const ::ompl::base::State* _s2,
@@ -65,12 +365,13 @@ bool MotionValidator::checkMotion(
 
   auto stateSpace = si_->getStateSpace();
   auto iState = stateSpace->allocState();
+  SegmentInterpolator interpolator(stateSpace, _s1, _s2);
 
   bool valid = true;
   double lastValidTime = 0.0;
   for (double t : seq)
   {
-    stateSpace->interpolate(_s1, _s2, t, iState);
+    interpolator.interpolate(t, iState);
     if (!si_->isValid(iState))
     {
       valid = false;
@@ -89,6 +390,39 @@ bool MotionValidator::checkMotion(
 
   return valid;
 }
+
+//==============================================================================
+bool MotionValidator::checkMotionBatch(
+    const ::ompl::base::State* _s1,
+    const ::ompl::base::State* _s2,
+    const std::vector<double>& _samples,
+    const constraint::Testable& _constraint) const
+{
+  std::lock_guard<std::mutex> lock(mBatchMutex);
+
+  while (mBatchStates.size() < _samples.size())
+    mBatchStates.emplace_back(mStateSpace->allocState());
+
+  std::vector<const statespace::StateSpace::State*> states;
+  states.reserve(_samples.size());
+
+  SegmentInterpolator interpolator(mStateSpace, _s1, _s2);
+  for (std::size_t i = 0; i < _samples.size(); ++i)
+  {
+    interpolator.interpolate(_samples[i], mBatchStates[i]);
+
+    auto st = static_cast<const GeometricStateSpace::StateType*>(
+        mBatchStates[i]);
+    if (!st->mValid)
+      return false;
+
+    states.emplace_back(st->mState);
+  }
+
+  std::vector<bool> results;
+  return _constraint.isSatisfiedBatch(states, results);
 }
-}
-}
+
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
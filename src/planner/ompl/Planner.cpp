@@ -20,7 +20,8 @@ namespace ompl {
     constraint::TestablePtr _validityConstraint,
     constraint::TestablePtr _boundsConstraint,
     constraint::ProjectablePtr _boundsProjector,
-    double _maxDistanceBtwValidityChecks)
+    double _maxDistanceBtwValidityChecks,
+    std::vector<constraint::TestablePtr> _workerValidityConstraints)
 {
   if (_stateSpace == nullptr)
   {
@@ -98,6 +99,22 @@ namespace ompl {
         "StateSpace of BoundsProjector not equal to planning StateSpace");
   }
 
+  // Ensure worker constraints and state space match
+  for (const auto& workerConstraint : _workerValidityConstraints)
+  {
+    if (workerConstraint == nullptr)
+    {
+      throw std::invalid_argument("Worker ValidityConstraint is nullptr.");
+    }
+
+    if (_stateSpace != workerConstraint->getStateSpace())
+    {
+      throw std::invalid_argument(
+          "StateSpace of worker ValidityConstraint not equal to planning "
+          "StateSpace");
+    }
+  }
+
   // Ensure max distance between validity checks is positive
   if (_maxDistanceBtwValidityChecks <= 0.0)
   {
@@ -117,6 +134,18 @@ namespace ompl {
   // Space Information
   auto si = ompl_make_shared<::ompl::base::SpaceInformation>(std::move(sspace));
 
+  // Validity checking for each parallel edge checking worker
+  std::vector<constraint::TestablePtr> workerConstraints;
+  workerConstraints.reserve(_workerValidityConstraints.size());
+  for (auto& workerConstraint : _workerValidityConstraints)
+  {
+    std::vector<constraint::TestablePtr> constraints{
+        std::move(workerConstraint), _boundsConstraint};
+    workerConstraints.emplace_back(
+        std::make_shared<constraint::TestableIntersection>(
+            _stateSpace, std::move(constraints)));
+  }
+
   // Validity checking
   std::vector<constraint::TestablePtr> constraints{
       std::move(_validityConstraint), std::move(_boundsConstraint)};
@@ -128,7 +157,8 @@ namespace ompl {
   si->setStateValidityChecker(vchecker);
 
   ::ompl::base::MotionValidatorPtr mvalidator
-      = ompl_make_shared<MotionValidator>(si, _maxDistanceBtwValidityChecks);
+      = ompl_make_shared<MotionValidator>(
+          si, _maxDistanceBtwValidityChecks, std::move(workerConstraints));
   si->setMotionValidator(mvalidator);
 
   return si;
@@ -167,10 +197,26 @@ trajectory::InterpolatedPtr planOMPL(
     statespace::StateSpacePtr _sspace,
     statespace::InterpolatorPtr _interpolator,
     double _maxPlanTime)
+{
+  return planOMPL(
+      _planner,
+      _pdef,
+      std::move(_sspace),
+      std::move(_interpolator),
+      ::ompl::base::timedPlannerTerminationCondition(_maxPlanTime));
+}
+
+//==============================================================================
+trajectory::InterpolatedPtr planOMPL(
+    const ::ompl::base::PlannerPtr& _planner,
+    const ::ompl::base::ProblemDefinitionPtr& _pdef,
+    statespace::StateSpacePtr _sspace,
+    statespace::InterpolatorPtr _interpolator,
+    const ::ompl::base::PlannerTerminationCondition& _terminationCondition)
 {
   _planner->setProblemDefinition(_pdef);
   _planner->setup();
-  auto solved = _planner->solve(_maxPlanTime);
+  auto solved = _planner->solve(_terminationCondition);
 
   if (solved)
   {
@@ -187,6 +233,7 @@ trajectory::InterpolatedPtr planOMPL(
           "Trajectory");
     }
 
+    returnTraj->reserve(path->getStateCount());
     for (std::size_t idx = 0; idx < path->getStateCount(); ++idx)
     {
       const auto* st
@@ -478,6 +525,7 @@ std::unique_ptr<trajectory::Interpolated> toInterpolatedTrajectory(
 {
   auto returnInterpolated = dart::common::make_unique<trajectory::Interpolated>(
       _interpolator->getStateSpace(), std::move(_interpolator));
+  returnInterpolated->reserve(_path.getStateCount());
 
   for (std::size_t idx = 0; idx < _path.getStateCount(); ++idx)
   {
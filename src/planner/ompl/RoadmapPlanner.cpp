@@ -0,0 +1,292 @@
+#include <aikido/planner/ompl/RoadmapPlanner.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <aikido/constraint/dart/JointStateSpaceHelpers.hpp>
+#include <aikido/distance/defaults.hpp>
+#include <aikido/planner/ompl/Planner.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/dart/MetaSkeletonStateSaver.hpp>
+#include "detail/BinaryStream.hpp"
+
+namespace aikido {
+namespace planner {
+namespace ompl {
+
+using ::dart::dynamics::INVALID_INDEX;
+using detail::readArray;
+using detail::readCount;
+using detail::readValue;
+using detail::writeValue;
+
+namespace {
+
+/// Identifies the format written by RoadmapPlanner::saveRoadmap.
+constexpr std::uint32_t ROADMAP_PLANNER_MAGIC = 0x524d504c;
+constexpr std::uint32_t ROADMAP_PLANNER_VERSION = 1;
+
+//==============================================================================
+template <typename Configuration>
+bool isSameConfiguration(const Configuration& a, const Configuration& b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (auto itA = a.begin(), itB = b.begin(); itA != a.end(); ++itA, ++itB)
+  {
+    if (itA->first != itB->first || itA->second.size() != itB->second.size()
+        || itA->second != itB->second)
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+//==============================================================================
+RoadmapPlanner::RoadmapPlanner(
+    statespace::dart::MetaSkeletonStateSpacePtr _stateSpace,
+    ::dart::dynamics::MetaSkeletonPtr _metaSkeleton,
+    WorldPtr _world,
+    constraint::TestablePtr _collisionTestable,
+    std::unique_ptr<common::RNG> _rng,
+    double _maxDistanceBtwValidityChecks)
+  : mStateSpace(std::move(_stateSpace))
+  , mMetaSkeleton(std::move(_metaSkeleton))
+  , mWorld(std::move(_world))
+  , mCollisionTestable(std::move(_collisionTestable))
+{
+  if (!mStateSpace)
+    throw std::invalid_argument("StateSpace is nullptr.");
+
+  if (!mMetaSkeleton)
+    throw std::invalid_argument("MetaSkeleton is nullptr.");
+
+  if (!mWorld)
+    throw std::invalid_argument("World is nullptr.");
+
+  if (!_rng)
+    throw std::invalid_argument("RNG is nullptr.");
+
+  mInterpolator
+      = std::make_shared<statespace::GeodesicInterpolator>(mStateSpace);
+
+  mSpaceInformation = getSpaceInformation(
+      mStateSpace,
+      mInterpolator,
+      distance::createDistanceMetric(mStateSpace),
+      constraint::dart::createSampleableBounds(mStateSpace, std::move(_rng)),
+      mCollisionTestable,
+      constraint::dart::createTestableBounds(mStateSpace),
+      constraint::dart::createProjectableBounds(mStateSpace),
+      _maxDistanceBtwValidityChecks);
+
+  mPlanner = ompl_make_shared<LazySP>(mSpaceInformation);
+  mWorldConfiguration = getWorldConfiguration();
+}
+
+//==============================================================================
+trajectory::InterpolatedPtr RoadmapPlanner::plan(
+    const statespace::StateSpace::State* _start,
+    const statespace::StateSpace::State* _goal,
+    double _maxPlanTime)
+{
+  auto robot = mMetaSkeleton->getBodyNode(0)->getSkeleton();
+  std::lock_guard<std::mutex> lock(robot->getMutex());
+  // Save the current state of the space
+  auto saver = statespace::dart::MetaSkeletonStateSaver(mMetaSkeleton);
+  DART_UNUSED(saver);
+
+  updateValidity();
+
+  auto pdef = ompl_make_shared<::ompl::base::ProblemDefinition>(
+      mSpaceInformation);
+  auto sspace = ompl_static_pointer_cast<GeometricStateSpace>(
+      mSpaceInformation->getStateSpace());
+  auto start = sspace->allocState(_start);
+  auto goal = sspace->allocState(_goal);
+
+  // ProblemDefinition clones states and keeps them internally
+  pdef->setStartAndGoalStates(start, goal);
+
+  sspace->freeState(start);
+  sspace->freeState(goal);
+
+  auto trajectory
+      = planOMPL(mPlanner, pdef, mStateSpace, mInterpolator, _maxPlanTime);
+
+  // Only keep the states sampled for the roadmap.
+  mPlanner->clearQuery();
+  return trajectory;
+}
+
+//==============================================================================
+void RoadmapPlanner::invalidate()
+{
+  mPlanner->resetValidity();
+  mWorldConfiguration = getWorldConfiguration();
+}
+
+//==============================================================================
+void RoadmapPlanner::saveRoadmap(std::ostream& _stream) const
+{
+  writeValue(_stream, ROADMAP_PLANNER_MAGIC);
+  writeValue(_stream, ROADMAP_PLANNER_VERSION);
+
+  writeValue<std::uint64_t>(_stream, mWorldConfiguration.size());
+  for (const auto& skeleton : mWorldConfiguration)
+  {
+    writeValue<std::uint64_t>(_stream, skeleton.first.size());
+    _stream.write(skeleton.first.data(), skeleton.first.size());
+
+    const auto& positions = skeleton.second;
+    writeValue<std::uint64_t>(_stream, positions.size());
+    _stream.write(
+        reinterpret_cast<const char*>(positions.data()),
+        positions.size() * sizeof(double));
+  }
+
+  mPlanner->saveRoadmap(_stream);
+}
+
+//==============================================================================
+void RoadmapPlanner::saveRoadmap(const std::string& _filename) const
+{
+  std::ofstream stream(_filename, std::ios::binary);
+  if (!stream)
+    throw std::runtime_error("Failed to open '" + _filename + "'.");
+
+  saveRoadmap(stream);
+}
+
+//==============================================================================
+void RoadmapPlanner::loadRoadmap(std::istream& _stream)
+{
+  WorldConfiguration configuration;
+  try
+  {
+    if (readValue<std::uint32_t>(_stream) != ROADMAP_PLANNER_MAGIC)
+      throw std::runtime_error("Stream does not contain a roadmap.");
+
+    if (readValue<std::uint32_t>(_stream) != ROADMAP_PLANNER_VERSION)
+      throw std::runtime_error("Unsupported roadmap version.");
+
+    // Each skeleton is stored as the lengths of its name and positions,
+    // followed by their contents.
+    const auto numSkeletons = readCount(_stream, 2 * sizeof(std::uint64_t));
+    std::string name;
+    std::vector<double> positions;
+    for (std::uint64_t i = 0; i < numSkeletons; ++i)
+    {
+      readArray(_stream, readCount(_stream, sizeof(char)), name);
+      readArray(_stream, readCount(_stream, sizeof(double)), positions);
+
+      configuration[name] = Eigen::Map<const Eigen::VectorXd>(
+          positions.data(), positions.size());
+    }
+  }
+  catch (const std::runtime_error&)
+  {
+    mPlanner->clear();
+    throw;
+  }
+  catch (const std::exception& e)
+  {
+    mPlanner->clear();
+    throw std::runtime_error(
+        std::string("Failed to load roadmap: ") + e.what());
+  }
+
+  mPlanner->loadRoadmap(_stream);
+  mWorldConfiguration = std::move(configuration);
+}
+
+//==============================================================================
+void RoadmapPlanner::loadRoadmap(const std::string& _filename)
+{
+  std::ifstream stream(_filename, std::ios::binary);
+  if (!stream)
+    throw std::runtime_error("Failed to open '" + _filename + "'.");
+
+  loadRoadmap(stream);
+}
+
+//==============================================================================
+const ompl_shared_ptr<LazySP>& RoadmapPlanner::getPlanner() const
+{
+  return mPlanner;
+}
+
+//==============================================================================
+const statespace::dart::MetaSkeletonStateSpacePtr&
+RoadmapPlanner::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+const ::dart::dynamics::MetaSkeletonPtr& RoadmapPlanner::getMetaSkeleton() const
+{
+  return mMetaSkeleton;
+}
+
+//==============================================================================
+const constraint::TestablePtr& RoadmapPlanner::getCollisionTestable() const
+{
+  return mCollisionTestable;
+}
+
+//==============================================================================
+const statespace::InterpolatorPtr& RoadmapPlanner::getInterpolator() const
+{
+  return mInterpolator;
+}
+
+//==============================================================================
+RoadmapPlanner::WorldConfiguration RoadmapPlanner::getWorldConfiguration()
+    const
+{
+  WorldConfiguration configuration;
+
+  std::lock_guard<std::mutex> lock(mWorld->getMutex());
+  for (std::size_t i = 0; i < mWorld->getNumSkeletons(); ++i)
+  {
+    const auto skeleton = mWorld->getSkeleton(i);
+
+    // The controlled degrees of freedom change between queries, but do not
+    // affect the validity of the roadmap.
+    std::vector<double> positions;
+    positions.reserve(skeleton->getNumDofs());
+    for (std::size_t j = 0; j < skeleton->getNumDofs(); ++j)
+    {
+      const auto dof = skeleton->getDof(j);
+      if (mMetaSkeleton->getIndexOf(dof, false) == INVALID_INDEX)
+        positions.emplace_back(dof->getPosition());
+    }
+
+    configuration[skeleton->getName()]
+        = Eigen::Map<const Eigen::VectorXd>(positions.data(), positions.size());
+  }
+
+  return configuration;
+}
+
+//==============================================================================
+void RoadmapPlanner::updateValidity()
+{
+  auto configuration = getWorldConfiguration();
+  if (isSameConfiguration(configuration, mWorldConfiguration))
+    return;
+
+  mPlanner->resetValidity();
+  mWorldConfiguration = std::move(configuration);
+}
+
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
@@ -35,6 +35,12 @@ bool StateValidityChecker::isValid(const ::ompl::base::State* _state) const
   return mConstraint->isSatisfied(st->mState);
 }
 
+//==============================================================================
+constraint::TestablePtr StateValidityChecker::getConstraint() const
+{
+  return mConstraint;
+}
+
 } // namespace ompl
 } // namespace planner
 } // namespace aikido
@@ -13,7 +13,8 @@ namespace ompl {
     statespace::dart::MetaSkeletonStateSpacePtr _stateSpace,
     constraint::TestablePtr _validityConstraint,
     double _maxDistanceBtwValidityChecks,
-    std::unique_ptr<common::RNG> _rng)
+    std::unique_ptr<common::RNG> _rng,
+    std::vector<constraint::TestablePtr> _workerValidityConstraints)
 {
 
   // Distance metric
@@ -42,7 +43,8 @@ namespace ompl {
       std::move(_validityConstraint),
       std::move(boundsConstraint),
       std::move(boundsProjection),
-      _maxDistanceBtwValidityChecks);
+      _maxDistanceBtwValidityChecks,
+      std::move(_workerValidityConstraints));
 }
 
 } // namespace ompl
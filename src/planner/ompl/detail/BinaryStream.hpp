@@ -0,0 +1,98 @@
+#ifndef AIKIDO_PLANNER_OMPL_DETAIL_BINARYSTREAM_HPP_
+#define AIKIDO_PLANNER_OMPL_DETAIL_BINARYSTREAM_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace aikido {
+namespace planner {
+namespace ompl {
+namespace detail {
+
+/// Writes the bytes of \c value to \c stream, in the byte order of the
+/// architecture.
+template <typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// Reads a value written by writeValue from \c stream.
+/// \throws std::runtime_error if the stream ends first.
+template <typename T>
+T readValue(std::istream& stream)
+{
+  T value;
+  if (!stream.read(reinterpret_cast<char*>(&value), sizeof(T)))
+    throw std::runtime_error("Unexpected end of roadmap.");
+  return value;
+}
+
+/// Returns the number of bytes left in \c stream, or -1 if it can not be
+/// determined, e.g. because \c stream is not seekable.
+inline std::streamoff getNumRemainingBytes(std::istream& stream)
+{
+  const auto position = stream.tellg();
+  if (position == std::streampos(-1))
+    return -1;
+
+  stream.seekg(0, std::ios::end);
+  const auto end = stream.tellg();
+  if (end == std::streampos(-1))
+  {
+    stream.clear();
+    return -1;
+  }
+
+  stream.seekg(position);
+  return end - position;
+}
+
+/// Reads the number of elements of an array written by writeValue, each of
+/// which takes up at least \c elementSize bytes in \c stream.
+/// \throws std::runtime_error if the rest of \c stream is too short to hold
+/// that many elements. Streams of unknown size are not checked, so the count
+/// must not be used to allocate memory up front.
+inline std::uint64_t readCount(std::istream& stream, std::size_t elementSize)
+{
+  const auto count = readValue<std::uint64_t>(stream);
+  const auto numRemainingBytes = getNumRemainingBytes(stream);
+  if (numRemainingBytes >= 0
+      && count > static_cast<std::uint64_t>(numRemainingBytes) / elementSize)
+  {
+    throw std::runtime_error("Invalid count in roadmap.");
+  }
+  return count;
+}
+
+/// Reads \c size elements of \c array from \c stream. The array grows as the
+/// elements are read, so a corrupt \c size can not exhaust memory.
+/// \throws std::runtime_error if the stream ends first.
+template <typename Array>
+void readArray(std::istream& stream, std::uint64_t size, Array& array)
+{
+  constexpr std::uint64_t chunkSize = 4096;
+  using Element = typename Array::value_type;
+
+  array.clear();
+  while (array.size() < size)
+  {
+    const std::size_t offset = array.size();
+    const auto numElements = std::min(chunkSize, size - offset);
+    array.resize(offset + numElements);
+    if (!stream.read(
+            reinterpret_cast<char*>(&array[offset]),
+            numElements * sizeof(Element)))
+      throw std::runtime_error("Unexpected end of roadmap.");
+  }
+}
+
+} // namespace detail
+} // namespace ompl
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_OMPL_DETAIL_BINARYSTREAM_HPP_
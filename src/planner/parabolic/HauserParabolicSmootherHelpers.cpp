@@ -1,6 +1,14 @@
 #include "HauserParabolicSmootherHelpers.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <aikido/common/RNG.hpp>
 #include <aikido/common/VanDerCorput.hpp>
 #include "Config.h"
 #include "HauserMath.h"
@@ -23,6 +31,8 @@ public:
     , mCheckResolution(checkResolution)
     , mStateSpace(mTestable->getStateSpace())
     , mInterpolator(mStateSpace)
+    , mStartState(mStateSpace->createState())
+    , mGoalState(mStateSpace->createState())
   {
     // Do nothing
   }
@@ -38,29 +48,29 @@ public:
   bool SegmentFeasible(
       const ParabolicRamp::Vector& a, const ParabolicRamp::Vector& b) override
   {
-    Eigen::VectorXd eigA = toEigen(a);
-    Eigen::VectorXd eigB = toEigen(b);
-
-    auto testState = mStateSpace->createState();
-    auto startState = mStateSpace->createState();
-    auto goalState = mStateSpace->createState();
-    mStateSpace->expMap(eigA, startState);
-    mStateSpace->expMap(eigB, goalState);
+    mStateSpace->expMap(toEigen(a), mStartState);
+    mStateSpace->expMap(toEigen(b), mGoalState);
 
     // both ends of the segment have already been checked by calling
     // ConfigFeasible(),
     // thus it is no longer needed to check in SegmentFeasible()
     aikido::common::VanDerCorput vdc{1, false, false, mCheckResolution};
 
+    // Interpolate all the samples up front so the constraint can test the
+    // whole segment in a single batch. The states are reused across calls.
+    mTestStatePtrs.clear();
+    const auto edge = mInterpolator.prepareEdge(mStartState, mGoalState);
     for (const auto alpha : vdc)
     {
-      mInterpolator.interpolate(startState, goalState, alpha, testState);
-      if (!mTestable->isSatisfied(testState))
-      {
-        return false;
-      }
+      if (mTestStatePtrs.size() == mTestStates.size())
+        mTestStates.emplace_back(mStateSpace->createState());
+
+      auto& testState = mTestStates[mTestStatePtrs.size()];
+      edge->interpolate(alpha, testState);
+      mTestStatePtrs.emplace_back(testState);
     }
-    return true;
+
+    return mTestable->isSatisfiedBatch(mTestStatePtrs, mResults, true);
   }
 
 private:
@@ -68,6 +78,135 @@ private:
   double mCheckResolution;
   aikido::statespace::StateSpacePtr mStateSpace;
   aikido::statespace::GeodesicInterpolator mInterpolator;
+
+  aikido::statespace::StateSpace::ScopedState mStartState;
+  aikido::statespace::StateSpace::ScopedState mGoalState;
+  std::vector<aikido::statespace::StateSpace::ScopedState> mTestStates;
+  std::vector<const aikido::statespace::StateSpace::State*> mTestStatePtrs;
+  std::vector<bool> mResults;
+};
+
+class TrustedFeasibilityChecker : public ParabolicRamp::FeasibilityCheckerBase
+{
+public:
+  bool ConfigFeasible(const ParabolicRamp::Vector& /*x*/) override
+  {
+    return true;
+  }
+
+  bool SegmentFeasible(
+      const ParabolicRamp::Vector& /*a*/,
+      const ParabolicRamp::Vector& /*b*/) override
+  {
+    return true;
+  }
+};
+
+struct ShortcutWorker
+{
+  ShortcutWorker(
+      aikido::constraint::TestablePtr testable,
+      double checkResolution,
+      double tolerance,
+      std::unique_ptr<aikido::common::RNG> rng)
+    : mBase(std::move(testable), checkResolution)
+    , mFeasibilityChecker(&mBase, tolerance)
+    , mRng(std::move(rng))
+  {
+    // Do nothing
+  }
+
+  SmootherFeasibilityCheckerBase mBase;
+  ParabolicRamp::RampFeasibilityChecker mFeasibilityChecker;
+  std::unique_ptr<aikido::common::RNG> mRng;
+};
+
+/// Persistent threads that run \c work once per round, each with its own
+/// index. The calling thread takes index 0, so no thread is started or joined
+/// between rounds.
+class ShortcutThreadPool
+{
+public:
+  ShortcutThreadPool(
+      std::size_t numWorkers, std::function<void(std::size_t)> work)
+    : mWork(std::move(work)), mStop(false), mRound(0u), mNumPending(0u)
+  {
+    mThreads.reserve(numWorkers - 1);
+    for (std::size_t i = 1; i < numWorkers; ++i)
+      mThreads.emplace_back(&ShortcutThreadPool::runWorker, this, i);
+  }
+
+  ~ShortcutThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mRoundStarted.notify_all();
+
+    for (auto& thread : mThreads)
+      thread.join();
+  }
+
+  /// Runs one round and waits for every thread to finish it.
+  void runRound()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mNumPending = mThreads.size();
+      ++mRound;
+    }
+    mRoundStarted.notify_all();
+
+    mWork(0u);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mRoundFinished.wait(lock, [this]() { return mNumPending == 0u; });
+  }
+
+private:
+  void runWorker(std::size_t index)
+  {
+    std::size_t lastRound = 0u;
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mRoundStarted.wait(lock, [this, lastRound]() {
+          return mStop || mRound != lastRound;
+        });
+        if (mStop)
+          return;
+        lastRound = mRound;
+      }
+
+      mWork(index);
+
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mNumPending == 0u)
+          mRoundFinished.notify_all();
+      }
+    }
+  }
+
+  std::function<void(std::size_t)> mWork;
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mRoundStarted;
+  std::condition_variable mRoundFinished;
+
+  // The following are protected by mMutex.
+  bool mStop;
+  std::size_t mRound;
+  std::size_t mNumPending;
+};
+
+struct Shortcut
+{
+  double mStartTime;
+  double mEndTime;
+  double mSavedTime;
 };
 
 bool needsBlend(const ParabolicRamp::ParabolicRampND& rampNd)
@@ -162,6 +301,213 @@ bool doShortcut(
   return success;
 }
 
+bool doOnlineShortcut(
+    ParabolicRamp::DynamicPath& dynamicPath,
+    aikido::constraint::TestablePtr testable,
+    double timelimit,
+    double checkResolution,
+    double tolerance,
+    aikido::common::RNG& rng,
+    const std::function<double()>& getEarliestTime,
+    const std::function<bool(const ParabolicRamp::DynamicPath&, double)>&
+        publish)
+{
+  if (timelimit < 0.0)
+    throw std::invalid_argument("Timelimit should be non-negative");
+  if (checkResolution <= 0.0)
+    throw std::invalid_argument("Check resolution should be positive");
+  if (tolerance < 0.0)
+    throw std::invalid_argument("Tolerance should be non-negative");
+
+  SmootherFeasibilityCheckerBase base(testable, checkResolution);
+  ParabolicRamp::RampFeasibilityChecker feasibilityChecker(&base, tolerance);
+
+  // The last published path, restored when a shortcut is rejected.
+  ParabolicRamp::DynamicPath publishedPath = dynamicPath;
+
+  std::chrono::time_point<std::chrono::system_clock> startTime
+      = std::chrono::system_clock::now();
+  double elapsedTime = 0;
+
+  bool success = false;
+  while (elapsedTime < timelimit)
+  {
+    const double earliestTime = std::max(getEarliestTime(), 0.0);
+    const double totalTime = dynamicPath.GetTotalTime();
+    if (earliestTime >= totalTime)
+      break;
+
+    // Like doShortcut, stop once at most three ramps are left to shortcut.
+    double u;
+    bool outOfBounds;
+    const int segment = dynamicPath.GetSegment(earliestTime, u, outOfBounds);
+    if (static_cast<int>(dynamicPath.ramps.size()) - segment <= 3)
+      break;
+
+    std::uniform_real_distribution<> dist(earliestTime, totalTime);
+    double t1 = dist(rng);
+    double t2 = dist(rng);
+    if (dynamicPath.TryShortcut(t1, t2, feasibilityChecker))
+    {
+      if (publish(dynamicPath, std::min(t1, t2)))
+      {
+        publishedPath = dynamicPath;
+        success = true;
+      }
+      else
+      {
+        dynamicPath = publishedPath;
+      }
+    }
+
+    elapsedTime = std::chrono::duration_cast<std::chrono::duration<double>>(
+                      std::chrono::system_clock::now() - startTime)
+                      .count();
+  }
+  return success;
+}
+
+bool doShortcutParallel(
+    ParabolicRamp::DynamicPath& dynamicPath,
+    const std::vector<aikido::constraint::TestablePtr>& testables,
+    double timelimit,
+    double checkResolution,
+    double tolerance,
+    aikido::common::RNG& rng)
+{
+  if (testables.empty())
+    throw std::invalid_argument("At least one testable is required");
+  if (timelimit < 0.0)
+    throw std::invalid_argument("Timelimit should be non-negative");
+  if (checkResolution <= 0.0)
+    throw std::invalid_argument("Check resolution should be positive");
+  if (tolerance < 0.0)
+    throw std::invalid_argument("Tolerance should be non-negative");
+
+  auto rngs = aikido::common::cloneRNGsFrom(rng, testables.size());
+
+  std::vector<std::unique_ptr<ShortcutWorker>> workers;
+  workers.reserve(testables.size());
+  for (std::size_t i = 0; i < testables.size(); ++i)
+  {
+    if (!testables[i])
+      throw std::invalid_argument("Testable is nullptr");
+
+    workers.emplace_back(
+        new ShortcutWorker(
+            testables[i], checkResolution, tolerance, std::move(rngs[i])));
+  }
+
+  // Shortcuts found by the workers are feasible and are not checked again.
+  TrustedFeasibilityChecker trustedBase;
+  ParabolicRamp::RampFeasibilityChecker trustedChecker(&trustedBase, tolerance);
+
+  std::chrono::time_point<std::chrono::system_clock> startTime
+      = std::chrono::system_clock::now();
+  auto getElapsedTime = [&startTime]() {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(
+               std::chrono::system_clock::now() - startTime)
+        .count();
+  };
+
+  // Every round, each worker searches a copy of the path for a shortcut. The
+  // main thread only changes the path between rounds.
+  double totalTime = 0.0;
+  std::vector<Shortcut> shortcuts;
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  auto work = [&](std::size_t iworker) {
+    try
+    {
+      ShortcutWorker& worker = *workers[iworker];
+      ParabolicRamp::DynamicPath path = dynamicPath;
+      std::uniform_real_distribution<> dist(0.0, totalTime);
+
+      while (getElapsedTime() < timelimit)
+      {
+        const double t1 = dist(*worker.mRng);
+        const double t2 = dist(*worker.mRng);
+        if (path.TryShortcut(t1, t2, worker.mFeasibilityChecker))
+        {
+          shortcuts[iworker] = Shortcut{std::min(t1, t2),
+                                        std::max(t1, t2),
+                                        totalTime - path.GetTotalTime()};
+          return;
+        }
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if (!exception)
+        exception = std::current_exception();
+    }
+  };
+
+  ShortcutThreadPool threadPool(workers.size(), work);
+
+  bool success = false;
+  while (getElapsedTime() < timelimit && dynamicPath.ramps.size() > 3)
+  {
+    totalTime = dynamicPath.GetTotalTime();
+    shortcuts.assign(workers.size(), Shortcut{0., 0., 0.});
+
+    threadPool.runRound();
+
+    if (exception)
+      std::rethrow_exception(exception);
+
+    // Greedily select the shortcuts that save the most time among those that
+    // do not overlap.
+    std::sort(
+        shortcuts.begin(),
+        shortcuts.end(),
+        [](const Shortcut& a, const Shortcut& b) {
+          return a.mSavedTime > b.mSavedTime;
+        });
+
+    std::vector<Shortcut> selected;
+    for (const auto& shortcut : shortcuts)
+    {
+      if (shortcut.mSavedTime <= 0.0)
+        break;
+
+      bool overlaps = false;
+      for (const auto& other : selected)
+      {
+        if (shortcut.mStartTime <= other.mEndTime
+            && other.mStartTime <= shortcut.mEndTime)
+        {
+          overlaps = true;
+          break;
+        }
+      }
+
+      if (!overlaps)
+        selected.push_back(shortcut);
+    }
+
+    // Applying the shortcuts from the end of the path leaves the path before
+    // each of them as it was when the shortcut was found.
+    std::sort(
+        selected.begin(),
+        selected.end(),
+        [](const Shortcut& a, const Shortcut& b) {
+          return a.mStartTime > b.mStartTime;
+        });
+
+    for (const auto& shortcut : selected)
+    {
+      if (dynamicPath.TryShortcut(
+              shortcut.mStartTime, shortcut.mEndTime, trustedChecker))
+      {
+        success = true;
+      }
+    }
+  }
+  return success;
+}
+
 bool doBlend(
     ParabolicRamp::DynamicPath& dynamicPath,
     aikido::constraint::TestablePtr testable,
@@ -1,6 +1,8 @@
 #ifndef AIKIDO_PLANNER_PARABOLIC_SMOOTHER_HELPER_HPP_
 #define AIKIDO_PLANNER_PARABOLIC_SMOOTHER_HELPER_HPP_
 
+#include <functional>
+#include <vector>
 #include <Eigen/Dense>
 #include "aikido/trajectory/Interpolated.hpp"
 #include "aikido/trajectory/Spline.hpp"
@@ -18,6 +20,32 @@ namespace detail {
                   double checkResolution, double tolerance,
                   aikido::common::RNG& rng);
 
+  /// Shortcuts dynamicPath like doShortcut, but only after the time returned
+  /// by getEarliestTime, which may increase between attempts. Each shortcut
+  /// starting at time t is passed to publish(dynamicPath, t). If publish
+  /// returns false the shortcut is undone. Stops when the timelimit is
+  /// reached or at most three ramps are left after getEarliestTime.
+  bool doOnlineShortcut(ParabolicRamp::DynamicPath& dynamicPath,
+                        aikido::constraint::TestablePtr testable,
+                        double timelimit,
+                        double checkResolution, double tolerance,
+                        aikido::common::RNG& rng,
+                        const std::function<double()>& getEarliestTime,
+                        const std::function<bool(
+                            const ParabolicRamp::DynamicPath&, double)>&
+                            publish);
+
+  /// Shortcuts dynamicPath like doShortcut, trying shortcuts in one thread
+  /// per testable. In each round every thread tries shortcuts on the current
+  /// path until one is feasible, then the non-overlapping shortcuts that save
+  /// the most time are applied.
+  bool doShortcutParallel(ParabolicRamp::DynamicPath& dynamicPath,
+                          const std::vector<aikido::constraint::TestablePtr>&
+                              testables,
+                          double timelimit,
+                          double checkResolution, double tolerance,
+                          aikido::common::RNG& rng);
+
   bool doBlend(ParabolicRamp::DynamicPath& dynamicPath,
                aikido::constraint::TestablePtr testable,
                double blendRadius, int blendIterations,
@@ -0,0 +1,205 @@
+#include "aikido/planner/parabolic/OnlineShortcutTrajectory.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <dart/common/Console.hpp>
+#include "DynamicPath.h"
+#include "HauserParabolicSmootherHelpers.hpp"
+#include "ParabolicUtil.hpp"
+
+namespace aikido {
+namespace planner {
+namespace parabolic {
+
+//==============================================================================
+OnlineShortcutTrajectory::OnlineShortcutTrajectory(
+    const trajectory::Spline& _inputTrajectory,
+    constraint::TestablePtr _feasibilityCheck,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    std::unique_ptr<common::RNG> _rng,
+    double _timelimit,
+    double _leadTime,
+    double _checkResolution,
+    double _tolerance)
+  : mStateSpace{_inputTrajectory.getStateSpace()}
+  , mStartTime{_inputTrajectory.getStartTime()}
+  , mLeadTime{_leadTime}
+  , mExecutionTime{_inputTrajectory.getStartTime()}
+  , mNumShortcuts{0}
+  , mStopped{false}
+  , mRunning{true}
+{
+  if (!_feasibilityCheck)
+    throw std::invalid_argument("Feasibility check is nullptr.");
+
+  if (!_rng)
+    throw std::invalid_argument("RNG is nullptr.");
+
+  if (_leadTime < 0.0)
+    throw std::invalid_argument("Lead time should be non-negative");
+
+  std::shared_ptr<ParabolicRamp::DynamicPath> dynamicPath
+      = detail::convertToDynamicPath(
+          _inputTrajectory, _maxVelocity, _maxAcceleration);
+  mSpline = detail::convertToSpline(*dynamicPath, mStartTime, mStateSpace);
+  mNumDerivatives = mSpline->getNumDerivatives();
+
+  std::shared_ptr<common::RNG> rng = std::move(_rng);
+
+  mThread = std::thread([=]() {
+    try
+    {
+      detail::doOnlineShortcut(
+          *dynamicPath,
+          _feasibilityCheck,
+          _timelimit,
+          _checkResolution,
+          _tolerance,
+          *rng,
+          [this]() -> double {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mStopped)
+              return std::numeric_limits<double>::infinity();
+
+            return mExecutionTime + mLeadTime - mStartTime;
+          },
+          [this](const ParabolicRamp::DynamicPath& _path, double _t) {
+            return splice(
+                detail::convertToSpline(_path, mStartTime, mStateSpace),
+                mStartTime + _t);
+          });
+    }
+    catch (const std::exception& e)
+    {
+      dtwarn << "[OnlineShortcutTrajectory] Stopped shortcutting: "
+             << e.what() << "\n";
+    }
+
+    mRunning.store(false);
+  });
+}
+
+//==============================================================================
+OnlineShortcutTrajectory::~OnlineShortcutTrajectory()
+{
+  stop();
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr OnlineShortcutTrajectory::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+std::size_t OnlineShortcutTrajectory::getNumDerivatives() const
+{
+  return mNumDerivatives;
+}
+
+//==============================================================================
+double OnlineShortcutTrajectory::getDuration() const
+{
+  return getSpline()->getDuration();
+}
+
+//==============================================================================
+double OnlineShortcutTrajectory::getStartTime() const
+{
+  return mStartTime;
+}
+
+//==============================================================================
+double OnlineShortcutTrajectory::getEndTime() const
+{
+  return getSpline()->getEndTime();
+}
+
+//==============================================================================
+void OnlineShortcutTrajectory::evaluate(
+    double _t, statespace::StateSpace::State* _state) const
+{
+  advanceTo(_t)->evaluate(_t, _state);
+}
+
+//==============================================================================
+void OnlineShortcutTrajectory::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
+{
+  advanceTo(_t)->evaluateDerivative(_t, _derivative, _tangentVector);
+}
+
+//==============================================================================
+std::shared_ptr<const trajectory::Spline> OnlineShortcutTrajectory::getSpline()
+    const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSpline;
+}
+
+//==============================================================================
+double OnlineShortcutTrajectory::getExecutionTime() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mExecutionTime;
+}
+
+//==============================================================================
+std::size_t OnlineShortcutTrajectory::getNumShortcuts() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumShortcuts;
+}
+
+//==============================================================================
+bool OnlineShortcutTrajectory::isShortcutting() const
+{
+  return mRunning.load();
+}
+
+//==============================================================================
+void OnlineShortcutTrajectory::wait()
+{
+  std::lock_guard<std::mutex> lock(mThreadMutex);
+  if (mThread.joinable())
+    mThread.join();
+}
+
+//==============================================================================
+void OnlineShortcutTrajectory::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopped = true;
+  }
+
+  wait();
+}
+
+//==============================================================================
+std::shared_ptr<const trajectory::Spline> OnlineShortcutTrajectory::advanceTo(
+    double _t) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mExecutionTime = std::max(mExecutionTime, _t);
+  return mSpline;
+}
+
+//==============================================================================
+bool OnlineShortcutTrajectory::splice(
+    std::unique_ptr<trajectory::Spline> _spline, double _shortcutTime)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mStopped || _shortcutTime < mExecutionTime + mLeadTime)
+    return false;
+
+  mSpline = std::move(_spline);
+  ++mNumShortcuts;
+  return true;
+}
+
+} // namespace parabolic
+} // namespace planner
+} // namespace aikido
@@ -4,6 +4,7 @@
 #include <set>
 #include <dart/common/StlHelpers.hpp>
 #include "aikido/common/Spline.hpp"
+#include "aikido/planner/parabolic/OnlineShortcutTrajectory.hpp"
 #include "aikido/planner/parabolic/ParabolicTimer.hpp"
 #include "DynamicPath.h"
 #include "HauserParabolicSmootherHelpers.hpp"
@@ -43,6 +44,36 @@ std::unique_ptr<aikido::trajectory::Spline> doShortcut(
   return outputTrajectory;
 }
 
+std::unique_ptr<trajectory::Spline> doShortcutParallel(
+    const trajectory::Spline& _inputTrajectory,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit,
+    double _checkResolution,
+    double _tolerance)
+{
+  auto stateSpace = _inputTrajectory.getStateSpace();
+
+  double startTime = _inputTrajectory.getStartTime();
+  auto dynamicPath = detail::convertToDynamicPath(
+      _inputTrajectory, _maxVelocity, _maxAcceleration);
+
+  detail::doShortcutParallel(
+      *dynamicPath,
+      _feasibilityChecks,
+      _timelimit,
+      _checkResolution,
+      _tolerance,
+      _rng);
+
+  auto outputTrajectory
+      = detail::convertToSpline(*dynamicPath, startTime, stateSpace);
+
+  return outputTrajectory;
+}
+
 std::unique_ptr<trajectory::Spline> doBlend(
     const trajectory::Spline& _inputTrajectory,
     aikido::constraint::TestablePtr _feasibilityCheck,
@@ -173,6 +204,58 @@ std::unique_ptr<aikido::trajectory::Spline> ParabolicSmoother::postprocess(
   return timedTrajectory;
 }
 
+//==============================================================================
+std::unique_ptr<OnlineShortcutTrajectory> ParabolicSmoother::postprocessOnline(
+    const aikido::trajectory::Interpolated& _inputTraj,
+    const aikido::common::RNG& _rng,
+    const aikido::constraint::TestablePtr& _collisionTestable,
+    double _leadTime)
+{
+  auto timedTrajectory = computeParabolicTiming(
+      _inputTraj, mVelocityLimits, mAccelerationLimits);
+
+  return handleOnlineShortcut(
+      *timedTrajectory, _rng, _collisionTestable, _leadTime);
+}
+
+//==============================================================================
+std::unique_ptr<OnlineShortcutTrajectory> ParabolicSmoother::postprocessOnline(
+    const aikido::trajectory::Spline& _inputTraj,
+    const aikido::common::RNG& _rng,
+    const aikido::constraint::TestablePtr& _collisionTestable,
+    double _leadTime)
+{
+  auto timedTrajectory = computeParabolicTiming(
+      _inputTraj, mVelocityLimits, mAccelerationLimits);
+
+  return handleOnlineShortcut(
+      *timedTrajectory, _rng, _collisionTestable, _leadTime);
+}
+
+//==============================================================================
+std::unique_ptr<OnlineShortcutTrajectory>
+ParabolicSmoother::handleOnlineShortcut(
+    const aikido::trajectory::Spline& _timedTraj,
+    const aikido::common::RNG& _rng,
+    const aikido::constraint::TestablePtr& _collisionTestable,
+    double _leadTime)
+{
+  if (!_collisionTestable)
+    throw std::invalid_argument(
+        "_collisionTestable passed to ParabolicSmoother is nullptr.");
+
+  return ::dart::common::make_unique<OnlineShortcutTrajectory>(
+      _timedTraj,
+      _collisionTestable,
+      mVelocityLimits,
+      mAccelerationLimits,
+      _rng.clone(),
+      mEnableShortcut ? mShortcutTimelimit : 0.0,
+      _leadTime,
+      mFeasibilityCheckResolution,
+      mFeasibilityApproxTolerance);
+}
+
 //==============================================================================
 std::unique_ptr<aikido::trajectory::Spline>
 ParabolicSmoother::handleShortcutOrBlend(
@@ -1,11 +1,11 @@
 #include "ParabolicUtil.hpp"
 
+#include <algorithm>
 #include <cassert>
-#include <set>
+#include <vector>
 
 #include <dart/common/StlHelpers.hpp>
 #include <dart/dart.hpp>
-#include <aikido/common/Spline.hpp>
 #include <aikido/statespace/CartesianProduct.hpp>
 #include <aikido/statespace/GeodesicInterpolator.hpp>
 #include <aikido/statespace/Rn.hpp>
@@ -15,16 +15,12 @@
 
 #include "DynamicPath.h"
 
-using Eigen::Vector2d;
 using aikido::statespace::CartesianProduct;
 using aikido::statespace::R;
 using aikido::statespace::SO2;
 using aikido::statespace::StateSpace;
 using dart::common::make_unique;
 
-using CubicSplineProblem
-    = aikido::common::SplineProblem<double, int, 4, Eigen::Dynamic, 2>;
-
 namespace aikido {
 namespace planner {
 namespace parabolic {
@@ -127,59 +123,88 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
 {
   const auto dimension = _stateSpace->getDimension();
 
-  // Construct a list of all ramp transition points.
-  double t = 0.;
-  std::set<double> transitionTimes;
-  transitionTimes.insert(t);
+  auto _outputTrajectory
+      = make_unique<aikido::trajectory::Spline>(_stateSpace, _startTime);
+  auto segmentStartState = _stateSpace->createState();
+
+  // Each one-dimensional ramp is quadratic between its switch times, so
+  // every interval between consecutive switch times of a ParabolicRampND is
+  // a quadratic segment whose coefficients are read off the ramps directly.
+  // The segments keep a zero cubic coefficient, so that the spline reports
+  // the same number of derivatives as one fit with cubic segments.
+  std::vector<double> switchTimes;
+  switchTimes.reserve(2 * dimension + 2);
+  Eigen::VectorXd segmentStartPosition(dimension);
+  Eigen::MatrixXd coefficients(dimension, 4);
+  coefficients.col(0).setZero();
+  coefficients.col(3).setZero();
 
   for (const auto& rampNd : _inputPath.ramps)
   {
+    switchTimes.clear();
+    switchTimes.push_back(0.);
+    switchTimes.push_back(rampNd.endTime);
     for (const auto& ramp1d : rampNd.ramps)
     {
-      transitionTimes.insert(t + ramp1d.tswitch1);
-      transitionTimes.insert(t + ramp1d.tswitch2);
-    }
-
-    t += rampNd.endTime;
-    transitionTimes.insert(t);
-  }
+      if (ramp1d.tswitch1 > 0. && ramp1d.tswitch1 < rampNd.endTime)
+        switchTimes.push_back(ramp1d.tswitch1);
 
-  // Convert the output to a spline with a knot at each transition time.
-  assert(!transitionTimes.empty());
-  const auto startIt = std::begin(transitionTimes);
-  double timePrev = *startIt;
-  transitionTimes.erase(startIt);
-
-  Eigen::VectorXd positionPrev, velocityPrev;
-  evaluateAtTime(_inputPath, timePrev, positionPrev, velocityPrev);
+      if (ramp1d.tswitch2 > 0. && ramp1d.tswitch2 < rampNd.endTime)
+        switchTimes.push_back(ramp1d.tswitch2);
+    }
 
-  auto _outputTrajectory = make_unique<aikido::trajectory::Spline>(
-      _stateSpace, timePrev + _startTime);
-  auto segmentStartState = _stateSpace->createState();
+    std::sort(switchTimes.begin(), switchTimes.end());
+    switchTimes.erase(
+        std::unique(switchTimes.begin(), switchTimes.end()),
+        switchTimes.end());
 
-  for (const auto timeCurr : transitionTimes)
-  {
-    Eigen::VectorXd positionCurr, velocityCurr;
-    evaluateAtTime(_inputPath, timeCurr, positionCurr, velocityCurr);
-
-    CubicSplineProblem problem(Vector2d(0, timeCurr - timePrev), 4, dimension);
-    problem.addConstantConstraint(0, 0, Eigen::VectorXd::Zero(dimension));
-    problem.addConstantConstraint(0, 1, velocityPrev);
-    problem.addConstantConstraint(1, 0, positionCurr - positionPrev);
-    problem.addConstantConstraint(1, 1, velocityCurr);
-    const auto spline = problem.fit();
-
-    _stateSpace->expMap(positionPrev, segmentStartState);
-
-    // Add the ramp to the output trajectory.
-    assert(spline.getCoefficients().size() == 1);
-    const auto& coefficients = spline.getCoefficients().front();
-    _outputTrajectory->addSegment(
-        coefficients, timeCurr - timePrev, segmentStartState);
-
-    timePrev = timeCurr;
-    positionPrev = positionCurr;
-    velocityPrev = velocityCurr;
+    for (std::size_t iswitch = 1; iswitch < switchTimes.size(); ++iswitch)
+    {
+      const double timePrev = switchTimes[iswitch - 1];
+      const double timeCurr = switchTimes[iswitch];
+      const double timeMid = 0.5 * (timePrev + timeCurr);
+
+      for (std::size_t i = 0; i < dimension; ++i)
+      {
+        const auto& ramp1d = rampNd.ramps[i];
+
+        // Each ramp is continuous, so use the piece that contains the
+        // interior of the segment.
+        double position, velocity, acceleration;
+        if (timeMid < ramp1d.tswitch1)
+        {
+          position = ramp1d.x0 + ramp1d.dx0 * timePrev
+                     + 0.5 * ramp1d.a1 * timePrev * timePrev;
+          velocity = ramp1d.dx0 + ramp1d.a1 * timePrev;
+          acceleration = ramp1d.a1;
+        }
+        else if (timeMid < ramp1d.tswitch2)
+        {
+          const double positionSwitch
+              = ramp1d.x0 + ramp1d.dx0 * ramp1d.tswitch1
+                + 0.5 * ramp1d.a1 * ramp1d.tswitch1 * ramp1d.tswitch1;
+          position = positionSwitch + ramp1d.v * (timePrev - ramp1d.tswitch1);
+          velocity = ramp1d.v;
+          acceleration = 0.;
+        }
+        else
+        {
+          const double timeToEnd = timePrev - ramp1d.ttotal;
+          position = ramp1d.x1 + ramp1d.dx1 * timeToEnd
+                     + 0.5 * ramp1d.a2 * timeToEnd * timeToEnd;
+          velocity = ramp1d.dx1 + ramp1d.a2 * timeToEnd;
+          acceleration = ramp1d.a2;
+        }
+
+        segmentStartPosition[i] = position;
+        coefficients(i, 1) = velocity;
+        coefficients(i, 2) = 0.5 * acceleration;
+      }
+
+      _stateSpace->expMap(segmentStartPosition, segmentStartState);
+      _outputTrajectory->addSegment(
+          coefficients, timeCurr - timePrev, segmentStartState);
+    }
   }
 
   return _outputTrajectory;
@@ -34,6 +34,7 @@ BodyNodePoseVectorField::BodyNodePoseVectorField(
 
   mVelocityLowerLimits = mMetaSkeleton->getVelocityLowerLimits();
   mVelocityUpperLimits = mMetaSkeleton->getVelocityUpperLimits();
+  mPreviousVelocity = Eigen::VectorXd::Zero(mMetaSkeleton->getNumDofs());
 }
 
 //==============================================================================
@@ -60,6 +61,7 @@ bool BodyNodePoseVectorField::evaluateVelocity(
     return false;
   }
 
+  qd = mPreviousVelocity;
   bool result = computeJointVelocityFromTwist(
       qd,
       desiredTwist,
@@ -69,7 +71,11 @@ bool BodyNodePoseVectorField::evaluateVelocity(
       mVelocityLowerLimits,
       mVelocityUpperLimits,
       mEnforceJointVelocityLimits,
-      mMaxStepSize);
+      mMaxStepSize,
+      mSolver);
+  if (result)
+    mPreviousVelocity = qd;
+
   return result;
 }
 
@@ -100,11 +100,21 @@ std::unique_ptr<aikido::trajectory::Spline> followVectorField(
     return nullptr;
   }
 
-  std::vector<detail::Knot> newKnots(
-      integrator->getKnots().begin(),
-      integrator->getKnots().begin() + integrator->getCacheIndex());
-  auto outputTrajectory
-      = detail::convertToSpline(newKnots, vectorField.getStateSpace());
+  // Reuse the trajectory built during integration if all of its knots were
+  // cached.
+  std::unique_ptr<aikido::trajectory::Spline> outputTrajectory;
+  const auto& knots = integrator->getKnots();
+  if (static_cast<std::size_t>(integrator->getCacheIndex()) == knots.size())
+  {
+    outputTrajectory = integrator->releaseTrajectory();
+  }
+  else
+  {
+    std::vector<detail::Knot> newKnots(
+        knots.begin(), knots.begin() + integrator->getCacheIndex());
+    outputTrajectory
+        = detail::convertToSpline(newKnots, vectorField.getStateSpace());
+  }
 
   // evaluate constraint satisfaction on last piece of trajectory
   double lastEvaluationTime = integrator->getLastEvaluationTime();
@@ -1,7 +1,5 @@
+#include <limits>
 #include <Eigen/Geometry>
-#include <dart/optimizer/Solver.hpp>
-#include <dart/optimizer/nlopt/NloptSolver.hpp>
-#include <aikido/common/algorithm.hpp>
 #include <aikido/planner/vectorfield/VectorFieldUtil.hpp>
 #include <aikido/trajectory/Spline.hpp>
 
@@ -9,56 +7,32 @@ namespace aikido {
 namespace planner {
 namespace vectorfield {
 
-namespace {
-
-/// A function class that defines an objective. The objective measures
-/// the difference between a desired twist and Jacobian * joint velocities.
-///
-class DesiredTwistFunction : public dart::optimizer::Function
+//==============================================================================
+bool computeJointVelocityFromTwist(
+    Eigen::VectorXd& jointVelocity,
+    const Eigen::Vector6d& desiredTwist,
+    const dart::dynamics::MetaSkeletonPtr metaSkeleton,
+    const dart::dynamics::BodyNodePtr bodyNode,
+    double jointLimitPadding,
+    const Eigen::VectorXd& jointVelocityLowerLimits,
+    const Eigen::VectorXd& jointVelocityUpperLimits,
+    bool enforceJointVelocityLimits,
+    double stepSize)
 {
-public:
-  using Twist = Eigen::Vector6d;
-  using Jacobian = dart::math::Jacobian;
-
-  /// Constructor.
-  ///
-  /// \param[in] twist A desired twist.
-  /// \param[in] jacobian System Jacobian.
-  DesiredTwistFunction(const Twist& twist, const Jacobian& jacobian)
-    : dart::optimizer::Function("DesiredTwistFunction")
-    , mTwist(twist)
-    , mJacobian(jacobian)
-  {
-    // Do nothing
-  }
-
-  /// Implementation inherited.
-  /// Evaluating an objective by a state value.
-  ///
-  /// \param[in] qd Joint velocities.
-  /// \return Objective value.
-  double eval(const Eigen::VectorXd& qd) override
-  {
-    return 0.5 * (mJacobian * qd - mTwist).squaredNorm();
-  }
-
-  /// Implementation inherited.
-  /// Evaluating gradient of an objective by a state value.
-  /// \param[in] qd Joint velocities.
-  /// \param[out] grad Gradient of a defined objective.
-  void evalGradient(
-      const Eigen::VectorXd& qd, Eigen::Map<Eigen::VectorXd> grad) override
-  {
-    grad = mJacobian.transpose() * (mJacobian * qd - mTwist);
-  }
-
-private:
-  /// Twist.
-  Twist mTwist;
-
-  /// Jacobian of Meta Skeleton.
-  Jacobian mJacobian;
-};
+  jointVelocity = metaSkeleton->getVelocities();
+
+  common::BoundedLeastSquaresSolver solver;
+  return computeJointVelocityFromTwist(
+      jointVelocity,
+      desiredTwist,
+      metaSkeleton,
+      bodyNode,
+      jointLimitPadding,
+      jointVelocityLowerLimits,
+      jointVelocityUpperLimits,
+      enforceJointVelocityLimits,
+      stepSize,
+      solver);
 }
 
 //==============================================================================
@@ -71,29 +45,33 @@ bool computeJointVelocityFromTwist(
     const Eigen::VectorXd& jointVelocityLowerLimits,
     const Eigen::VectorXd& jointVelocityUpperLimits,
     bool enforceJointVelocityLimits,
-    double stepSize)
+    double stepSize,
+    common::BoundedLeastSquaresSolver& solver)
 {
   using dart::math::Jacobian;
-  using dart::optimizer::Problem;
-  using dart::optimizer::Solver;
   using Eigen::VectorXd;
 
-  // Use LBFGS to find joint angles that won't violate the joint limits.
-  const Jacobian jacobian = metaSkeleton->getWorldJacobian(bodyNode);
-
   const std::size_t numDofs = metaSkeleton->getNumDofs();
+  if (static_cast<std::size_t>(jointVelocity.size()) != numDofs)
+    jointVelocity = VectorXd::Zero(numDofs);
+
+  // Minimize ||J qd - twist||^2 subject to bounds on qd that won't violate
+  // the joint limits.
+  const Jacobian jacobian = metaSkeleton->getWorldJacobian(bodyNode);
 
-  jointVelocity = Eigen::VectorXd::Zero(numDofs);
-  VectorXd positions = metaSkeleton->getPositions();
-  VectorXd initialGuess = metaSkeleton->getVelocities();
-  VectorXd positionLowerLimits = metaSkeleton->getPositionLowerLimits();
-  VectorXd positionUpperLimits = metaSkeleton->getPositionUpperLimits();
-  VectorXd velocityLowerLimits = jointVelocityLowerLimits;
-  VectorXd velocityUpperLimits = jointVelocityUpperLimits;
+  VectorXd velocityLowerLimits = VectorXd::Constant(
+      numDofs, -std::numeric_limits<double>::infinity());
+  VectorXd velocityUpperLimits = VectorXd::Constant(
+      numDofs, std::numeric_limits<double>::infinity());
 
-  const auto problem = std::make_shared<Problem>(numDofs);
   if (enforceJointVelocityLimits)
   {
+    const VectorXd positions = metaSkeleton->getPositions();
+    const VectorXd positionLowerLimits = metaSkeleton->getPositionLowerLimits();
+    const VectorXd positionUpperLimits = metaSkeleton->getPositionUpperLimits();
+    velocityLowerLimits = jointVelocityLowerLimits;
+    velocityUpperLimits = jointVelocityUpperLimits;
+
     for (std::size_t i = 0; i < numDofs; ++i)
     {
       const double position = positions[i];
@@ -113,25 +91,16 @@ bool computeJointVelocityFromTwist(
       {
         velocityUpperLimits[i] = 0.0;
       }
-
-      initialGuess[i] = common::clamp(
-          initialGuess[i], velocityLowerLimits[i], velocityUpperLimits[i]);
     }
-    problem->setLowerBounds(velocityLowerLimits);
-    problem->setUpperBounds(velocityUpperLimits);
   }
 
-  problem->setInitialGuess(initialGuess);
-  problem->setObjective(
-      std::make_shared<DesiredTwistFunction>(desiredTwist, jacobian));
-
-  dart::optimizer::NloptSolver solver(problem, nlopt::LD_LBFGS);
-  if (!solver.solve())
-  {
-    return false;
-  }
-  jointVelocity = problem->getOptimalSolution();
-  return true;
+  return solver.solve(
+             jacobian,
+             desiredTwist,
+             velocityLowerLimits,
+             velocityUpperLimits,
+             jointVelocity)
+         && jointVelocity.allFinite();
 }
 
 //==============================================================================
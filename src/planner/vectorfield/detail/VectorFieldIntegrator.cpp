@@ -18,32 +18,41 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
 {
   using dart::common::make_unique;
 
-  std::size_t dimension = stateSpace->getDimension();
-
   auto outputTrajectory = make_unique<aikido::trajectory::Spline>(stateSpace);
+  for (std::size_t iknot = 0; iknot + 1 < knots.size(); ++iknot)
+    appendToSpline(knots[iknot], knots[iknot + 1], *outputTrajectory);
+
+  return outputTrajectory;
+}
 
-  using CubicSplineProblem = aikido::common::
-      SplineProblem<double, int, 2, Eigen::Dynamic, Eigen::Dynamic>;
+//==============================================================================
+void appendToSpline(
+    const Knot& previousKnot,
+    const Knot& knot,
+    aikido::trajectory::Spline& trajectory)
+{
+  // A single segment with a fixed number of coefficients is solved in closed
+  // form.
+  using LinearSplineProblem
+      = aikido::common::SplineProblem<double, int, 2, Eigen::Dynamic, 2>;
 
+  const auto stateSpace = trajectory.getStateSpace();
+  const std::size_t dimension = stateSpace->getDimension();
+
+  const double segmentDuration = knot.mT - previousKnot.mT;
   const Eigen::VectorXd zeroPosition = Eigen::VectorXd::Zero(dimension);
-  auto currState = stateSpace->createState();
-  for (std::size_t iknot = 0; iknot < knots.size() - 1; ++iknot)
-  {
-    const double segmentDuration = knots[iknot + 1].mT - knots[iknot].mT;
-    Eigen::VectorXd currentPosition = knots[iknot].mPositions;
-    Eigen::VectorXd nextPosition = knots[iknot + 1].mPositions;
-
-    CubicSplineProblem problem(
-        Eigen::Vector2d{0., segmentDuration}, 2, dimension);
-    problem.addConstantConstraint(0, 0, zeroPosition);
-    problem.addConstantConstraint(1, 0, nextPosition - currentPosition);
-    const auto solution = problem.fit();
-    const auto coefficients = solution.getCoefficients().front();
-
-    stateSpace->expMap(currentPosition, currState);
-    outputTrajectory->addSegment(coefficients, segmentDuration, currState);
-  }
-  return outputTrajectory;
+
+  LinearSplineProblem problem(
+      Eigen::Vector2d{0., segmentDuration}, 2, dimension);
+  problem.addConstantConstraint(0, 0, zeroPosition);
+  problem.addConstantConstraint(
+      1, 0, knot.mPositions - previousKnot.mPositions);
+  const auto solution = problem.fit();
+  const auto coefficients = solution.getCoefficients().front();
+
+  auto startState = stateSpace->createState();
+  stateSpace->expMap(previousKnot.mPositions, startState);
+  trajectory.addSegment(coefficients, segmentDuration, startState);
 }
 
 //==============================================================================
@@ -61,6 +70,8 @@ VectorFieldIntegrator::VectorFieldIntegrator(
   mLastEvaluationTime = 0.0;
   mDimension = mVectorField->getStateSpace()->getDimension();
   mState = mVectorField->getStateSpace()->createState();
+  mTrajectory = dart::common::make_unique<aikido::trajectory::Spline>(
+      mVectorField->getStateSpace());
 }
 
 //==============================================================================
@@ -68,6 +79,8 @@ void VectorFieldIntegrator::start()
 {
   mTimer.start();
   mKnots.clear();
+  mTrajectory = dart::common::make_unique<aikido::trajectory::Spline>(
+      mVectorField->getStateSpace());
   mCacheIndex = -1;
   mLastEvaluationTime = 0.0;
 }
@@ -84,6 +97,13 @@ std::vector<Knot>& VectorFieldIntegrator::getKnots()
   return mKnots;
 }
 
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline>
+VectorFieldIntegrator::releaseTrajectory()
+{
+  return std::move(mTrajectory);
+}
+
 //==============================================================================
 double VectorFieldIntegrator::getLastEvaluationTime()
 {
@@ -121,10 +141,12 @@ void VectorFieldIntegrator::check(const Eigen::VectorXd& q, double t)
 
   if (mKnots.size() > 1)
   {
-    auto trajSegment = convertToSpline(mKnots, mVectorField->getStateSpace());
+    // Only the new segment has to be added and checked, from where the
+    // previous check stopped.
+    appendToSpline(mKnots[mKnots.size() - 2], mKnots.back(), *mTrajectory);
 
     if (!mVectorField->evaluateTrajectory(
-            *trajSegment,
+            *mTrajectory,
             mConstraint,
             mConstraintCheckResolution,
             mLastEvaluationTime,
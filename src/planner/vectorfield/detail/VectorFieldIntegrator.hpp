@@ -32,7 +32,15 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
     const std::vector<Knot>& knots,
     aikido::statespace::ConstStateSpacePtr stateSpace);
 
-
+/// Append a segment between two consecutive knots to a trajectory.
+///
+/// \param[in] previousKnot Knot at the end of the trajectory.
+/// \param[in] knot Knot to append.
+/// \param[in,out] trajectory Trajectory to append the segment to.
+void appendToSpline(
+    const Knot& previousKnot,
+    const Knot& knot,
+    aikido::trajectory::Spline& trajectory);
 
 /// VectorField Planner generates a trajectory by following a vector field
 /// defined in joint space.
@@ -72,6 +80,12 @@ public:
   /// \return a list of knots.
   std::vector<Knot>& getKnots();
 
+  /// Release the trajectory through all knots stored in the integration.
+  /// The integrator must be restarted before it is used again.
+  ///
+  /// \return the trajectory.
+  std::unique_ptr<aikido::trajectory::Spline> releaseTrajectory();
+
   /// Get last evaluation time.
   ///
   /// \return last evaluation time.
@@ -112,6 +126,9 @@ protected:
 
   std::vector<Knot> mKnots;
 
+  /// Trajectory through mKnots, extended by one segment per knot.
+  std::unique_ptr<aikido::trajectory::Spline> mTrajectory;
+
   /// Resolution used in checking constraint satisfaction.
   double mConstraintCheckResolution;
 
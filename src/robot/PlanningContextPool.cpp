@@ -0,0 +1,241 @@
+#include "aikido/robot/PlanningContextPool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace aikido {
+namespace robot {
+
+namespace {
+
+//==============================================================================
+/// Returns true if the Skeletons of \c world and \c clone have the same names
+/// and structure, in the same order.
+bool hasSameSkeletons(const planner::World& world, const planner::World& clone)
+{
+  if (world.getNumSkeletons() != clone.getNumSkeletons())
+    return false;
+
+  for (std::size_t i = 0; i < world.getNumSkeletons(); ++i)
+  {
+    const auto skeleton = world.getSkeleton(i);
+    const auto clonedSkeleton = clone.getSkeleton(i);
+    if (skeleton->getName() != clonedSkeleton->getName()
+        || skeleton->getNumBodyNodes() != clonedSkeleton->getNumBodyNodes()
+        || skeleton->getNumDofs() != clonedSkeleton->getNumDofs())
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+//==============================================================================
+PlanningContextPool::Handle::Handle(
+    PlanningContextPool* pool, std::unique_ptr<PlanningContext> context)
+  : mPool(pool), mContext(std::move(context))
+{
+  // Do nothing
+}
+
+//==============================================================================
+PlanningContextPool::Handle::Handle(Handle&& other)
+  : mPool(other.mPool), mContext(std::move(other.mContext))
+{
+  // Do nothing
+}
+
+//==============================================================================
+PlanningContextPool::Handle::~Handle()
+{
+  if (mContext)
+    mPool->release(std::move(mContext));
+}
+
+//==============================================================================
+PlanningContext& PlanningContextPool::Handle::operator*() const
+{
+  return *mContext;
+}
+
+//==============================================================================
+PlanningContext* PlanningContextPool::Handle::operator->() const
+{
+  return mContext.get();
+}
+
+//==============================================================================
+PlanningContextPool::PlanningContextPool(
+    statespace::dart::MetaSkeletonStateSpacePtr space,
+    dart::dynamics::MetaSkeletonPtr metaSkeleton,
+    planner::WorldPtr world,
+    util::CollisionTestableFactory collisionTestableFactory,
+    std::size_t numContexts)
+  : mStateSpace(std::move(space))
+  , mMetaSkeleton(std::move(metaSkeleton))
+  , mWorld(std::move(world))
+  , mCollisionTestableFactory(std::move(collisionTestableFactory))
+  , mNumContexts(numContexts)
+{
+  if (!mStateSpace)
+    throw std::invalid_argument("StateSpace is nullptr.");
+
+  if (!mMetaSkeleton)
+    throw std::invalid_argument("MetaSkeleton is nullptr.");
+
+  if (!mWorld)
+    throw std::invalid_argument("World is nullptr.");
+
+  if (!mCollisionTestableFactory)
+    throw std::invalid_argument("CollisionTestableFactory is empty.");
+
+  mRobot = mMetaSkeleton->getBodyNode(0)->getSkeleton();
+  if (!mWorld->hasSkeleton(mRobot))
+    throw std::invalid_argument("World does not contain the robot.");
+
+  if (mNumContexts == 0)
+    mNumContexts = std::max(std::thread::hardware_concurrency(), 1u);
+
+  std::unique_lock<std::mutex> worldLock(mWorld->getMutex(), std::defer_lock);
+  std::unique_lock<std::mutex> robotLock(mRobot->getMutex(), std::defer_lock);
+  std::lock(worldLock, robotLock);
+
+  mAvailableContexts.reserve(mNumContexts);
+  for (std::size_t i = 0; i < mNumContexts; ++i)
+    mAvailableContexts.emplace_back(createContext());
+}
+
+//==============================================================================
+PlanningContextPool::Handle PlanningContextPool::acquire()
+{
+  std::unique_ptr<PlanningContext> context;
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mContextReturned.wait(lock, [this]() {
+      return !mAvailableContexts.empty();
+    });
+
+    context = std::move(mAvailableContexts.back());
+    mAvailableContexts.pop_back();
+  }
+
+  try
+  {
+    synchronize(*context);
+  }
+  catch (...)
+  {
+    release(std::move(context));
+    throw;
+  }
+
+  return Handle(this, std::move(context));
+}
+
+//==============================================================================
+std::vector<PlanningContextPool::Handle> PlanningContextPool::acquire(
+    std::size_t numContexts)
+{
+  if (numContexts > mNumContexts)
+  {
+    throw std::invalid_argument(
+        "Requested " + std::to_string(numContexts) + " contexts from a pool of "
+        + std::to_string(mNumContexts) + ".");
+  }
+
+  std::vector<Handle> handles;
+  handles.reserve(numContexts);
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mContextReturned.wait(lock, [this, numContexts]() {
+      return mAvailableContexts.size() >= numContexts;
+    });
+
+    for (std::size_t i = 0; i < numContexts; ++i)
+    {
+      handles.push_back(Handle(this, std::move(mAvailableContexts.back())));
+      mAvailableContexts.pop_back();
+    }
+  }
+
+  // The handles return the contexts to the pool if synchronizing throws.
+  for (auto& handle : handles)
+    synchronize(*handle);
+
+  return handles;
+}
+
+//==============================================================================
+std::size_t PlanningContextPool::getNumContexts() const
+{
+  return mNumContexts;
+}
+
+//==============================================================================
+const statespace::dart::MetaSkeletonStateSpacePtr&
+PlanningContextPool::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+const dart::dynamics::MetaSkeletonPtr& PlanningContextPool::getMetaSkeleton()
+    const
+{
+  return mMetaSkeleton;
+}
+
+//==============================================================================
+const planner::WorldPtr& PlanningContextPool::getWorld() const
+{
+  return mWorld;
+}
+
+//==============================================================================
+std::unique_ptr<PlanningContext> PlanningContextPool::createContext() const
+{
+  std::unique_ptr<PlanningContext> context(new PlanningContext);
+  context->mWorld = mWorld->clone();
+  context->mRobot = context->mWorld->getSkeleton(mRobot->getName());
+  context->mMetaSkeleton
+      = mStateSpace->getControlledMetaSkeleton(context->mRobot);
+  context->mCollisionTestable = mCollisionTestableFactory(
+      mStateSpace, context->mMetaSkeleton, context->mWorld);
+  if (!context->mCollisionTestable)
+    throw std::invalid_argument("CollisionTestableFactory returned nullptr.");
+
+  return context;
+}
+
+//==============================================================================
+void PlanningContextPool::synchronize(PlanningContext& context) const
+{
+  std::unique_lock<std::mutex> worldLock(mWorld->getMutex(), std::defer_lock);
+  std::unique_lock<std::mutex> robotLock(mRobot->getMutex(), std::defer_lock);
+  std::lock(worldLock, robotLock);
+
+  if (!hasSameSkeletons(*mWorld, *context.mWorld))
+  {
+    context = std::move(*createContext());
+    return;
+  }
+
+  context.mWorld->setState(mWorld->getState());
+}
+
+//==============================================================================
+void PlanningContextPool::release(std::unique_ptr<PlanningContext> context)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAvailableContexts.emplace_back(std::move(context));
+  }
+  // Waiters may need different numbers of contexts, so wake all of them.
+  mContextReturned.notify_all();
+}
+
+} // namespace robot
+} // namespace aikido
@@ -1,4 +1,12 @@
 #include "aikido/robot/util.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <thread>
 #include <dart/common/Console.hpp>
 #include <dart/common/StlHelpers.hpp>
 #include <dart/common/Timer.hpp>
@@ -16,11 +24,14 @@
 #include "aikido/distance/defaults.hpp"
 #include "aikido/planner/PlanningResult.hpp"
 #include "aikido/planner/SnapPlanner.hpp"
+#include "aikido/planner/ompl/BackwardCompatibility.hpp"
 #include "aikido/planner/ompl/CRRTConnect.hpp"
 #include "aikido/planner/ompl/Planner.hpp"
+#include "aikido/planner/ompl/RoadmapPlanner.hpp"
 #include "aikido/planner/parabolic/ParabolicSmoother.hpp"
 #include "aikido/planner/parabolic/ParabolicTimer.hpp"
 #include "aikido/planner/vectorfield/VectorFieldPlanner.hpp"
+#include "aikido/robot/PlanningContextPool.hpp"
 #include "aikido/statespace/GeodesicInterpolator.hpp"
 #include "aikido/statespace/StateSpace.hpp"
 #include "aikido/statespace/dart/MetaSkeletonStateSaver.hpp"
@@ -61,12 +72,238 @@ using dart::dynamics::SkeletonPtr;
 
 static const double collisionResolution = 0.1;
 
+namespace {
+
+/// Planning context of a parallel planning thread. Each thread plans on its own
+/// clone of the World, so that threads never share a Skeleton.
+struct ParallelPlanningContext
+{
+  planner::WorldPtr mWorld;
+  MetaSkeletonPtr mMetaSkeleton;
+  TestablePtr mCollisionTestable;
+  std::unique_ptr<RNG> mRng;
+
+  /// Goal sampler on the cloned robot, if planning to a goal region.
+  std::unique_ptr<constraint::SampleGenerator> mGoalGenerator;
+};
+
 //==============================================================================
-InterpolatedPtr planToConfiguration(
+std::vector<ParallelPlanningContext> createParallelPlanningContexts(
+    const MetaSkeletonStateSpacePtr& space,
+    const SkeletonPtr& robot,
+    const planner::WorldPtr& world,
+    const CollisionTestableFactory& collisionTestableFactory,
+    RNG* rng,
+    std::size_t numContexts)
+{
+  auto rngs = common::cloneRNGsFrom(*rng, numContexts);
+
+  std::vector<ParallelPlanningContext> contexts(numContexts);
+  for (std::size_t i = 0; i < numContexts; ++i)
+  {
+    auto& context = contexts[i];
+    context.mWorld = world->clone();
+    context.mMetaSkeleton = space->getControlledMetaSkeleton(
+        context.mWorld->getSkeleton(robot->getName()));
+    context.mCollisionTestable = collisionTestableFactory(
+        space, context.mMetaSkeleton, context.mWorld);
+    if (!context.mCollisionTestable)
+      throw std::invalid_argument("CollisionTestableFactory returned nullptr.");
+    context.mRng = std::move(rngs[i]);
+  }
+
+  return contexts;
+}
+
+//==============================================================================
+/// Runs \c work once on each context, each on its own thread. The calling
+/// thread uses the first context. If \c work throws, \c stop is set and the
+/// first exception is rethrown once all threads have finished.
+void runOnEachContext(
+    std::vector<ParallelPlanningContext>& contexts,
+    const std::function<void(ParallelPlanningContext&)>& work,
+    std::atomic<bool>& stop)
+{
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+
+  auto guardedWork = [&](ParallelPlanningContext& context) {
+    try
+    {
+      work(context);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if (!exception)
+        exception = std::current_exception();
+      stop = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(contexts.size() - 1);
+  for (std::size_t i = 1; i < contexts.size(); ++i)
+    threads.emplace_back(guardedWork, std::ref(contexts[i]));
+
+  guardedWork(contexts.front());
+
+  for (auto& thread : threads)
+    thread.join();
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+//==============================================================================
+/// Runs \c task for the indices [0, numTasks) on one thread per context.
+/// Threads stop picking up tasks once \c stop is set; it is set when a task
+/// succeeds if \c stopOnSuccess is true.
+void runInParallel(
+    std::vector<ParallelPlanningContext>& contexts,
+    std::size_t numTasks,
+    const std::function<bool(ParallelPlanningContext&, std::size_t)>& task,
+    bool stopOnSuccess,
+    std::atomic<bool>& stop)
+{
+  std::atomic<std::size_t> nextTask{0};
+
+  runOnEachContext(
+      contexts,
+      [&](ParallelPlanningContext& context) {
+        while (!stop.load())
+        {
+          const auto index = nextTask++;
+          if (index >= numTasks)
+            return;
+
+          if (task(context, index) && stopOnSuccess)
+            stop = true;
+        }
+      },
+      stop);
+}
+
+//==============================================================================
+double computePathLength(
+    const Interpolated& trajectory, const distance::DistanceMetric& metric)
+{
+  double length = 0.0;
+  for (std::size_t i = 1; i < trajectory.getNumWaypoints(); ++i)
+  {
+    length += metric.distance(
+        trajectory.getWaypoint(i - 1), trajectory.getWaypoint(i));
+  }
+  return length;
+}
+
+//==============================================================================
+/// Returns a condition that stops planning after \c timelimit seconds, or
+/// once \c stop is set if \c cancellable is true.
+::ompl::base::PlannerTerminationCondition createTerminationCondition(
+    double timelimit, const std::atomic<bool>& stop, bool cancellable)
+{
+  auto terminationCondition
+      = ::ompl::base::timedPlannerTerminationCondition(timelimit);
+  if (!cancellable)
+    return terminationCondition;
+
+  return ::ompl::base::plannerOrTerminationCondition(
+      terminationCondition,
+      ::ompl::base::PlannerTerminationCondition(
+          [&stop]() { return stop.load(); }));
+}
+
+//==============================================================================
+/// Plans with RRTConnect using the collision constraint of \c context.
+InterpolatedPtr planRRTConnect(
+    const MetaSkeletonStateSpacePtr& space,
+    const statespace::InterpolatorPtr& interpolator,
+    const distance::DistanceMetricPtr& distanceMetric,
+    ParallelPlanningContext& context,
+    const StateSpace::State* startState,
+    const StateSpace::State* goalState,
+    const ::ompl::base::PlannerTerminationCondition& terminationCondition)
+{
+  using planner::ompl::GeometricStateSpace;
+  using planner::ompl::ompl_make_shared;
+  using planner::ompl::ompl_static_pointer_cast;
+
+  auto si = planner::ompl::getSpaceInformation(
+      space,
+      interpolator,
+      distanceMetric,
+      createSampleableBounds(space, std::move(cloneRNGFrom(*context.mRng)[0])),
+      context.mCollisionTestable,
+      createTestableBounds(space),
+      createProjectableBounds(space),
+      collisionResolution);
+
+  auto pdef = ompl_make_shared<::ompl::base::ProblemDefinition>(si);
+  auto sspace
+      = ompl_static_pointer_cast<GeometricStateSpace>(si->getStateSpace());
+  auto start = sspace->allocState(startState);
+  auto goal = sspace->allocState(goalState);
+
+  // ProblemDefinition clones states and keeps them internally
+  pdef->setStartAndGoalStates(start, goal);
+
+  sspace->freeState(start);
+  sspace->freeState(goal);
+
+  return planner::ompl::planOMPL(
+      ompl_make_shared<ompl::geometric::RRTConnect>(si),
+      pdef,
+      space,
+      interpolator,
+      terminationCondition);
+}
+
+/// Goal configuration sampled from a goal region, ordered by its distance
+/// from the start configuration.
+struct GoalCandidate
+{
+  double mDistance;
+  Eigen::VectorXd mPositions;
+
+  bool operator>(const GoalCandidate& other) const
+  {
+    return mDistance > other.mDistance;
+  }
+};
+
+/// Queue that returns the goal candidate closest to the start first.
+using GoalCandidateQueue = std::priority_queue<
+    GoalCandidate,
+    std::vector<GoalCandidate>,
+    std::greater<GoalCandidate>>;
+
+//==============================================================================
+/// Returns the BodyNode of the robot in \c context with the name of
+/// \c bodyNode.
+BodyNodePtr findContextBodyNode(
+    const PlanningContext& context, const BodyNodePtr& bodyNode)
+{
+  if (!bodyNode)
+    throw std::invalid_argument("BodyNode is nullptr.");
+
+  auto contextBodyNode = context.mRobot->getBodyNode(bodyNode->getName());
+  if (!contextBodyNode)
+    throw std::invalid_argument(
+        "Robot has no BodyNode named '" + bodyNode->getName() + "'.");
+
+  return contextBodyNode;
+}
+
+//==============================================================================
+/// Plans as planToConfiguration does, checking the edges of the OMPL planner
+/// in parallel with \c workerCollisionTestables, if any.
+InterpolatedPtr planToConfigurationWithWorkers(
     const MetaSkeletonStateSpacePtr& space,
     const MetaSkeletonPtr& metaSkeleton,
     const StateSpace::State* goalState,
     const TestablePtr& collisionTestable,
+    std::vector<TestablePtr> workerCollisionTestables,
     RNG* rng,
     double timelimit)
 {
@@ -108,11 +345,101 @@ InterpolatedPtr planToConfiguration(
       createTestableBounds(space),
       createProjectableBounds(space),
       timelimit,
-      collisionResolution);
+      collisionResolution,
+      std::move(workerCollisionTestables));
 
   return untimedTrajectory;
 }
 
+
+} // namespace
+
+//==============================================================================
+InterpolatedPtr planToConfiguration(
+    const MetaSkeletonStateSpacePtr& space,
+    const MetaSkeletonPtr& metaSkeleton,
+    const StateSpace::State* goalState,
+    const TestablePtr& collisionTestable,
+    RNG* rng,
+    double timelimit)
+{
+  return planToConfigurationWithWorkers(
+      space,
+      metaSkeleton,
+      goalState,
+      collisionTestable,
+      std::vector<TestablePtr>(),
+      rng,
+      timelimit);
+}
+
+//==============================================================================
+InterpolatedPtr planToConfigurationLazy(
+    planner::ompl::RoadmapPlanner& roadmapPlanner,
+    const StateSpace::State* goalState,
+    double timelimit)
+{
+  using planner::planSnap;
+
+  const auto& space = roadmapPlanner.getStateSpace();
+  const auto& metaSkeleton = roadmapPlanner.getMetaSkeleton();
+  auto startState = space->createState();
+
+  {
+    auto robot = metaSkeleton->getBodyNode(0)->getSkeleton();
+    std::lock_guard<std::mutex> lock(robot->getMutex());
+    // Save the current state of the space
+    auto saver = MetaSkeletonStateSaver(metaSkeleton);
+    DART_UNUSED(saver);
+
+    space->getState(metaSkeleton.get(), startState);
+
+    // First test with Snap Planner
+    planner::PlanningResult pResult;
+    auto untimedTrajectory = planSnap(
+        space,
+        startState,
+        goalState,
+        roadmapPlanner.getInterpolator(),
+        roadmapPlanner.getCollisionTestable(),
+        pResult);
+
+    // Return if the trajectory is non-empty
+    if (untimedTrajectory)
+      return untimedTrajectory;
+  }
+
+  // The planner locks the robot itself.
+  return roadmapPlanner.plan(startState, goalState, timelimit);
+}
+
+//==============================================================================
+InterpolatedPtr planToConfiguration(
+    PlanningContextPool& pool,
+    const StateSpace::State* goalState,
+    RNG* rng,
+    double timelimit,
+    std::size_t numEdgeCheckWorkers)
+{
+  // Each worker checks edges on a context of its own.
+  auto contexts = pool.acquire(numEdgeCheckWorkers + 1);
+  const auto& context = contexts.front();
+
+  std::vector<TestablePtr> workerCollisionTestables;
+  workerCollisionTestables.reserve(numEdgeCheckWorkers);
+  for (std::size_t i = 1; i < contexts.size(); ++i)
+    workerCollisionTestables.emplace_back(contexts[i]->mCollisionTestable);
+
+  return planToConfigurationWithWorkers(
+      pool.getStateSpace(),
+      context->mMetaSkeleton,
+      goalState,
+      context->mCollisionTestable,
+      std::move(workerCollisionTestables),
+      rng,
+      timelimit);
+}
+
 //==============================================================================
 InterpolatedPtr planToConfigurations(
     const MetaSkeletonStateSpacePtr& space,
@@ -132,13 +459,11 @@ InterpolatedPtr planToConfigurations(
 
   auto startState = space->getScopedStateFromMetaSkeleton(metaSkeleton.get());
 
+  // First test all goals with Snap Planner
   for (const auto& goalState : goalStates)
   {
-    // First test with Snap Planner
     planner::PlanningResult pResult;
-    InterpolatedPtr untimedTrajectory;
-
-    untimedTrajectory = planner::planSnap(
+    auto untimedTrajectory = planner::planSnap(
         space,
         startState,
         goalState,
@@ -149,8 +474,11 @@ InterpolatedPtr planToConfigurations(
     // Return if the trajectory is non-empty
     if (untimedTrajectory)
       return untimedTrajectory;
+  }
 
-    untimedTrajectory = planOMPL<ompl::geometric::RRTConnect>(
+  for (const auto& goalState : goalStates)
+  {
+    auto untimedTrajectory = planOMPL<ompl::geometric::RRTConnect>(
         startState,
         goalState,
         space,
@@ -163,12 +491,126 @@ InterpolatedPtr planToConfigurations(
         timelimit,
         collisionResolution);
 
-    return untimedTrajectory;
+    if (untimedTrajectory)
+      return untimedTrajectory;
   }
 
   return nullptr;
 }
 
+//==============================================================================
+InterpolatedPtr planToConfigurationsParallel(
+    const MetaSkeletonStateSpacePtr& space,
+    const MetaSkeletonPtr& metaSkeleton,
+    const std::vector<StateSpace::State*>& goalStates,
+    const planner::WorldPtr& world,
+    const CollisionTestableFactory& collisionTestableFactory,
+    RNG* rng,
+    double timelimit,
+    const ParallelPlannerParameters& parameters)
+{
+  if (!world)
+    throw std::invalid_argument("World is nullptr.");
+
+  if (!collisionTestableFactory)
+    throw std::invalid_argument("CollisionTestableFactory is empty.");
+
+  auto robot = metaSkeleton->getBodyNode(0)->getSkeleton();
+  if (!world->hasSkeleton(robot))
+    throw std::invalid_argument("World does not contain the robot.");
+
+  if (goalStates.empty())
+    return nullptr;
+
+  std::size_t numWorkers = parameters.numWorkers;
+  if (numWorkers == 0)
+    numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+  numWorkers = std::min(numWorkers, goalStates.size());
+
+  // Clone the World while nobody else modifies it. Planning itself only uses
+  // the clones, so the robot is not locked while planning.
+  auto startState = space->createState();
+  std::vector<ParallelPlanningContext> contexts;
+  {
+    std::unique_lock<std::mutex> worldLock(world->getMutex(), std::defer_lock);
+    std::unique_lock<std::mutex> robotLock(robot->getMutex(), std::defer_lock);
+    std::lock(worldLock, robotLock);
+
+    space->getState(metaSkeleton.get(), startState);
+    contexts = createParallelPlanningContexts(
+        space, robot, world, collisionTestableFactory, rng, numWorkers);
+  }
+
+  auto interpolator = std::make_shared<GeodesicInterpolator>(space);
+  distance::DistanceMetricPtr distanceMetric = createDistanceMetric(space);
+  std::vector<InterpolatedPtr> solutions(goalStates.size());
+
+  // First race Snap Planner to all goals
+  std::atomic<bool> stop{false};
+  runInParallel(
+      contexts,
+      goalStates.size(),
+      [&](ParallelPlanningContext& context, std::size_t index) {
+        planner::PlanningResult pResult;
+        solutions[index] = planner::planSnap(
+            space,
+            startState,
+            goalStates[index],
+            interpolator,
+            context.mCollisionTestable,
+            pResult);
+        return solutions[index] != nullptr;
+      },
+      parameters.returnFirstSolution,
+      stop);
+
+  const bool snapSucceeded = std::any_of(
+      solutions.begin(), solutions.end(), [](const InterpolatedPtr& solution) {
+        return solution != nullptr;
+      });
+
+  if (!snapSucceeded)
+  {
+    // Plan with RRTConnect to several goals at once. Planners that are still
+    // running when another one succeeds are cancelled.
+    runInParallel(
+        contexts,
+        goalStates.size(),
+        [&](ParallelPlanningContext& context, std::size_t index) {
+          solutions[index] = planRRTConnect(
+              space,
+              interpolator,
+              distanceMetric,
+              context,
+              startState,
+              goalStates[index],
+              createTerminationCondition(
+                  timelimit, stop, parameters.returnFirstSolution));
+          return solutions[index] != nullptr;
+        },
+        parameters.returnFirstSolution,
+        stop);
+  }
+
+  // Return the shortest of the solutions that were found
+  InterpolatedPtr bestSolution;
+  double bestLength = std::numeric_limits<double>::infinity();
+  for (const auto& solution : solutions)
+  {
+    if (!solution)
+      continue;
+
+    const double length = computePathLength(*solution, *distanceMetric);
+    if (!bestSolution || length < bestLength)
+    {
+      bestSolution = solution;
+      bestLength = length;
+    }
+  }
+
+  return bestSolution;
+}
+
 //==============================================================================
 InterpolatedPtr planToTSR(
     const MetaSkeletonStateSpacePtr& space,
@@ -270,6 +712,231 @@ InterpolatedPtr planToTSR(
   return nullptr;
 }
 
+//==============================================================================
+InterpolatedPtr planToTSR(
+    PlanningContextPool& pool,
+    const BodyNodePtr& bodyNode,
+    const TSRPtr& tsr,
+    RNG* rng,
+    double timelimit,
+    std::size_t maxNumTrials)
+{
+  auto context = pool.acquire();
+  auto contextBodyNode = findContextBodyNode(*context, bodyNode);
+
+  // The TSR keeps the state of its sampler, so each context uses a copy.
+  return planToTSR(
+      pool.getStateSpace(),
+      context->mMetaSkeleton,
+      contextBodyNode,
+      std::make_shared<TSR>(*tsr),
+      context->mCollisionTestable,
+      rng,
+      timelimit,
+      maxNumTrials);
+}
+
+//==============================================================================
+InterpolatedPtr planToTSRParallel(
+    const MetaSkeletonStateSpacePtr& space,
+    const MetaSkeletonPtr& metaSkeleton,
+    const BodyNodePtr& bn,
+    const TSRPtr& tsr,
+    const planner::WorldPtr& world,
+    const CollisionTestableFactory& collisionTestableFactory,
+    RNG* rng,
+    double timelimit,
+    std::size_t maxNumTrials,
+    const ParallelPlannerParameters& parameters)
+{
+  if (!world)
+    throw std::invalid_argument("World is nullptr.");
+
+  if (!collisionTestableFactory)
+    throw std::invalid_argument("CollisionTestableFactory is empty.");
+
+  auto robot = metaSkeleton->getBodyNode(0)->getSkeleton();
+  if (!world->hasSkeleton(robot))
+    throw std::invalid_argument("World does not contain the robot.");
+
+  std::size_t numWorkers = parameters.numWorkers;
+  if (numWorkers == 0)
+    numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+
+  // Clone the World while nobody else modifies it. Planning itself only uses
+  // the clones, so the robot is not locked while planning.
+  auto startState = space->createState();
+  std::vector<ParallelPlanningContext> contexts;
+  {
+    std::unique_lock<std::mutex> worldLock(world->getMutex(), std::defer_lock);
+    std::unique_lock<std::mutex> robotLock(robot->getMutex(), std::defer_lock);
+    std::lock(worldLock, robotLock);
+
+    space->getState(metaSkeleton.get(), startState);
+    contexts = createParallelPlanningContexts(
+        space, robot, world, collisionTestableFactory, rng, numWorkers);
+  }
+
+  // Convert TSR constraint into an IK constraint on each cloned robot. Each
+  // clone samples the TSR and the IK seeds from its own random stream.
+  std::vector<std::shared_ptr<InverseKinematicsSampleable>> ikSampleables;
+  ikSampleables.reserve(numWorkers);
+  for (auto& context : contexts)
+  {
+    auto clonedBodyNode
+        = context.mWorld->getSkeleton(robot->getName())->getBodyNode(
+            bn->getName());
+    if (!clonedBodyNode)
+      throw std::invalid_argument("BodyNode is not part of the robot.");
+
+    auto clonedTsr = std::make_shared<TSR>(*tsr);
+    clonedTsr->setRNG(std::move(cloneRNGFrom(*context.mRng)[0]));
+
+    ikSampleables.emplace_back(
+        std::make_shared<InverseKinematicsSampleable>(
+            space,
+            context.mMetaSkeleton,
+            std::move(clonedTsr),
+            createSampleableBounds(
+                space, std::move(cloneRNGFrom(*context.mRng)[0])),
+            InverseKinematics::create(clonedBodyNode),
+            maxNumTrials));
+    context.mGoalGenerator = ikSampleables.back()->createSampleGenerator();
+  }
+
+  auto interpolator = std::make_shared<GeodesicInterpolator>(space);
+  distance::DistanceMetricPtr distanceMetric = createDistanceMetric(space);
+
+  // Each RRTConnect attempt gets the same share of the time limit as in
+  // planToTSR, so that a single unreachable goal cannot use all of it.
+  const double timelimitPerSample = timelimit / maxNumTrials;
+
+  // Number of goals tried with Snap Planner before switching to RRTConnect,
+  // as in planToTSR.
+  static const std::size_t maxSnapSamples{100};
+
+  // Goals sampled by all workers. Goals closer to the start are tried first,
+  // with Snap Planner while the snap budget lasts and with RRTConnect after.
+  std::mutex queueMutex;
+  GoalCandidateQueue snapQueue;
+  GoalCandidateQueue rrtQueue;
+  std::size_t numSnapAttempts = 0;
+
+  std::atomic<bool> stop{false};
+  InterpolatedPtr solution;
+
+  // The deadline is shared by all workers, so use a clock that is safe to
+  // query concurrently.
+  using Clock = std::chrono::steady_clock;
+  const auto deadline = Clock::now()
+                        + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(timelimit));
+  auto getRemainingTime = [&deadline]() {
+    return std::chrono::duration<double>(deadline - Clock::now()).count();
+  };
+
+  runOnEachContext(
+      contexts,
+      [&](ParallelPlanningContext& context) {
+        auto goalState = space->createState();
+        auto& generator = *context.mGoalGenerator;
+
+        while (!stop.load() && getRemainingTime() > 0.0)
+        {
+          // Sample a goal on this worker's clone of the robot
+          if (generator.canSample() && generator.sample(goalState))
+          {
+            GoalCandidate candidate;
+            candidate.mDistance
+                = distanceMetric->distance(startState, goalState);
+            space->convertStateToPositions(goalState, candidate.mPositions);
+
+            std::lock_guard<std::mutex> lock(queueMutex);
+            snapQueue.emplace(std::move(candidate));
+          }
+
+          // Take the most promising goal sampled by any worker
+          GoalCandidate candidate;
+          bool useSnap = false;
+          {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!snapQueue.empty() && numSnapAttempts < maxSnapSamples)
+            {
+              candidate = snapQueue.top();
+              snapQueue.pop();
+              ++numSnapAttempts;
+              useSnap = true;
+            }
+            else if (!rrtQueue.empty())
+            {
+              candidate = rrtQueue.top();
+              rrtQueue.pop();
+            }
+            else if (!snapQueue.empty())
+            {
+              candidate = snapQueue.top();
+              snapQueue.pop();
+            }
+            else if (!generator.canSample())
+            {
+              return;
+            }
+            else
+            {
+              continue;
+            }
+          }
+
+          space->convertPositionsToState(candidate.mPositions, goalState);
+
+          InterpolatedPtr trajectory;
+          if (useSnap)
+          {
+            planner::PlanningResult pResult;
+            trajectory = planner::planSnap(
+                space,
+                startState,
+                goalState,
+                interpolator,
+                context.mCollisionTestable,
+                pResult);
+
+            if (!trajectory)
+            {
+              std::lock_guard<std::mutex> lock(queueMutex);
+              rrtQueue.emplace(std::move(candidate));
+            }
+          }
+          else
+          {
+            trajectory = planRRTConnect(
+                space,
+                interpolator,
+                distanceMetric,
+                context,
+                startState,
+                goalState,
+                createTerminationCondition(
+                    std::min(timelimitPerSample, getRemainingTime()),
+                    stop,
+                    true));
+          }
+
+          if (trajectory)
+          {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!solution)
+              solution = std::move(trajectory);
+            stop = true;
+            return;
+          }
+        }
+      },
+      stop);
+
+  return solution;
+}
+
 //==============================================================================
 InterpolatedPtr planToTSRwithTrajectoryConstraint(
     const MetaSkeletonStateSpacePtr& space,
@@ -362,6 +1029,29 @@ InterpolatedPtr planToTSRwithTrajectoryConstraint(
   return traj;
 }
 
+//==============================================================================
+InterpolatedPtr planToTSRwithTrajectoryConstraint(
+    PlanningContextPool& pool,
+    const dart::dynamics::BodyNodePtr& bodyNode,
+    const TSRPtr& goalTsr,
+    const TSRPtr& constraintTsr,
+    double timelimit,
+    const CRRTPlannerParameters& crrtParameters)
+{
+  auto context = pool.acquire();
+  auto contextBodyNode = findContextBodyNode(*context, bodyNode);
+
+  return planToTSRwithTrajectoryConstraint(
+      pool.getStateSpace(),
+      context->mMetaSkeleton,
+      contextBodyNode,
+      std::make_shared<TSR>(*goalTsr),
+      std::make_shared<TSR>(*constraintTsr),
+      context->mCollisionTestable,
+      timelimit,
+      crrtParameters);
+}
+
 //==============================================================================
 trajectory::TrajectoryPtr planToEndEffectorOffset(
     const MetaSkeletonStateSpacePtr& space,
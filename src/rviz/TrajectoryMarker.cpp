@@ -3,6 +3,7 @@
 #include "aikido/rviz/shape_conversions.hpp"
 #include "aikido/statespace/dart/MetaSkeletonStateSaver.hpp"
 #include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
+#include "aikido/trajectory/Spline.hpp"
 
 namespace aikido {
 namespace rviz {
@@ -227,11 +228,22 @@ void TrajectoryMarker::updatePoints()
   double t = mTrajectory->getStartTime();
   const double dt = mTrajectory->getDuration() / mNumLineSegments;
 
+  // Splines are swept with a cursor to avoid searching for each segment.
+  std::unique_ptr<trajectory::Spline::Cursor> splineCursor;
+  if (auto spline
+      = std::dynamic_pointer_cast<const trajectory::Spline>(mTrajectory))
+  {
+    splineCursor.reset(new trajectory::Spline::Cursor(std::move(spline)));
+  }
+
   points.reserve(mNumLineSegments + 1u);
   Eigen::Vector3d pose;
   for (std::size_t i = 0u; i < mNumLineSegments - 1u; ++i)
   {
-    mTrajectory->evaluate(t, state);
+    if (splineCursor)
+      splineCursor->evaluate(t, state);
+    else
+      mTrajectory->evaluate(t, state);
     metaSkeletonSs->setState(mSkeleton.get(), state);
     pose = mFrame.getTransform().translation();
     points.emplace_back(convertEigenToROSPoint(pose));
@@ -1,15 +1,122 @@
 #include <aikido/statespace/GeodesicInterpolator.hpp>
 
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+
 namespace aikido {
 namespace statespace {
 
+namespace {
+
+//==============================================================================
+template <int N>
+bool appendVectorCoordinates(
+    const StateSpace& _space,
+    std::size_t _offset,
+    std::vector<std::size_t>& _offsets)
+{
+  const auto space = dynamic_cast<const R<N>*>(&_space);
+  if (!space)
+    return false;
+
+  for (std::size_t i = 0; i < space->getDimension(); ++i)
+    _offsets.emplace_back(_offset + i * sizeof(double));
+
+  return true;
+}
+
+} // namespace
+
+//==============================================================================
+/// Edge that composes its start state with a scaled, precomputed tangent
+/// vector.
+class GeodesicInterpolator::GeodesicEdge : public Interpolator::Edge
+{
+public:
+  GeodesicEdge(
+      const GeodesicInterpolator* _interpolator,
+      const StateSpace::State* _from,
+      const StateSpace::State* _to)
+    : mStateSpace(_interpolator->getStateSpace())
+    , mFrom(mStateSpace->createState())
+    , mRelativeState(mStateSpace->createState())
+    , mTangentVector(_interpolator->getTangentVector(_from, _to))
+    , mScaledTangentVector(mTangentVector.size())
+  {
+    mStateSpace->copyState(_from, mFrom);
+  }
+
+  void interpolate(double _alpha, StateSpace::State* _state) override
+  {
+    mScaledTangentVector.noalias() = _alpha * mTangentVector;
+    mStateSpace->expMap(mScaledTangentVector, mRelativeState);
+    mStateSpace->compose(mFrom, mRelativeState, _state);
+  }
+
+private:
+  StateSpacePtr mStateSpace;
+  StateSpace::ScopedState mFrom;
+  StateSpace::ScopedState mRelativeState;
+  Eigen::VectorXd mTangentVector;
+  Eigen::VectorXd mScaledTangentVector;
+};
+
+//==============================================================================
+/// Edge that linearly interpolates the coordinates of states in place.
+class GeodesicInterpolator::LinearEdge : public Interpolator::Edge
+{
+public:
+  LinearEdge(
+      const GeodesicInterpolator* _interpolator,
+      const StateSpace::State* _from,
+      const StateSpace::State* _to)
+    : mCoordinates(_interpolator->mLinearCoordinates)
+    , mFrom(mCoordinates.size())
+    , mTangentVector(_interpolator->getTangentVector(_from, _to))
+  {
+    const auto from = reinterpret_cast<const char*>(_from);
+    for (std::size_t i = 0; i < mCoordinates.size(); ++i)
+    {
+      const auto coordinate = from + mCoordinates[i].mOffset;
+      if (mCoordinates[i].mIsAngle)
+        mFrom[i] = reinterpret_cast<const SO2::State*>(coordinate)->getAngle();
+      else
+        mFrom[i] = *reinterpret_cast<const double*>(coordinate);
+    }
+  }
+
+  void interpolate(double _alpha, StateSpace::State* _state) override
+  {
+    const auto state = reinterpret_cast<char*>(_state);
+    for (std::size_t i = 0; i < mCoordinates.size(); ++i)
+    {
+      const auto coordinate = state + mCoordinates[i].mOffset;
+      const auto value = mFrom[i] + _alpha * mTangentVector[i];
+      if (mCoordinates[i].mIsAngle)
+        reinterpret_cast<SO2::State*>(coordinate)->setAngle(value);
+      else
+        *reinterpret_cast<double*>(coordinate) = value;
+    }
+  }
+
+private:
+  const std::vector<LinearCoordinate>& mCoordinates;
+  Eigen::VectorXd mFrom;
+  Eigen::VectorXd mTangentVector;
+};
+
 //==============================================================================
 GeodesicInterpolator::GeodesicInterpolator(
     statespace::StateSpacePtr _stateSpace)
-  : mStateSpace(std::move(_stateSpace))
+  : mStateSpace(std::move(_stateSpace)), mIsLinear(false)
 {
   if (!mStateSpace)
     throw std::invalid_argument("StateSpace is null.");
+
+  mIsLinear = getLinearCoordinates(*mStateSpace, 0, mLinearCoordinates);
+  if (!mIsLinear)
+    mLinearCoordinates.clear();
 }
 
 //==============================================================================
@@ -75,5 +182,68 @@ void GeodesicInterpolator::getDerivative(
   }
 }
 
+//==============================================================================
+std::unique_ptr<Interpolator::Edge> GeodesicInterpolator::prepareEdge(
+    const statespace::StateSpace::State* _from,
+    const statespace::StateSpace::State* _to) const
+{
+  if (mIsLinear)
+    return std::unique_ptr<Edge>(new LinearEdge(this, _from, _to));
+  else
+    return std::unique_ptr<Edge>(new GeodesicEdge(this, _from, _to));
+}
+
+//==============================================================================
+bool GeodesicInterpolator::getLinearCoordinates(
+    const StateSpace& _space,
+    std::size_t _offset,
+    std::vector<LinearCoordinate>& _coordinates)
+{
+  // Rn composes by addition, and SO2 by adding angles without wrapping, so
+  // both interpolate linearly in the values stored in their states.
+  std::vector<std::size_t> vectorOffsets;
+  if (appendVectorCoordinates<0>(_space, _offset, vectorOffsets)
+      || appendVectorCoordinates<1>(_space, _offset, vectorOffsets)
+      || appendVectorCoordinates<2>(_space, _offset, vectorOffsets)
+      || appendVectorCoordinates<3>(_space, _offset, vectorOffsets)
+      || appendVectorCoordinates<6>(_space, _offset, vectorOffsets)
+      || appendVectorCoordinates<Eigen::Dynamic>(
+             _space, _offset, vectorOffsets))
+  {
+    for (const auto offset : vectorOffsets)
+      _coordinates.push_back(LinearCoordinate{offset, false});
+    return true;
+  }
+
+  if (dynamic_cast<const SO2*>(&_space))
+  {
+    _coordinates.push_back(LinearCoordinate{_offset, true});
+    return true;
+  }
+
+  const auto product = dynamic_cast<const CartesianProduct*>(&_space);
+  if (!product)
+    return false;
+
+  // The tangent space of a CartesianProduct concatenates the tangent spaces
+  // of its subspaces, in order.
+  const auto probeState = product->createState();
+  const auto probeBuffer = reinterpret_cast<const char*>(probeState.getState());
+
+  for (std::size_t i = 0; i < product->getNumSubspaces(); ++i)
+  {
+    const auto substate = reinterpret_cast<const char*>(
+        product->getSubState<>(probeState.getState(), i));
+
+    if (!getLinearCoordinates(
+            *product->getSubspace<>(i),
+            _offset + (substate - probeBuffer),
+            _coordinates))
+      return false;
+  }
+
+  return true;
+}
+
 } // namespace statespace
 } // namespace aikido
@@ -0,0 +1,47 @@
+#include "aikido/statespace/Interpolator.hpp"
+
+namespace aikido {
+namespace statespace {
+
+namespace {
+
+//==============================================================================
+/// Edge that calls \c Interpolator::interpolate with copies of its states.
+class InterpolatorEdge : public Interpolator::Edge
+{
+public:
+  InterpolatorEdge(
+      const Interpolator* _interpolator,
+      const StateSpace::State* _from,
+      const StateSpace::State* _to)
+    : mInterpolator(_interpolator)
+    , mFrom(_interpolator->getStateSpace()->createState())
+    , mTo(_interpolator->getStateSpace()->createState())
+  {
+    const auto stateSpace = mInterpolator->getStateSpace();
+    stateSpace->copyState(_from, mFrom);
+    stateSpace->copyState(_to, mTo);
+  }
+
+  void interpolate(double _alpha, StateSpace::State* _state) override
+  {
+    mInterpolator->interpolate(mFrom, mTo, _alpha, _state);
+  }
+
+private:
+  const Interpolator* mInterpolator;
+  StateSpace::ScopedState mFrom;
+  StateSpace::ScopedState mTo;
+};
+
+} // namespace
+
+//==============================================================================
+std::unique_ptr<Interpolator::Edge> Interpolator::prepareEdge(
+    const StateSpace::State* _from, const StateSpace::State* _to) const
+{
+  return std::unique_ptr<Edge>(new InterpolatorEdge(this, _from, _to));
+}
+
+} // namespace statespace
+} // namespace aikido
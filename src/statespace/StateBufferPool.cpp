@@ -0,0 +1,140 @@
+#include "aikido/statespace/StateBufferPool.hpp"
+
+#include <vector>
+
+namespace aikido {
+namespace statespace {
+
+namespace {
+
+/// Buffer sizes are rounded up to a multiple of this many bytes, so that all
+/// buffers in a bucket are interchangeable.
+constexpr std::size_t BUCKET_GRANULARITY{16};
+
+//==============================================================================
+std::size_t getBucketIndex(std::size_t size)
+{
+  return (size + BUCKET_GRANULARITY - 1) / BUCKET_GRANULARITY;
+}
+
+//==============================================================================
+struct ThreadLocalBuckets
+{
+  ThreadLocalBuckets()
+    : mBuckets(getBucketIndex(StateBufferPool::MAX_POOLED_SIZE) + 1)
+  {
+    // Do nothing
+  }
+
+  ~ThreadLocalBuckets();
+
+  void clear()
+  {
+    for (auto& bucket : mBuckets)
+    {
+      for (char* buffer : bucket)
+        delete[] buffer;
+      bucket.clear();
+    }
+  }
+
+  std::vector<std::vector<char*>> mBuckets;
+};
+
+// Set once the buckets of this thread have been destroyed. This is trivially
+// destructible, so it remains accessible to states that outlive the buckets,
+// e.g. states with static storage duration.
+thread_local bool tBucketsDestroyed = false;
+
+//==============================================================================
+ThreadLocalBuckets::~ThreadLocalBuckets()
+{
+  clear();
+  tBucketsDestroyed = true;
+}
+
+//==============================================================================
+ThreadLocalBuckets* getThreadLocalBuckets()
+{
+  if (tBucketsDestroyed)
+    return nullptr;
+
+  thread_local ThreadLocalBuckets buckets;
+  return &buckets;
+}
+
+} // namespace
+
+//==============================================================================
+// Required for odr-use.
+constexpr std::size_t StateBufferPool::MAX_POOLED_SIZE;
+constexpr std::size_t StateBufferPool::MAX_BUFFERS_PER_BUCKET;
+
+//==============================================================================
+char* StateBufferPool::acquire(std::size_t size)
+{
+  if (size > MAX_POOLED_SIZE)
+    return new char[size];
+
+  const auto index = getBucketIndex(size);
+  auto buckets = getThreadLocalBuckets();
+  if (buckets)
+  {
+    auto& bucket = buckets->mBuckets[index];
+    if (!bucket.empty())
+    {
+      char* buffer = bucket.back();
+      bucket.pop_back();
+      return buffer;
+    }
+  }
+
+  return new char[index * BUCKET_GRANULARITY];
+}
+
+//==============================================================================
+void StateBufferPool::release(char* buffer, std::size_t size)
+{
+  if (!buffer)
+    return;
+
+  if (size <= MAX_POOLED_SIZE)
+  {
+    auto buckets = getThreadLocalBuckets();
+    if (buckets)
+    {
+      auto& bucket = buckets->mBuckets[getBucketIndex(size)];
+      if (bucket.size() < MAX_BUFFERS_PER_BUCKET)
+      {
+        bucket.push_back(buffer);
+        return;
+      }
+    }
+  }
+
+  delete[] buffer;
+}
+
+//==============================================================================
+void StateBufferPool::clear()
+{
+  auto buckets = getThreadLocalBuckets();
+  if (buckets)
+    buckets->clear();
+}
+
+//==============================================================================
+std::size_t StateBufferPool::getNumCachedBuffers()
+{
+  auto buckets = getThreadLocalBuckets();
+  if (!buckets)
+    return 0u;
+
+  std::size_t count = 0u;
+  for (const auto& bucket : buckets->mBuckets)
+    count += bucket.size();
+  return count;
+}
+
+} // namespace statespace
+} // namespace aikido
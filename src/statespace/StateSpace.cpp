@@ -1,5 +1,7 @@
 #include "aikido/statespace/StateSpace.hpp"
 
+#include "aikido/statespace/StateBufferPool.hpp"
+
 namespace aikido {
 namespace statespace {
 
@@ -28,13 +30,15 @@ void StateSpace::getInverse(State* _state) const
 //==============================================================================
 auto StateSpace::allocateState() const -> State*
 {
-  return allocateStateInBuffer(new char[getStateSizeInBytes()]);
+  return allocateStateInBuffer(
+      StateBufferPool::acquire(getStateSizeInBytes()));
 }
 
 //==============================================================================
 void StateSpace::freeState(StateSpace::State* _state) const
 {
-  delete[] reinterpret_cast<char*>(_state);
+  StateBufferPool::release(
+      reinterpret_cast<char*>(_state), getStateSizeInBytes());
 }
 
 } // namespace statespace
@@ -4,6 +4,8 @@
 #include <dart/common/Console.hpp>
 #include <dart/common/StlHelpers.hpp>
 #include "aikido/statespace/dart/JointStateSpaceHelpers.hpp"
+#include "aikido/statespace/dart/RnJoint.hpp"
+#include "aikido/statespace/dart/SO2Joint.hpp"
 
 namespace aikido {
 namespace statespace {
@@ -73,6 +75,16 @@ std::vector<std::shared_ptr<JointStateSpace>> createStateSpace(
   return spaces;
 }
 
+//==============================================================================
+bool isRJoint(const JointStateSpace* space)
+{
+  return dynamic_cast<const R0Joint*>(space)
+         || dynamic_cast<const R1Joint*>(space)
+         || dynamic_cast<const R2Joint*>(space)
+         || dynamic_cast<const R3Joint*>(space)
+         || dynamic_cast<const R6Joint*>(space);
+}
+
 } // namespace
 
 //==============================================================================
@@ -249,8 +261,52 @@ MetaSkeletonStateSpace::MetaSkeletonStateSpace(const MetaSkeleton* metaskeleton)
         convertVectorType<JointStateSpacePtr, StateSpacePtr>(
             createStateSpace(*metaskeleton)))
   , mProperties(MetaSkeletonStateSpace::Properties(metaskeleton))
+  , mIsContiguous(true)
 {
-  // Do nothing.
+  const auto numJoints = getNumSubspaces();
+  mJointSpaces.reserve(numJoints);
+  mJointStorage.reserve(numJoints);
+  mSubStateOffsets.reserve(numJoints);
+  mJointDofOffsets.reserve(numJoints + 1);
+  mDofIndices.reserve(mProperties.getNumDofs());
+
+  // Flatten the DOF indices and substate offsets, so conversions neither look
+  // up the index map nor cast the subspaces.
+  const auto probeState = createState();
+  const auto probeBuffer = reinterpret_cast<const char*>(probeState.getState());
+
+  for (std::size_t ijoint = 0; ijoint < numJoints; ++ijoint)
+  {
+    const auto subspace = getSubspace<JointStateSpace>(ijoint).get();
+    const auto numJointDofs = subspace->getProperties().getNumDofs();
+    const auto substate = reinterpret_cast<const char*>(
+        getSubState<>(probeState.getState(), ijoint));
+
+    mJointSpaces.emplace_back(subspace);
+    mSubStateOffsets.emplace_back(substate - probeBuffer);
+    mJointDofOffsets.emplace_back(mDofIndices.size());
+
+    if (isRJoint(subspace))
+      mJointStorage.emplace_back(JointStorage::Vector);
+    else if (dynamic_cast<const SO2Joint*>(subspace))
+      mJointStorage.emplace_back(JointStorage::Angle);
+    else
+      mJointStorage.emplace_back(JointStorage::Generic);
+
+    for (std::size_t idof = 0; idof < numJointDofs; ++idof)
+    {
+      const auto dofIndex = mProperties.getDofIndex(ijoint, idof);
+      const auto stateOffset = mSubStateOffsets.back() + idof * sizeof(double);
+
+      mIsContiguous = mIsContiguous
+                      && mJointStorage.back() == JointStorage::Vector
+                      && dofIndex == mDofIndices.size()
+                      && stateOffset == dofIndex * sizeof(double);
+      mDofIndices.emplace_back(dofIndex);
+    }
+  }
+
+  mJointDofOffsets.emplace_back(mDofIndices.size());
 }
 
 //==============================================================================
@@ -304,21 +360,52 @@ void MetaSkeletonStateSpace::checkIfContained(
 void MetaSkeletonStateSpace::convertPositionsToState(
     const Eigen::VectorXd& _positions, State* _state) const
 {
-  if (static_cast<std::size_t>(_positions.size()) != mProperties.getNumDofs())
+  const auto numDofs = mProperties.getNumDofs();
+  if (static_cast<std::size_t>(_positions.size()) != numDofs)
     throw std::invalid_argument("Incorrect number of positions.");
 
-  for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
+  const auto stateBuffer = reinterpret_cast<char*>(_state);
+
+  if (mIsContiguous)
   {
-    const auto subspace = getSubspace<JointStateSpace>(isubspace);
-    const auto numJointDofs = subspace->getProperties().getNumDofs();
+    Eigen::Map<Eigen::VectorXd>(reinterpret_cast<double*>(stateBuffer), numDofs)
+        = _positions;
+    return;
+  }
 
-    Eigen::VectorXd jointPositions(numJointDofs);
-    for (std::size_t idof = 0; idof < numJointDofs; ++idof)
-      jointPositions[idof]
-          = _positions[mProperties.getDofIndex(isubspace, idof)];
+  // Reused across calls to avoid allocating for each joint.
+  static thread_local Eigen::VectorXd jointPositions;
+
+  for (std::size_t ijoint = 0; ijoint < mJointSpaces.size(); ++ijoint)
+  {
+    const auto begin = mJointDofOffsets[ijoint];
+    const auto end = mJointDofOffsets[ijoint + 1];
+    const auto substate = stateBuffer + mSubStateOffsets[ijoint];
+
+    switch (mJointStorage[ijoint])
+    {
+      case JointStorage::Vector:
+      {
+        const auto values = reinterpret_cast<double*>(substate);
+        for (std::size_t idof = begin; idof < end; ++idof)
+          values[idof - begin] = _positions[mDofIndices[idof]];
+        break;
+      }
+
+      case JointStorage::Angle:
+        reinterpret_cast<SO2::State*>(substate)->setAngle(
+            _positions[mDofIndices[begin]]);
+        break;
 
-    const auto substate = getSubState<>(_state, isubspace);
-    subspace->convertPositionsToState(jointPositions, substate);
+      case JointStorage::Generic:
+        jointPositions.resize(end - begin);
+        for (std::size_t idof = begin; idof < end; ++idof)
+          jointPositions[idof - begin] = _positions[mDofIndices[idof]];
+
+        mJointSpaces[ijoint]->convertPositionsToState(
+            jointPositions, reinterpret_cast<StateSpace::State*>(substate));
+        break;
+    }
   }
 }
 
@@ -326,20 +413,51 @@ void MetaSkeletonStateSpace::convertPositionsToState(
 void MetaSkeletonStateSpace::convertStateToPositions(
     const State* _state, Eigen::VectorXd& _positions) const
 {
-  _positions.resize(mProperties.getNumDofs());
+  const auto numDofs = mProperties.getNumDofs();
+  _positions.resize(numDofs);
+
+  const auto stateBuffer = reinterpret_cast<const char*>(_state);
 
-  for (std::size_t isubspace = 0; isubspace < getNumSubspaces(); ++isubspace)
+  if (mIsContiguous)
   {
-    const auto subspace = getSubspace<JointStateSpace>(isubspace);
-    const auto numJointDofs = subspace->getProperties().getNumDofs();
-    const auto substate = getSubState<>(_state, isubspace);
+    _positions = Eigen::Map<const Eigen::VectorXd>(
+        reinterpret_cast<const double*>(stateBuffer), numDofs);
+    return;
+  }
 
-    Eigen::VectorXd jointPositions(numJointDofs);
-    subspace->convertStateToPositions(substate, jointPositions);
+  // Reused across calls to avoid allocating for each joint.
+  static thread_local Eigen::VectorXd jointPositions;
 
-    for (std::size_t idof = 0; idof < numJointDofs; ++idof)
-      _positions[mProperties.getDofIndex(isubspace, idof)]
-          = jointPositions[idof];
+  for (std::size_t ijoint = 0; ijoint < mJointSpaces.size(); ++ijoint)
+  {
+    const auto begin = mJointDofOffsets[ijoint];
+    const auto end = mJointDofOffsets[ijoint + 1];
+    const auto substate = stateBuffer + mSubStateOffsets[ijoint];
+
+    switch (mJointStorage[ijoint])
+    {
+      case JointStorage::Vector:
+      {
+        const auto values = reinterpret_cast<const double*>(substate);
+        for (std::size_t idof = begin; idof < end; ++idof)
+          _positions[mDofIndices[idof]] = values[idof - begin];
+        break;
+      }
+
+      case JointStorage::Angle:
+        _positions[mDofIndices[begin]]
+            = reinterpret_cast<const SO2::State*>(substate)->getAngle();
+        break;
+
+      case JointStorage::Generic:
+        mJointSpaces[ijoint]->convertStateToPositions(
+            reinterpret_cast<const StateSpace::State*>(substate),
+            jointPositions);
+
+        for (std::size_t idof = begin; idof < end; ++idof)
+          _positions[mDofIndices[idof]] = jointPositions[idof - begin];
+        break;
+    }
   }
 }
 
@@ -347,7 +465,18 @@ void MetaSkeletonStateSpace::convertStateToPositions(
 void MetaSkeletonStateSpace::getState(
     const ::dart::dynamics::MetaSkeleton* _metaskeleton, State* _state) const
 {
-  convertPositionsToState(_metaskeleton->getPositions(), _state);
+  const auto numDofs = mProperties.getNumDofs();
+  if (_metaskeleton->getNumDofs() != numDofs)
+    throw std::invalid_argument("Incorrect number of positions.");
+
+  // Reused across calls, since getPositions allocates a new vector.
+  static thread_local Eigen::VectorXd positions;
+  positions.resize(numDofs);
+
+  for (std::size_t idof = 0; idof < numDofs; ++idof)
+    positions[idof] = _metaskeleton->getPosition(idof);
+
+  convertPositionsToState(positions, _state);
 }
 
 //==============================================================================
@@ -364,7 +493,8 @@ auto MetaSkeletonStateSpace::getScopedStateFromMetaSkeleton(
 void MetaSkeletonStateSpace::setState(
     ::dart::dynamics::MetaSkeleton* _metaskeleton, const State* _state) const
 {
-  Eigen::VectorXd positions;
+  // Reused across calls to avoid allocating on every call.
+  static thread_local Eigen::VectorXd positions;
   convertStateToPositions(_state, positions);
   _metaskeleton->setPositions(positions);
 }
@@ -1,5 +1,7 @@
 #include <aikido/trajectory/Interpolated.hpp>
 
+#include <algorithm>
+
 using aikido::statespace::GeodesicInterpolator;
 
 namespace aikido {
@@ -7,13 +9,36 @@ namespace trajectory {
 
 using State = aikido::statespace::StateSpace::State;
 
+namespace {
+
+/// States are stored at multiples of this many bytes, so that every state in
+/// the buffer is suitably aligned.
+constexpr std::size_t STATE_ALIGNMENT{16};
+
+/// Number of states allocated for the first waypoint.
+constexpr std::size_t MIN_STATE_CAPACITY{8};
+
+} // namespace
+
 //==============================================================================
 Interpolated::Interpolated(
     statespace::ConstStateSpacePtr _stateSpace,
     statespace::ConstInterpolatorPtr _interpolator)
-  : mStateSpace(std::move(_stateSpace)), mInterpolator(std::move(_interpolator))
+  : mStateSpace(std::move(_stateSpace))
+  , mInterpolator(std::move(_interpolator))
+  , mStateStride(0)
+  , mStateCapacity(0)
 {
-  // Do nothing
+  const auto stateSize = mStateSpace->getStateSizeInBytes();
+  mStateStride
+      = (stateSize + STATE_ALIGNMENT - 1) / STATE_ALIGNMENT * STATE_ALIGNMENT;
+}
+
+//==============================================================================
+Interpolated::~Interpolated()
+{
+  for (std::size_t i = 0; i < mWaypointTimes.size(); ++i)
+    mStateSpace->freeStateInBuffer(getWaypointState(i));
 }
 
 //==============================================================================
@@ -37,25 +62,25 @@ std::size_t Interpolated::getNumDerivatives() const
 //==============================================================================
 double Interpolated::getStartTime() const
 {
-  if (mWaypoints.empty())
+  if (mWaypointTimes.empty())
     throw std::domain_error("Requested getEndTime on empty trajectory.");
 
-  return mWaypoints.front().t;
+  return mWaypointTimes.front();
 }
 
 //==============================================================================
 double Interpolated::getEndTime() const
 {
-  if (mWaypoints.empty())
+  if (mWaypointTimes.empty())
     throw std::domain_error("Requested getEndTime on empty trajectory.");
 
-  return mWaypoints.back().t;
+  return mWaypointTimes.back();
 }
 
 //==============================================================================
 double Interpolated::getDuration() const
 {
-  if (!mWaypoints.empty())
+  if (!mWaypointTimes.empty())
     return getEndTime() - getStartTime();
   else
     return 0.;
@@ -64,7 +89,7 @@ double Interpolated::getDuration() const
 //==============================================================================
 void Interpolated::evaluate(double _t, State* _state) const
 {
-  if (mWaypoints.empty())
+  if (mWaypointTimes.empty())
     throw std::invalid_argument(
         "Requested trajectory point from an empty trajectory");
 
@@ -74,23 +99,24 @@ void Interpolated::evaluate(double _t, State* _state) const
     if (idx == 0)
     {
       // Time before beginning of trajectory - return first waypoint
-      mStateSpace->copyState(mWaypoints[0].state, _state);
+      mStateSpace->copyState(getWaypointState(0), _state);
     }
     else
     {
-      Waypoint currentWpt = mWaypoints[idx];
-      Waypoint prevWpt = mWaypoints[idx - 1];
+      const auto currentTime = mWaypointTimes[idx];
+      const auto prevTime = mWaypointTimes[idx - 1];
       mInterpolator->interpolate(
-          prevWpt.state,
-          currentWpt.state,
-          (_t - prevWpt.t) / (currentWpt.t - prevWpt.t),
+          getWaypointState(idx - 1),
+          getWaypointState(idx),
+          (_t - prevTime) / (currentTime - prevTime),
           _state);
     }
   }
   catch (const std::domain_error& e)
   {
     // Time past end of trajectory - return last waypoint
-    mStateSpace->copyState(mWaypoints.back().state, _state);
+    mStateSpace->copyState(
+        getWaypointState(mWaypointTimes.size() - 1), _state);
   }
 }
 
@@ -122,12 +148,12 @@ void Interpolated::evaluateDerivative(
     if (idx == 0)
       throw std::domain_error("Time is before the trajectory starts.");
 
-    const auto segmentTime = mWaypoints[idx].t - mWaypoints[idx - 1].t;
-    const auto alpha = (_t - mWaypoints[idx - 1].t) / segmentTime;
+    const auto segmentTime = mWaypointTimes[idx] - mWaypointTimes[idx - 1];
+    const auto alpha = (_t - mWaypointTimes[idx - 1]) / segmentTime;
 
     mInterpolator->getDerivative(
-        mWaypoints[idx - 1].state,
-        mWaypoints[idx].state,
+        getWaypointState(idx - 1),
+        getWaypointState(idx),
         _derivative,
         alpha,
         _tangentVector);
@@ -142,23 +168,129 @@ void Interpolated::evaluateDerivative(
   }
 }
 
+//==============================================================================
+void Interpolated::evaluateBatch(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd& _output,
+    const std::vector<int>& _derivatives) const
+{
+  if (mWaypointTimes.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
+
+  for (const int derivative : _derivatives)
+  {
+    if (derivative < 0)
+      throw std::invalid_argument("Derivative must be non-negative.");
+  }
+
+  const auto dimension = static_cast<int>(mStateSpace->getDimension());
+  const auto numWaypoints = mWaypointTimes.size();
+  _output.resize(dimension * _derivatives.size(), _times.size());
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+
+  // Sweep through the waypoints, starting from the segment of the previous
+  // time. Times outside of the trajectory evaluate to its first or last
+  // waypoint with zero derivatives, as in evaluate and evaluateDerivative.
+  std::size_t idx = 0;
+  for (std::size_t i = 0; i < _times.size(); ++i)
+  {
+    const double t = _times[i];
+    idx = getWaypointIndexAfterTime(t, idx);
+    const bool isInside = idx != 0 && idx != numWaypoints;
+
+    for (std::size_t j = 0; j < _derivatives.size(); ++j)
+    {
+      const int derivative = _derivatives[j];
+      if (derivative == 0)
+      {
+        if (idx == 0)
+        {
+          mStateSpace->copyState(getWaypointState(0), state);
+        }
+        else if (idx == numWaypoints)
+        {
+          mStateSpace->copyState(getWaypointState(numWaypoints - 1), state);
+        }
+        else
+        {
+          const auto currentTime = mWaypointTimes[idx];
+          const auto prevTime = mWaypointTimes[idx - 1];
+          mInterpolator->interpolate(
+              getWaypointState(idx - 1),
+              getWaypointState(idx),
+              (t - prevTime) / (currentTime - prevTime),
+              state);
+        }
+
+        mStateSpace->logMap(state, tangentVector);
+      }
+      else if (
+          !isInside || static_cast<std::size_t>(derivative)
+                           > mInterpolator->getNumDerivatives())
+      {
+        tangentVector.setZero(dimension);
+      }
+      else
+      {
+        const auto segmentTime = mWaypointTimes[idx] - mWaypointTimes[idx - 1];
+        mInterpolator->getDerivative(
+            getWaypointState(idx - 1),
+            getWaypointState(idx),
+            derivative,
+            (t - mWaypointTimes[idx - 1]) / segmentTime,
+            tangentVector);
+        tangentVector /= segmentTime;
+      }
+
+      _output.block(j * dimension, i, dimension, 1) = tangentVector;
+    }
+  }
+}
+
 //==============================================================================
 void Interpolated::addWaypoint(double _t, const State* _state)
 {
-  State* state = mStateSpace->allocateState();
-  mStateSpace->copyState(_state, state);
+  const auto numWaypoints = mWaypointTimes.size();
 
   // Maintain a sorted list of waypoints
-  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
-  mWaypoints.insert(it, Waypoint(_t, state));
+  const auto index = static_cast<std::size_t>(
+      std::lower_bound(mWaypointTimes.begin(), mWaypointTimes.end(), _t)
+      - mWaypointTimes.begin());
+
+  // _state may be a waypoint of this trajectory, which is moved below.
+  auto state = mStateSpace->createState();
+  mStateSpace->copyState(_state, state);
+
+  if (numWaypoints == mStateCapacity)
+    reallocate(std::max(MIN_STATE_CAPACITY, 2 * mStateCapacity));
+
+  // Shift the later waypoints back by one to make room for the new one.
+  mStateSpace->allocateStateInBuffer(getWaypointState(numWaypoints));
+  for (std::size_t i = numWaypoints; i > index; --i)
+    mStateSpace->copyState(getWaypointState(i - 1), getWaypointState(i));
+  mStateSpace->copyState(state, getWaypointState(index));
+
+  mWaypointTimes.insert(mWaypointTimes.begin() + index, _t);
+}
+
+//==============================================================================
+void Interpolated::reserve(std::size_t _numWaypoints)
+{
+  if (_numWaypoints > mStateCapacity)
+    reallocate(_numWaypoints);
+
+  mWaypointTimes.reserve(_numWaypoints);
 }
 
 //==============================================================================
 const statespace::StateSpace::State* Interpolated::getWaypoint(
     std::size_t _index) const
 {
-  if (_index < mWaypoints.size())
-    return mWaypoints[_index].state;
+  if (_index < mWaypointTimes.size())
+    return getWaypointState(_index);
   else
     throw std::domain_error("Waypoint index is out of bounds.");
 }
@@ -166,8 +298,8 @@ const statespace::StateSpace::State* Interpolated::getWaypoint(
 //==============================================================================
 double Interpolated::getWaypointTime(std::size_t _index) const
 {
-  if (_index < mWaypoints.size())
-    return mWaypoints[_index].t;
+  if (_index < mWaypointTimes.size())
+    return mWaypointTimes[_index];
   else
     throw std::domain_error("Waypoint index is out of bounds.");
 }
@@ -175,39 +307,63 @@ double Interpolated::getWaypointTime(std::size_t _index) const
 //==============================================================================
 std::size_t Interpolated::getNumWaypoints() const
 {
-  return mWaypoints.size();
+  return mWaypointTimes.size();
 }
 
 //==============================================================================
 int Interpolated::getWaypointIndexAfterTime(double _t) const
 {
-  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
-  if (it == mWaypoints.end())
+  auto it = std::lower_bound(mWaypointTimes.begin(), mWaypointTimes.end(), _t);
+  if (it == mWaypointTimes.end())
   {
     throw std::domain_error(
         "_t is larger than the time value on the last waypoint.");
   }
 
-  return std::distance(mWaypoints.begin(), it);
+  return std::distance(mWaypointTimes.begin(), it);
 }
 
 //==============================================================================
-Interpolated::Waypoint::Waypoint(
-    double _t, statespace::StateSpace::State* _state)
-  : t(_t), state(_state)
+std::size_t Interpolated::getWaypointIndexAfterTime(
+    double _t, std::size_t _hint) const
 {
+  const auto numWaypoints = mWaypointTimes.size();
+  const auto isIndexAfterTime = [this, _t, numWaypoints](std::size_t index) {
+    return (index == 0 || mWaypointTimes[index - 1] < _t)
+           && (index == numWaypoints || !(mWaypointTimes[index] < _t));
+  };
+
+  if (_hint <= numWaypoints && isIndexAfterTime(_hint))
+    return _hint;
+
+  if (_hint < numWaypoints && isIndexAfterTime(_hint + 1))
+    return _hint + 1;
+
+  auto it = std::lower_bound(mWaypointTimes.begin(), mWaypointTimes.end(), _t);
+  return std::distance(mWaypointTimes.begin(), it);
 }
 
 //==============================================================================
-bool Interpolated::Waypoint::operator<(const Waypoint& rhs) const
+State* Interpolated::getWaypointState(std::size_t _index) const
 {
-  return t < rhs.t;
+  return reinterpret_cast<State*>(mStateBuffer.get() + _index * mStateStride);
 }
 
 //==============================================================================
-bool Interpolated::Waypoint::operator<(double rhs) const
+void Interpolated::reallocate(std::size_t _capacity)
 {
-  return t < rhs;
+  std::unique_ptr<char[]> stateBuffer(new char[_capacity * mStateStride]);
+
+  for (std::size_t i = 0; i < mWaypointTimes.size(); ++i)
+  {
+    auto state = mStateSpace->allocateStateInBuffer(
+        stateBuffer.get() + i * mStateStride);
+    mStateSpace->copyState(getWaypointState(i), state);
+    mStateSpace->freeStateInBuffer(getWaypointState(i));
+  }
+
+  mStateBuffer = std::move(stateBuffer);
+  mStateCapacity = _capacity;
 }
 
 } // namespace trajectory
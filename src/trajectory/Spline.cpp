@@ -1,13 +1,48 @@
 #include <aikido/trajectory/Spline.hpp>
 
+#include <algorithm>
 #include <aikido/common/Spline.hpp>
 
 namespace aikido {
 namespace trajectory {
 
+namespace {
+
+/// Largest number of polynomial coefficients covered by the table returned by
+/// getDerivativeCoefficientTable().
+constexpr int MAX_TABULATED_COEFFICIENTS{16};
+
+//==============================================================================
+/// Returns a table whose element (i, j) is the coefficient of t^(j - i) in the
+/// i-th derivative of t^j. The table for fewer coefficients is the top-left
+/// block of this table.
+const Eigen::MatrixXd& getDerivativeCoefficientTable()
+{
+  static const Eigen::MatrixXd table
+      = common::SplineProblem<>::createCoefficientMatrix(
+          MAX_TABULATED_COEFFICIENTS);
+  return table;
+}
+
+//==============================================================================
+double getDerivativeCoefficient(int _derivative, int _power)
+{
+  if (_power < MAX_TABULATED_COEFFICIENTS)
+    return getDerivativeCoefficientTable()(_derivative, _power);
+
+  double coefficient = 1.;
+  for (int i = 0; i < _derivative; ++i)
+    coefficient *= _power - i;
+  return coefficient;
+}
+
+} // namespace
+
 //==============================================================================
 Spline::Spline(statespace::ConstStateSpacePtr _stateSpace, double _startTime)
-  : mStateSpace(std::move(_stateSpace)), mStartTime(_startTime)
+  : mStateSpace(std::move(_stateSpace))
+  , mStartTime(_startTime)
+  , mSegmentStartTimes(1, _startTime)
 {
   if (mStateSpace == nullptr)
     throw std::invalid_argument("StateSpace is null.");
@@ -43,6 +78,7 @@ void Spline::addSegment(
   mStateSpace->copyState(_startState, segment.mStartState);
 
   mSegments.emplace_back(std::move(segment));
+  mSegmentStartTimes.emplace_back(mSegmentStartTimes.back() + _duration);
 }
 
 //==============================================================================
@@ -102,12 +138,7 @@ double Spline::getEndTime() const
 //==============================================================================
 double Spline::getDuration() const
 {
-  double duration = 0.;
-
-  for (const auto& segment : mSegments)
-    duration += segment.mDuration;
-
-  return duration;
+  return mSegmentStartTimes.back() - mStartTime;
 }
 
 //==============================================================================
@@ -116,18 +147,12 @@ void Spline::evaluate(double _t, statespace::StateSpace::State* _out) const
   if (mSegments.empty())
     throw std::logic_error("Unable to evaluate empty trajectory.");
 
-  const auto targetSegmentInfo = getSegmentForTime(_t);
-  const auto& targetSegment = mSegments[targetSegmentInfo.first];
-
-  mStateSpace->copyState(targetSegment.mStartState, _out);
-
-  const auto evaluationTime = _t - targetSegmentInfo.second;
-  const auto tangentVector
-      = evaluatePolynomial(targetSegment.mCoefficients, evaluationTime, 0);
-
-  const auto relativeState = mStateSpace->createState();
-  mStateSpace->expMap(tangentVector, relativeState);
-  mStateSpace->compose(_out, relativeState);
+  // Reused across calls to avoid allocating. The scratch state comes from the
+  // thread-local StateBufferPool, since its size depends on the StateSpace.
+  static thread_local Eigen::VectorXd tangentVector;
+  auto relativeState = mStateSpace->createState();
+  evaluateSegment(
+      getSegmentIndexForTime(_t), _t, _out, tangentVector, relativeState);
 }
 
 //==============================================================================
@@ -139,67 +164,164 @@ void Spline::evaluateDerivative(
   if (_derivative < 1)
     throw std::logic_error("Derivative must be positive.");
 
-  const auto targetSegmentInfo = getSegmentForTime(_t);
-  const auto& targetSegment = mSegments[targetSegmentInfo.first];
-  const auto evaluationTime = _t - targetSegmentInfo.second;
+  evaluateSegmentDerivative(
+      getSegmentIndexForTime(_t), _t, _derivative, _tangentVector);
+}
 
-  // Return zero for higher-order derivatives.
-  if (_derivative < targetSegment.mCoefficients.cols())
+//==============================================================================
+void Spline::evaluateBatch(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd& _output,
+    const std::vector<int>& _derivatives) const
+{
+  if (mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+
+  for (const int derivative : _derivatives)
   {
-    // TODO: We should transform this into the body frame using the adjoint
-    // transformation.
-    _tangentVector = evaluatePolynomial(
-        targetSegment.mCoefficients, evaluationTime, _derivative);
+    if (derivative < 0)
+      throw std::invalid_argument("Derivative must be non-negative.");
   }
-  else
+
+  const auto dimension = static_cast<int>(mStateSpace->getDimension());
+  _output.resize(dimension * _derivatives.size(), _times.size());
+
+  // Scratch buffers shared by all evaluations of the batch.
+  auto state = mStateSpace->createState();
+  auto relativeState = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+
+  // Sweep through the segments, starting from the segment of the previous
+  // time.
+  std::size_t segmentIndex = 0;
+  for (std::size_t i = 0; i < _times.size(); ++i)
   {
-    _tangentVector.resize(mStateSpace->getDimension());
-    _tangentVector.setZero();
+    const double t = _times[i];
+    segmentIndex = getSegmentIndexForTime(t, segmentIndex);
+
+    for (std::size_t j = 0; j < _derivatives.size(); ++j)
+    {
+      if (_derivatives[j] == 0)
+      {
+        evaluateSegment(segmentIndex, t, state, tangentVector, relativeState);
+        mStateSpace->logMap(state, tangentVector);
+      }
+      else
+      {
+        evaluateSegmentDerivative(
+            segmentIndex, t, _derivatives[j], tangentVector);
+      }
+
+      _output.block(j * dimension, i, dimension, 1) = tangentVector;
+    }
   }
 }
 
 //==============================================================================
-std::pair<std::size_t, double> Spline::getSegmentForTime(double _t) const
+void Spline::evaluateSegment(
+    std::size_t _index,
+    double _t,
+    statespace::StateSpace::State* _out,
+    Eigen::VectorXd& _tangentVector,
+    statespace::StateSpace::State* _relativeState) const
 {
-  auto segmentStartTime = mStartTime;
+  const auto& targetSegment = mSegments[_index];
 
-  for (std::size_t isegment = 0; isegment < mSegments.size(); ++isegment)
-  {
-    const auto& segment = mSegments[isegment];
-    const auto nextSegmentStartTime = segmentStartTime + segment.mDuration;
+  mStateSpace->copyState(targetSegment.mStartState, _out);
 
-    if (_t <= nextSegmentStartTime)
-      return std::make_pair(isegment, segmentStartTime);
+  const auto evaluationTime = _t - mSegmentStartTimes[_index];
+  evaluatePolynomial(
+      targetSegment.mCoefficients, evaluationTime, 0, _tangentVector);
 
-    segmentStartTime = nextSegmentStartTime;
-  }
+  mStateSpace->expMap(_tangentVector, _relativeState);
+  mStateSpace->compose(_out, _relativeState);
+}
+
+//==============================================================================
+void Spline::evaluateSegmentDerivative(
+    std::size_t _index,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _tangentVector) const
+{
+  const auto& targetSegment = mSegments[_index];
+  const auto evaluationTime = _t - mSegmentStartTimes[_index];
+
+  // TODO: We should transform this into the body frame using the adjoint
+  // transformation.
+  evaluatePolynomial(
+      targetSegment.mCoefficients, evaluationTime, _derivative, _tangentVector);
+}
+
+//==============================================================================
+std::size_t Spline::getSegmentIndexForTime(double _t) const
+{
+  // A segment contains the times in (start time, end time]. Find the first
+  // segment that ends at or after _t.
+  const auto it = std::lower_bound(
+      mSegmentStartTimes.begin() + 1, mSegmentStartTimes.end(), _t);
 
   // After the end of the last segment.
-  return std::make_pair(
-      mSegments.size() - 1, segmentStartTime - mSegments.back().mDuration);
+  if (it == mSegmentStartTimes.end())
+    return mSegments.size() - 1;
+
+  return static_cast<std::size_t>(it - mSegmentStartTimes.begin()) - 1;
+}
+
+//==============================================================================
+std::size_t Spline::getSegmentIndexForTime(double _t, std::size_t _hint) const
+{
+  if (_hint < mSegments.size())
+  {
+    if (isTimeInSegment(_t, _hint))
+      return _hint;
+
+    if (_hint + 1 < mSegments.size() && isTimeInSegment(_t, _hint + 1))
+      return _hint + 1;
+  }
+
+  return getSegmentIndexForTime(_t);
 }
 
 //==============================================================================
-Eigen::VectorXd Spline::evaluatePolynomial(
-    const Eigen::MatrixXd& _coefficients, double _t, int _derivative)
+bool Spline::isTimeInSegment(double _t, std::size_t _index) const
 {
-  const auto numOutputs = _coefficients.rows();
-  const auto numCoeffs = _coefficients.cols();
+  const bool isAfterStart = _index == 0 || _t > mSegmentStartTimes[_index];
+  const bool isBeforeEnd
+      = _index + 1 == mSegments.size() || _t <= mSegmentStartTimes[_index + 1];
+  return isAfterStart && isBeforeEnd;
+}
 
-  const auto timeVector
-      = common::SplineProblem<>::createTimeVector(_t, _derivative, numCoeffs);
-  const auto derivativeMatrix
-      = common::SplineProblem<>::createCoefficientMatrix(numCoeffs);
-  const auto derivativeVector = derivativeMatrix.row(_derivative);
-  const auto evaluationVector
-      = derivativeVector.cwiseProduct(timeVector.transpose());
+//==============================================================================
+void Spline::evaluatePolynomial(
+    const Eigen::MatrixXd& _coefficients,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _output)
+{
+  const auto numCoeffs = static_cast<int>(_coefficients.cols());
 
-  Eigen::VectorXd outputVector(numOutputs);
+  _output.resize(_coefficients.rows());
 
-  for (int ioutput = 0; ioutput < numOutputs; ++ioutput)
-    outputVector[ioutput] = _coefficients.row(ioutput).dot(evaluationVector);
+  // Return zero for higher-order derivatives.
+  if (_derivative >= numCoeffs)
+  {
+    _output.setZero();
+    return;
+  }
+
+  // Horner's scheme, starting from the highest power. Each step updates all
+  // dimensions at once from one contiguous column of coefficients.
+  _output = getDerivativeCoefficient(_derivative, numCoeffs - 1)
+            * _coefficients.col(numCoeffs - 1);
 
-  return outputVector;
+  for (int power = numCoeffs - 2; power >= _derivative; --power)
+  {
+    _output *= _t;
+    _output.noalias()
+        += getDerivativeCoefficient(_derivative, power)
+           * _coefficients.col(power);
+  }
 }
 
 //==============================================================================
@@ -211,15 +333,10 @@ std::size_t Spline::getNumWaypoints() const
 //==============================================================================
 double Spline::getWaypointTime(std::size_t _index) const
 {
-  double waypointTime = mStartTime;
-
   if (_index >= getNumWaypoints())
     throw std::domain_error("Waypoint index is out of bounds.");
 
-  for (std::size_t i = 0; i < _index; ++i)
-    waypointTime += mSegments[i].mDuration;
-
-  return waypointTime;
+  return mSegmentStartTimes[_index];
 }
 
 //==============================================================================
@@ -252,5 +369,54 @@ void Spline::getWaypointDerivative(
   }
 }
 
+//==============================================================================
+Spline::Cursor::Cursor(ConstSplinePtr _spline)
+  : mSpline(std::move(_spline)), mSegmentIndex(0)
+{
+  if (!mSpline)
+    throw std::invalid_argument("Spline is nullptr.");
+
+  mRelativeState.reset(
+      new statespace::StateSpace::ScopedState(
+          mSpline->mStateSpace->createState()));
+}
+
+//==============================================================================
+ConstSplinePtr Spline::Cursor::getSpline() const
+{
+  return mSpline;
+}
+
+//==============================================================================
+void Spline::Cursor::evaluate(double _t, statespace::StateSpace::State* _state)
+{
+  if (mSpline->mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+
+  mSegmentIndex = mSpline->getSegmentIndexForTime(_t, mSegmentIndex);
+  mSpline->evaluateSegment(
+      mSegmentIndex, _t, _state, mTangentVector, *mRelativeState);
+}
+
+//==============================================================================
+void Spline::Cursor::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector)
+{
+  if (mSpline->mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+  if (_derivative < 1)
+    throw std::logic_error("Derivative must be positive.");
+
+  mSegmentIndex = mSpline->getSegmentIndexForTime(_t, mSegmentIndex);
+  mSpline->evaluateSegmentDerivative(
+      mSegmentIndex, _t, _derivative, _tangentVector);
+}
+
+//==============================================================================
+std::size_t Spline::Cursor::getSegmentIndex() const
+{
+  return mSegmentIndex;
+}
+
 } // namespace trajectory
 } // namespace aikido
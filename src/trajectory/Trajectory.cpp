@@ -0,0 +1,45 @@
+#include "aikido/trajectory/Trajectory.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+void Trajectory::evaluateBatch(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd& _output,
+    const std::vector<int>& _derivatives) const
+{
+  for (const int derivative : _derivatives)
+  {
+    if (derivative < 0)
+      throw std::invalid_argument("Derivative must be non-negative.");
+  }
+
+  const auto stateSpace = getStateSpace();
+  const auto dimension = static_cast<int>(stateSpace->getDimension());
+  _output.resize(dimension * _derivatives.size(), _times.size());
+
+  auto state = stateSpace->createState();
+  Eigen::VectorXd tangentVector;
+
+  for (std::size_t i = 0; i < _times.size(); ++i)
+  {
+    for (std::size_t j = 0; j < _derivatives.size(); ++j)
+    {
+      if (_derivatives[j] == 0)
+      {
+        evaluate(_times[i], state);
+        stateSpace->logMap(state, tangentVector);
+      }
+      else
+      {
+        evaluateDerivative(_times[i], _derivatives[j], tangentVector);
+      }
+
+      _output.block(j * dimension, i, dimension, 1) = tangentVector;
+    }
+  }
+}
+
+} // namespace trajectory
+} // namespace aikido
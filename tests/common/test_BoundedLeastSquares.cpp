@@ -0,0 +1,141 @@
+#include <cmath>
+#include <limits>
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+#include <aikido/common/BoundedLeastSquares.hpp>
+
+using aikido::common::BoundedLeastSquaresSolver;
+
+static const double kInfinity = std::numeric_limits<double>::infinity();
+
+TEST(BoundedLeastSquares, Unbounded)
+{
+  Eigen::MatrixXd A(6, 4);
+  A << 4, 1, 0, 2, 1, 3, 1, 0, 0, 1, 5, 1, 2, 0, 1, 3, 1, 1, 1, 1, 0, 2, 1, 0;
+  Eigen::VectorXd b(6);
+  b << 1, -2, 3, 0.5, 1, -1;
+
+  const Eigen::VectorXd unbounded = Eigen::VectorXd::Constant(4, kInfinity);
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(4);
+
+  BoundedLeastSquaresSolver solver;
+  EXPECT_TRUE(solver.solve(A, b, -unbounded, unbounded, x));
+
+  const Eigen::VectorXd expected = A.colPivHouseholderQr().solve(b);
+  EXPECT_TRUE(x.isApprox(expected, 1e-6));
+}
+
+TEST(BoundedLeastSquares, Bounded)
+{
+  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(3, 3);
+  Eigen::VectorXd b(3);
+  b << 2, -2, 0.5;
+
+  const Eigen::VectorXd lower = Eigen::VectorXd::Constant(3, -1);
+  const Eigen::VectorXd upper = Eigen::VectorXd::Constant(3, 1);
+  Eigen::VectorXd x = Eigen::VectorXd::Constant(3, 5);
+
+  BoundedLeastSquaresSolver solver;
+  EXPECT_TRUE(solver.solve(A, b, lower, upper, x));
+  EXPECT_TRUE(x.isApprox(Eigen::Vector3d(1, -1, 0.5)));
+}
+
+TEST(BoundedLeastSquares, RedundantStaysNearInitialGuess)
+{
+  // The second and third variables have the same effect.
+  Eigen::MatrixXd A(2, 3);
+  A << 1, 0, 0, 0, 1, 1;
+  const Eigen::Vector2d b(1, 2);
+
+  const Eigen::VectorXd lower = Eigen::VectorXd::Constant(3, -10);
+  const Eigen::VectorXd upper = Eigen::VectorXd::Constant(3, 10);
+  Eigen::VectorXd x = Eigen::Vector3d(0, 3, -1);
+
+  BoundedLeastSquaresSolver solver;
+  EXPECT_TRUE(solver.solve(A, b, lower, upper, x));
+  EXPECT_TRUE((A * x).isApprox(b));
+  EXPECT_TRUE(x.isApprox(Eigen::Vector3d(1, 3, -1)));
+
+  // A solution is returned immediately from a solution.
+  EXPECT_TRUE(solver.solve(A, b, lower, upper, x));
+  EXPECT_EQ(1, solver.getNumIterations());
+}
+
+TEST(BoundedLeastSquares, IllConditionedRedundant)
+{
+  // Jacobian of a 7-DOF arm whose wrist joints barely move the end-effector.
+  Eigen::MatrixXd A(6, 7);
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 7; ++j)
+      A(i, j) = std::sin(1.3 * (i + 1) * (j + 2) + 0.7 * j);
+  }
+  A.rightCols(3) *= 2e-3;
+
+  const Eigen::JacobiSVD<Eigen::MatrixXd> svd(A);
+  const auto& singularValues = svd.singularValues();
+  ASSERT_GT(singularValues[0] / singularValues[5], 500.);
+
+  Eigen::VectorXd b(6);
+  b << 0.1, -0.2, 0.05, 0.3, -0.1, 0.2;
+
+  // Without active bounds, the twist is achieved exactly.
+  const Eigen::VectorXd unbounded = Eigen::VectorXd::Constant(7, kInfinity);
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(7);
+
+  BoundedLeastSquaresSolver solver;
+  EXPECT_TRUE(solver.solve(A, b, -unbounded, unbounded, x));
+  EXPECT_TRUE((A * x).isApprox(b, 1e-8));
+
+  // With tight bounds, the solution satisfies the optimality conditions.
+  const Eigen::VectorXd lower = Eigen::VectorXd::Constant(7, -0.5);
+  const Eigen::VectorXd upper = Eigen::VectorXd::Constant(7, 0.5);
+  x.setZero();
+  EXPECT_TRUE(solver.solve(A, b, lower, upper, x));
+
+  const Eigen::VectorXd gradient = A.transpose() * (A * x - b);
+  bool hasActiveBound = false;
+  for (int i = 0; i < 7; ++i)
+  {
+    ASSERT_GE(x[i], lower[i]);
+    ASSERT_LE(x[i], upper[i]);
+
+    if (x[i] == lower[i])
+    {
+      hasActiveBound = true;
+      EXPECT_GE(gradient[i], -1e-8);
+    }
+    else if (x[i] == upper[i])
+    {
+      hasActiveBound = true;
+      EXPECT_LE(gradient[i], 1e-8);
+    }
+    else
+    {
+      EXPECT_NEAR(0., gradient[i], 1e-8);
+    }
+  }
+  EXPECT_TRUE(hasActiveBound);
+}
+
+TEST(BoundedLeastSquares, ThrowsOnInvalidArguments)
+{
+  EXPECT_THROW(BoundedLeastSquaresSolver(0), std::invalid_argument);
+  EXPECT_THROW(BoundedLeastSquaresSolver(10, -1.0), std::invalid_argument);
+
+  BoundedLeastSquaresSolver solver;
+  const Eigen::MatrixXd A = Eigen::MatrixXd::Identity(2, 2);
+  const Eigen::Vector2d b(1, 1);
+  const Eigen::VectorXd lower = Eigen::Vector2d(-1, -1);
+  const Eigen::VectorXd upper = Eigen::Vector2d(1, 1);
+  Eigen::VectorXd x = Eigen::Vector2d::Zero();
+
+  EXPECT_THROW(
+      solver.solve(A, Eigen::Vector3d::Zero(), lower, upper, x),
+      std::invalid_argument);
+  EXPECT_THROW(solver.solve(A, b, upper, lower, x), std::invalid_argument);
+
+  Eigen::VectorXd wrongSize = Eigen::Vector3d::Zero();
+  EXPECT_THROW(
+      solver.solve(A, b, lower, upper, wrongSize), std::invalid_argument);
+}
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <cstdlib>
 #include <gtest/gtest.h>
 #include <aikido/common/Spline.hpp>
@@ -69,3 +70,112 @@ TEST_F(SplineProblemTests, fit_ContinuityConstraints)
   EXPECT_EIGEN_EQUAL(coefficients2, spline.getCoefficients()[1], EPSILON);
 #endif
 }
+
+TEST_F(SplineProblemTests, fit_FixedSizeLinearSegment)
+{
+  using LinearProblem
+      = aikido::common::SplineProblem<double, int, 2, Eigen::Dynamic, 2>;
+
+  LinearProblem::TimeVector times;
+  times << 1., 3.;
+
+  LinearProblem problem(times, 2, 2);
+  problem.addConstantConstraint(0, 0, make_vector(1., 2.));
+  problem.addConstantConstraint(1, 0, make_vector(5., 0.));
+
+  LinearProblem::Spline spline = problem.fit();
+
+  Eigen::Matrix<double, 2, 2> coefficients;
+  coefficients << -1., 2., 3., -1.;
+  EXPECT_EIGEN_EQUAL(coefficients, spline.getCoefficients()[0], EPSILON);
+}
+
+TEST_F(SplineProblemTests, fit_FixedSizeCubicHermiteSegment)
+{
+  using CubicProblem = aikido::common::SplineProblem<double, int, 4, 2, 2>;
+
+  CubicProblem::TimeVector times;
+  times << 0., 1.;
+
+  CubicProblem problem(times);
+  problem.addConstantConstraint(0, 0, make_vector(1., 2.));
+  problem.addConstantConstraint(0, 1, make_vector(0., 0.));
+  problem.addConstantConstraint(1, 0, make_vector(2., 3.));
+  problem.addConstantConstraint(1, 1, make_vector(1., 1.));
+
+  CubicProblem::Spline spline = problem.fit();
+
+  Eigen::Matrix<double, 2, 4> coefficients;
+  coefficients << 1., 0., 2., -1., 2., 0., 2., -1.;
+  EXPECT_EIGEN_EQUAL(coefficients, spline.getCoefficients()[0], EPSILON);
+}
+
+TEST_F(SplineProblemTests, fit_ManyKnots)
+{
+  static constexpr int numKnots = 200;
+
+  SplineProblem::TimeVector times(numKnots);
+  for (int i = 0; i < numKnots; ++i)
+    times[i] = 0.5 * i;
+
+  // Cubic spline through sin(t) with continuous first and second derivatives
+  // and clamped end velocities.
+  SplineProblem problem(times, 4, 1);
+  for (int i = 0; i < numKnots; ++i)
+  {
+    problem.addConstantConstraint(i, 0, make_vector(std::sin(times[i])));
+
+    if (i > 0 && i + 1 < numKnots)
+    {
+      problem.addContinuityConstraint(i, 1);
+      problem.addContinuityConstraint(i, 2);
+    }
+  }
+  problem.addConstantConstraint(0, 1, make_vector(1.));
+  problem.addConstantConstraint(
+      numKnots - 1, 1, make_vector(std::cos(times[numKnots - 1])));
+
+  SplineProblem::Spline spline = problem.fit();
+
+  for (int i = 0; i < numKnots; ++i)
+  {
+    EXPECT_EIGEN_EQUAL(
+        make_vector(std::sin(times[i])), spline.evaluate(times[i]), EPSILON);
+  }
+
+  for (int i = 1; i + 1 < numKnots; ++i)
+  {
+    for (int derivative = 1; derivative < 3; ++derivative)
+    {
+      EXPECT_EIGEN_EQUAL(
+          spline.evaluate(times[i] - 1e-9, derivative),
+          spline.evaluate(times[i] + 1e-9, derivative),
+          1e-4);
+    }
+  }
+
+  EXPECT_NEAR(std::sin(0.25), spline.evaluate(0.25)[0], 1e-2);
+}
+
+TEST_F(SplineProblemTests, fit_ConstraintsOutsideOfBand)
+{
+  SplineProblem::TimeVector times(4);
+  times << 0., 0.5, 1., 1.5;
+
+  // Five constraints on the first segment do not fit in the band, so the
+  // problem is solved by SparseQR instead.
+  SplineProblem problem(times, 2, 1);
+  problem.addConstantConstraint(0, 0, make_vector(1.));
+  problem.addConstantConstraint(0, 1, make_vector(2.));
+  problem.addConstantConstraint(0, 0, make_vector(1.));
+  problem.addContinuityConstraint(1, 0);
+  problem.addContinuityConstraint(1, 1);
+  problem.addConstantConstraint(3, 0, make_vector(4.));
+
+  SplineProblem::Spline spline = problem.fit();
+
+  EXPECT_EIGEN_EQUAL(make_vector(1.), spline.evaluate(0.), EPSILON);
+  EXPECT_EIGEN_EQUAL(make_vector(2.), spline.evaluate(0., 1), EPSILON);
+  EXPECT_EIGEN_EQUAL(make_vector(3.), spline.evaluate(1.), EPSILON);
+  EXPECT_EIGEN_EQUAL(make_vector(4.), spline.evaluate(1.5), EPSILON);
+}
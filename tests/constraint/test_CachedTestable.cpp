@@ -0,0 +1,173 @@
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <aikido/constraint/CachedTestable.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include "MockConstraints.hpp"
+
+using aikido::constraint::CachedTestable;
+using aikido::statespace::R2;
+
+/// Constraint satisfied by states with a positive first coordinate, which
+/// counts how often it is tested.
+class CountingConstraint : public aikido::constraint::Testable
+{
+public:
+  explicit CountingConstraint(std::shared_ptr<R2> stateSpace)
+    : stateSpace{stateSpace}, numCalls{0}
+  {
+  }
+
+  bool isSatisfied(
+      const aikido::statespace::StateSpace::State* state,
+      TestableOutcome* outcome = nullptr) const override
+  {
+    ++numCalls;
+
+    const bool satisfied
+        = stateSpace->getValue(static_cast<const R2::State*>(state))[0] > 0.;
+
+    auto defaultOutcomeObject
+        = aikido::constraint::dynamic_cast_or_throw<DefaultTestableOutcome>(
+            outcome);
+    if (defaultOutcomeObject)
+      defaultOutcomeObject->setSatisfiedFlag(satisfied);
+    return satisfied;
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return std::unique_ptr<TestableOutcome>(new DefaultTestableOutcome);
+  }
+
+  std::shared_ptr<aikido::statespace::StateSpace> getStateSpace() const override
+  {
+    return stateSpace;
+  }
+
+  std::shared_ptr<R2> stateSpace;
+  mutable int numCalls;
+};
+
+class CachedTestableTest : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    stateSpace = std::make_shared<R2>();
+    constraint = std::make_shared<CountingConstraint>(stateSpace);
+  }
+
+  bool test(const CachedTestable& cache, double x, double y)
+  {
+    auto state = stateSpace->createState();
+    stateSpace->setValue(state, Eigen::Vector2d(x, y));
+    return cache.isSatisfied(state);
+  }
+
+  std::shared_ptr<R2> stateSpace;
+  std::shared_ptr<CountingConstraint> constraint;
+};
+
+TEST_F(CachedTestableTest, ThrowsOnInvalidArguments)
+{
+  EXPECT_THROW(CachedTestable(nullptr, 0.1), std::invalid_argument);
+  EXPECT_THROW(CachedTestable(constraint, 0.), std::invalid_argument);
+  EXPECT_THROW(CachedTestable(constraint, -0.1), std::invalid_argument);
+  EXPECT_THROW(CachedTestable(constraint, 0.1, 0), std::invalid_argument);
+  EXPECT_THROW(CachedTestable(constraint, 0.1, 10, 0), std::invalid_argument);
+}
+
+TEST_F(CachedTestableTest, ForwardsToWrappedConstraint)
+{
+  CachedTestable cache(constraint, 0.1);
+  EXPECT_EQ(stateSpace, cache.getStateSpace());
+  EXPECT_EQ(constraint, cache.getTestable());
+  EXPECT_DOUBLE_EQ(0.1, cache.getResolution());
+
+  EXPECT_TRUE(test(cache, 1., 0.));
+  EXPECT_FALSE(test(cache, -1., 0.));
+  EXPECT_EQ(2, constraint->numCalls);
+}
+
+TEST_F(CachedTestableTest, ReusesResultsWithinResolution)
+{
+  CachedTestable cache(constraint, 0.1);
+
+  EXPECT_TRUE(test(cache, 1., 2.));
+  EXPECT_TRUE(test(cache, 1., 2.));
+  EXPECT_TRUE(test(cache, 1.02, 1.98));
+  EXPECT_EQ(1, constraint->numCalls);
+
+  EXPECT_TRUE(test(cache, 1.2, 2.));
+  EXPECT_EQ(2, constraint->numCalls);
+
+  const auto statistics = cache.getStatistics();
+  EXPECT_EQ(2u, statistics.numHits);
+  EXPECT_EQ(2u, statistics.numMisses);
+  EXPECT_EQ(2u, statistics.numEntries);
+}
+
+TEST_F(CachedTestableTest, OutcomeBypassesCache)
+{
+  CachedTestable cache(constraint, 0.1);
+  EXPECT_FALSE(test(cache, -1., 0.));
+
+  auto state = stateSpace->createState();
+  stateSpace->setValue(state, Eigen::Vector2d(-1., 0.));
+  auto outcome = cache.createOutcome();
+  EXPECT_FALSE(cache.isSatisfied(state, outcome.get()));
+  EXPECT_FALSE(outcome->isSatisfied());
+  EXPECT_EQ(2, constraint->numCalls);
+}
+
+TEST_F(CachedTestableTest, NestedCachesKeepTheirOwnKeys)
+{
+  auto inner = std::make_shared<CachedTestable>(constraint, 1.);
+  CachedTestable outer(inner, 0.01);
+
+  EXPECT_FALSE(test(outer, -2., 0.5));
+  EXPECT_FALSE(test(outer, -2., 0.5));
+  EXPECT_EQ(1, constraint->numCalls);
+  EXPECT_EQ(1u, outer.getStatistics().numHits);
+  EXPECT_EQ(0u, inner->getStatistics().numHits);
+
+  // A state that only shares a cell of the inner cache is answered by it.
+  EXPECT_FALSE(test(outer, -2.2, 0.5));
+  EXPECT_EQ(1, constraint->numCalls);
+  EXPECT_EQ(1u, inner->getStatistics().numHits);
+}
+
+TEST_F(CachedTestableTest, EvictsOldestEntries)
+{
+  CachedTestable cache(constraint, 0.1, 2, 1);
+  EXPECT_EQ(2u, cache.getCapacity());
+
+  test(cache, 1., 0.);
+  test(cache, 2., 0.);
+  test(cache, 3., 0.);
+  EXPECT_EQ(2u, cache.getStatistics().numEntries);
+  EXPECT_EQ(3, constraint->numCalls);
+
+  test(cache, 3., 0.);
+  test(cache, 2., 0.);
+  EXPECT_EQ(3, constraint->numCalls);
+
+  test(cache, 1., 0.);
+  EXPECT_EQ(4, constraint->numCalls);
+}
+
+TEST_F(CachedTestableTest, Clear)
+{
+  CachedTestable cache(constraint, 0.1);
+  test(cache, 1., 0.);
+  test(cache, 1., 0.);
+
+  cache.clear();
+  const auto statistics = cache.getStatistics();
+  EXPECT_EQ(0u, statistics.numHits);
+  EXPECT_EQ(0u, statistics.numMisses);
+  EXPECT_EQ(0u, statistics.numEntries);
+
+  test(cache, 1., 0.);
+  EXPECT_EQ(2, constraint->numCalls);
+}
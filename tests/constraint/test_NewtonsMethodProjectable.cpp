@@ -211,3 +211,119 @@ TEST(NewtonsMethodProjectable, ProjectTSRRotation)
 
   EXPECT_TRUE(expected.isApprox(projected, 5e-4));
 }
+
+TEST(NewtonsMethodProjectable, ProjectReportsStatistics)
+{
+  // Constraint: x^2 - 1 = 0.
+  NewtonsMethodProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      10,
+      1e-8);
+
+  R1 rvss;
+  auto seedState = rvss.createState();
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(-2));
+  auto out = rvss.createState();
+
+  NewtonsMethodProjectable::ProjectionStatistics statistics;
+  EXPECT_TRUE(projector.project(seedState, out, &statistics));
+  EXPECT_TRUE(statistics.converged);
+  EXPECT_LT(0, statistics.numIterations);
+  EXPECT_EQ(statistics.numIterations + 1, statistics.numEvaluations);
+  EXPECT_GE(1e-6, statistics.violation);
+
+  // A satisfied state is not moved.
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(1));
+  EXPECT_TRUE(projector.project(seedState, out, &statistics));
+  EXPECT_EQ(0, statistics.numIterations);
+  EXPECT_EQ(1, statistics.numEvaluations);
+  EXPECT_DOUBLE_EQ(1, rvss.getValue(out)(0));
+
+  // One iteration is not enough to get close to the solution.
+  NewtonsMethodProjectable oneIterationProjector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      1,
+      1e-8);
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(-2));
+  EXPECT_FALSE(oneIterationProjector.project(seedState, out, &statistics));
+  EXPECT_FALSE(statistics.converged);
+  EXPECT_EQ(1, statistics.numIterations);
+  EXPECT_LT(1e-6, statistics.violation);
+}
+
+TEST(NewtonsMethodProjectable, SetDampingThrowsOnNonPositiveDamping)
+{
+  NewtonsMethodProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({0.1}));
+
+  EXPECT_THROW(projector.setDamping(0), std::invalid_argument);
+  EXPECT_THROW(projector.setDamping(-1), std::invalid_argument);
+
+  projector.setDamping(0.1);
+  EXPECT_DOUBLE_EQ(0.1, projector.getDamping());
+}
+
+TEST(NewtonsMethodProjectable, ProjectDampedLeastSquares)
+{
+  // Constraint: x^2 - 1 = 0.
+  NewtonsMethodProjectable projector(
+      std::make_shared<PolynomialConstraint<1>>(Eigen::Vector3d(-1, 0, 1)),
+      std::vector<double>({1e-6}),
+      100,
+      1e-8);
+  projector.setStepMethod(
+      NewtonsMethodProjectable::StepMethod::DAMPED_LEAST_SQUARES);
+  EXPECT_EQ(
+      NewtonsMethodProjectable::StepMethod::DAMPED_LEAST_SQUARES,
+      projector.getStepMethod());
+
+  R1 rvss;
+  auto seedState = rvss.createState();
+  auto out = rvss.createState();
+  NewtonsMethodProjectable::ProjectionStatistics statistics;
+
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(-2));
+  EXPECT_TRUE(projector.project(seedState, out, &statistics));
+  EXPECT_NEAR(-1, rvss.getValue(out)(0), 1e-5);
+  EXPECT_TRUE(statistics.converged);
+
+  // The Newton step from x = 0.1 overshoots to x = 5.05, which the line
+  // search shortens.
+  seedState.setValue(Eigen::Matrix<double, 1, 1>(0.1));
+  EXPECT_TRUE(projector.project(seedState, out, &statistics));
+  EXPECT_NEAR(1, rvss.getValue(out)(0), 1e-5);
+  EXPECT_LT(statistics.numIterations + 1, statistics.numEvaluations);
+}
+
+TEST(NewtonsMethodProjectable, ProjectTSRDampedLeastSquares)
+{
+  std::shared_ptr<TSR> tsr = std::make_shared<TSR>();
+
+  Eigen::MatrixXd Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw(0, 0) = 1;
+  Bw(0, 1) = 2;
+  Bw(3, 0) = M_PI_4;
+  Bw(3, 1) = M_PI_2;
+  tsr->mBw = Bw;
+
+  auto space = tsr->getSE3();
+  auto seedState = space->createState();
+  Eigen::Isometry3d isometry = Eigen::Isometry3d::Identity();
+  isometry.translation() = Eigen::Vector3d(-1, 0, 1);
+  seedState.setIsometry(isometry);
+
+  NewtonsMethodProjectable projector(
+      tsr, std::vector<double>(6, 1e-4), 1000, 1e-8);
+  projector.setStepMethod(
+      NewtonsMethodProjectable::StepMethod::DAMPED_LEAST_SQUARES);
+
+  auto out = space->createState();
+  EXPECT_TRUE(projector.project(seedState, out));
+
+  Eigen::VectorXd value;
+  tsr->getValue(out, value);
+  EXPECT_GE(1e-4, value.maxCoeff());
+}
@@ -275,6 +275,38 @@ TEST_F(
   }
 }
 
+//==============================================================================
+TEST_F(RnBoxConstraintTests, Rx_isSatisfiedBatch_MatchesIsSatisfied)
+{
+  RnBoxConstraint constraint(
+      mRxStateSpace, mRng->clone(), mLowerLimits, mUpperLimits);
+
+  std::vector<Rn::ScopedState> states;
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  const auto numStates = mGoodValues.size() + mBadValues.size();
+  states.reserve(numStates);
+  for (std::size_t i = 0; i < numStates; ++i)
+  {
+    states.emplace_back(mRxStateSpace->createState());
+    states.back().setValue(
+        i < mGoodValues.size() ? mGoodValues[i]
+                               : mBadValues[i - mGoodValues.size()]);
+    statePtrs.emplace_back(states.back());
+  }
+
+  std::vector<bool> results;
+  EXPECT_FALSE(constraint.isSatisfiedBatch(statePtrs, results, false));
+  ASSERT_EQ(states.size(), results.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+    EXPECT_EQ(constraint.isSatisfied(states[i]), results[i]);
+
+  statePtrs.resize(mGoodValues.size());
+  EXPECT_TRUE(constraint.isSatisfiedBatch(statePtrs, results));
+  ASSERT_EQ(mGoodValues.size(), results.size());
+  for (const auto result : results)
+    EXPECT_TRUE(result);
+}
+
 //==============================================================================
 TEST_F(RnBoxConstraintTests, R2_project_SatisfiesConstraint_DoesNothing)
 {
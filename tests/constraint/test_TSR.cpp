@@ -389,6 +389,89 @@ TEST(TSR, GetValueAndJacobian)
   EXPECT_TRUE(jacExpected.isApprox(jac));
 }
 
+TEST(TSR, GetJacobianMatchesFiniteDifferences)
+{
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.translation() = Eigen::Vector3d(0.5, -1, 2);
+  T0_w.linear() = dart::math::expMapRot(Eigen::Vector3d(0.3, -0.2, 0.5));
+
+  Eigen::Isometry3d Tw_e(Eigen::Isometry3d::Identity());
+  Tw_e.translation() = Eigen::Vector3d(0, 0, 0.1);
+  Tw_e.linear() = dart::math::expMapRot(Eigen::Vector3d(-0.4, 0.1, 0.2));
+
+  Eigen::Matrix<double, 6, 2> Bw(Eigen::Matrix<double, 6, 2>::Zero());
+  Bw << -0.1, 0.1, -0.1, 0.1, 0, 0.2, -0.1, 0.1, -0.1, 0.1, -M_PI, M_PI;
+
+  TSR tsr(T0_w, Bw, Tw_e);
+  auto state = tsr.getSE3()->createState();
+
+  const std::vector<Eigen::Vector6d> twists{
+      (Eigen::Vector6d() << 0.2, 0.4, -0.3, 1, 2, -1).finished(),
+      (Eigen::Vector6d() << 1.1, -0.7, 0.9, -0.5, 0.3, 2).finished(),
+      (Eigen::Vector6d() << 1e-3, 0, 0, 0.7, -0.4, 0.3).finished()};
+
+  for (const auto& twist : twists)
+  {
+    state.setIsometry(dart::math::expMap(twist));
+
+    Eigen::MatrixXd jacobian;
+    tsr.getJacobian(state, jacobian);
+    ASSERT_EQ(6, jacobian.rows());
+    ASSERT_EQ(6, jacobian.cols());
+
+    static constexpr double eps = 1e-6;
+    auto perturbed = tsr.getSE3()->createState();
+    for (int i = 0; i < 6; ++i)
+    {
+      Eigen::Vector6d posit(twist), negat(twist);
+      posit(i) += eps;
+      negat(i) -= eps;
+
+      Eigen::VectorXd positValue, negatValue;
+      perturbed.setIsometry(dart::math::expMap(posit));
+      tsr.getValue(perturbed, positValue);
+      perturbed.setIsometry(dart::math::expMap(negat));
+      tsr.getValue(perturbed, negatValue);
+
+      const Eigen::VectorXd expected = (positValue - negatValue) / (2 * eps);
+      EXPECT_TRUE(jacobian.col(i).isApprox(expected, 1e-5))
+          << "column " << i << ":\n"
+          << jacobian.col(i).transpose() << "\nexpected:\n"
+          << expected.transpose();
+    }
+  }
+}
+
+TEST(TSR, CachedTransformsFollowAssignment)
+{
+  Eigen::Matrix<double, 6, 2> Bw(Eigen::Matrix<double, 6, 2>::Zero());
+  Bw(0, 1) = 2;
+
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.translation() = Eigen::Vector3d(1, 2, 3);
+  Eigen::Isometry3d Tw_e(Eigen::Isometry3d::Identity());
+  Tw_e.translation() = Eigen::Vector3d(0, 0, -1);
+
+  TSR tsr(Eigen::Isometry3d::Identity(), Bw);
+  tsr.mT0_w = T0_w;
+  tsr.mTw_e = Tw_e;
+  TSR expectedTsr(T0_w, Bw, Tw_e);
+
+  auto state = tsr.getSE3()->createState();
+  Eigen::Isometry3d isometry(Eigen::Isometry3d::Identity());
+  isometry.translation() = Eigen::Vector3d(4, 2, 2);
+  state.setIsometry(isometry);
+
+  Eigen::VectorXd value, expectedValue;
+  Eigen::MatrixXd jacobian, expectedJacobian;
+  tsr.getValueAndJacobian(state, value, jacobian);
+  expectedTsr.getValueAndJacobian(state, expectedValue, expectedJacobian);
+
+  EXPECT_TRUE(value.isApprox(expectedValue));
+  EXPECT_TRUE(jacobian.isApprox(expectedJacobian));
+  EXPECT_DOUBLE_EQ(1, value(0));
+}
+
 TEST(TSR, GetConstraintTypes)
 {
   // This tests current behavior, but it may fail.
@@ -437,6 +520,65 @@ TEST(TSR, IsSatisfied)
   EXPECT_FALSE(tsr.isSatisfied(state));
 }
 
+TEST(TSR, ProjectInsideIsUnchanged)
+{
+  Eigen::Matrix<double, 6, 2> Bw(Eigen::Matrix<double, 6, 2>::Zero());
+  Bw << 0, 2, -1, 1, -1, 1, -0.5, 0.5, -0.5, 0.5, -M_PI, M_PI;
+
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.translation() = Eigen::Vector3d(1, 0, 0);
+  TSR tsr(T0_w, Bw);
+
+  auto state = tsr.getSE3()->createState();
+  Eigen::Isometry3d isometry(Eigen::Isometry3d::Identity());
+  isometry.translation() = Eigen::Vector3d(2, 0.5, -0.5);
+  isometry.linear()
+      = dart::math::eulerZYXToMatrix(Eigen::Vector3d(2, 0.3, -0.2));
+  state.setIsometry(isometry);
+
+  auto out = tsr.getSE3()->createState();
+  EXPECT_TRUE(tsr.project(state, out));
+  EXPECT_TRUE(out.getIsometry().isApprox(isometry));
+}
+
+TEST(TSR, ProjectOutside)
+{
+  Eigen::Matrix<double, 6, 2> Bw(Eigen::Matrix<double, 6, 2>::Zero());
+  Bw << 0, 2, -1, 1, 0, 0, -0.5, 0.5, 0, 0, 0, M_PI / 2;
+
+  Eigen::Isometry3d T0_w(Eigen::Isometry3d::Identity());
+  T0_w.translation() = Eigen::Vector3d(0.5, -1, 2);
+  T0_w.linear() = dart::math::expMapRot(Eigen::Vector3d(0.3, -0.2, 0.5));
+  Eigen::Isometry3d Tw_e(Eigen::Isometry3d::Identity());
+  Tw_e.translation() = Eigen::Vector3d(0, 0, 0.1);
+  TSR tsr(T0_w, Bw, Tw_e);
+
+  auto state = tsr.getSE3()->createState();
+  auto out = tsr.getSE3()->createState();
+
+  // Translation, roll and pitch outside, and yaw closer to the lower bound
+  // modulo 2 pi.
+  Eigen::Isometry3d Tw_s(Eigen::Isometry3d::Identity());
+  Tw_s.translation() = Eigen::Vector3d(3, 0.5, -2);
+  Tw_s.linear()
+      = dart::math::eulerZYXToMatrix(Eigen::Vector3d(-0.5, 0.3, 1));
+  state.setIsometry(T0_w * Tw_s * Tw_e);
+
+  EXPECT_FALSE(tsr.isSatisfied(state));
+  EXPECT_TRUE(tsr.project(state, out));
+  EXPECT_TRUE(tsr.isSatisfied(out));
+
+  Eigen::Isometry3d expectedTw_s(Eigen::Isometry3d::Identity());
+  expectedTw_s.translation() = Eigen::Vector3d(2, 0.5, 0);
+  expectedTw_s.linear()
+      = dart::math::eulerZYXToMatrix(Eigen::Vector3d(0, 0, 0.5));
+  EXPECT_TRUE(out.getIsometry().isApprox(T0_w * expectedTw_s * Tw_e));
+
+  // Projecting in place.
+  EXPECT_TRUE(tsr.project(state, state));
+  EXPECT_TRUE(state.getIsometry().isApprox(out.getIsometry()));
+}
+
 TEST(TSR, getSE3EqualToGetStateSpace)
 {
   TSR tsr;
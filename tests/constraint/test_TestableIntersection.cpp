@@ -1,13 +1,16 @@
 #include <stdexcept>
 #include <gtest/gtest.h>
 #include <aikido/constraint/TestableIntersection.hpp>
+#include <aikido/constraint/uniform/RnBoxConstraint.hpp>
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/statespace/SO2.hpp>
 #include "MockConstraints.hpp"
 
 using aikido::constraint::TestableIntersection;
 using aikido::constraint::Testable;
+using aikido::constraint::uniform::R1BoxConstraint;
 using aikido::statespace::R0;
+using aikido::statespace::R1;
 
 TEST(ConjuntionConstraintTest, ThrowOnNullStateSpace)
 {
@@ -98,3 +101,151 @@ TEST(TestableIntersectionTest, ThrowIfDifferentStateSpaceConstraintAdded)
   TestableIntersection cc{ss1};
   EXPECT_THROW(cc.addConstraint(ss2C), std::invalid_argument);
 }
+
+TEST(TestableIntersectionTest, IsSatisfiedBatchMatchesIsSatisfied)
+{
+  auto ss = std::make_shared<R1>();
+  auto pc = std::make_shared<PassingConstraint>(ss);
+  using Vector1d = Eigen::Matrix<double, 1, 1>;
+  auto lower = std::make_shared<R1BoxConstraint>(
+      ss, nullptr, Vector1d(0.), Vector1d(10.));
+  auto upper = std::make_shared<R1BoxConstraint>(
+      ss, nullptr, Vector1d(-10.), Vector1d(5.));
+
+  TestableIntersection intersection{
+      ss, std::vector<std::shared_ptr<Testable>>({pc, lower, upper})};
+
+  const std::vector<double> values{1., -1., 6., 3., 11., 0.};
+  std::vector<R1::ScopedState> states;
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  for (const auto value : values)
+  {
+    states.emplace_back(ss->createState());
+    states.back().setValue(Vector1d(value));
+    statePtrs.emplace_back(states.back());
+  }
+
+  std::vector<bool> results;
+  EXPECT_FALSE(intersection.isSatisfiedBatch(statePtrs, results, false));
+  ASSERT_EQ(values.size(), results.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    EXPECT_EQ(intersection.isSatisfied(statePtrs[i]), results[i]);
+
+  EXPECT_FALSE(intersection.isSatisfiedBatch(statePtrs, results, true));
+  EXPECT_FALSE(results[1]);
+
+  statePtrs = {statePtrs[0], statePtrs[3], statePtrs[5]};
+  EXPECT_TRUE(intersection.isSatisfiedBatch(statePtrs, results));
+  EXPECT_EQ(std::vector<bool>(3, true), results);
+}
+
+TEST(TestableIntersectionTest, IsSatisfiedBatchStopOnFailureTestsPrefix)
+{
+  auto ss = std::make_shared<R1>();
+  using Vector1d = Eigen::Matrix<double, 1, 1>;
+  auto upper = std::make_shared<R1BoxConstraint>(
+      ss, nullptr, Vector1d(-10.), Vector1d(5.));
+  auto lower = std::make_shared<R1BoxConstraint>(
+      ss, nullptr, Vector1d(0.), Vector1d(10.));
+
+  // The first constraint stops at 6., but -1. comes before it and only fails
+  // the second constraint.
+  TestableIntersection intersection{
+      ss, std::vector<std::shared_ptr<Testable>>({upper, lower})};
+
+  const std::vector<double> values{1., -1., 6., 3.};
+  std::vector<R1::ScopedState> states;
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  for (const auto value : values)
+  {
+    states.emplace_back(ss->createState());
+    states.back().setValue(Vector1d(value));
+    statePtrs.emplace_back(states.back());
+  }
+
+  std::vector<bool> results;
+  EXPECT_FALSE(intersection.isSatisfiedBatch(statePtrs, results, true));
+  ASSERT_EQ(values.size(), results.size());
+  EXPECT_TRUE(results[0]);
+  EXPECT_FALSE(results[1]);
+  EXPECT_FALSE(results[2]);
+  EXPECT_FALSE(results[3]);
+}
+
+TEST(TestableIntersectionTest, AdaptiveOrderingTestsFailingConstraintFirst)
+{
+  auto ss = std::make_shared<R0>();
+  auto pc = std::make_shared<PassingConstraint>(ss);
+  auto fc = std::make_shared<FailingConstraint>(ss);
+
+  TestableIntersection intersection{
+      ss, std::vector<std::shared_ptr<Testable>>({pc, fc})};
+  EXPECT_FALSE(intersection.isAdaptiveOrdering());
+
+  // Statistics are only collected in adaptive mode.
+  EXPECT_FALSE(intersection.isSatisfied(nullptr));
+  auto statistics = intersection.getConstraintStatistics();
+  ASSERT_EQ(2u, statistics.size());
+  EXPECT_EQ(0u, statistics[0].numEvaluations);
+  EXPECT_EQ(0u, statistics[1].numEvaluations);
+
+  intersection.setAdaptiveOrdering(true);
+  EXPECT_TRUE(intersection.isAdaptiveOrdering());
+
+  const std::size_t numStates = 1000;
+  for (std::size_t i = 0; i < numStates; ++i)
+    EXPECT_FALSE(intersection.isSatisfied(nullptr));
+
+  statistics = intersection.getConstraintStatistics();
+  ASSERT_EQ(2u, statistics.size());
+  EXPECT_EQ(numStates, statistics[1].numEvaluations);
+  EXPECT_EQ(numStates, statistics[1].numRejections);
+  EXPECT_EQ(0u, statistics[0].numRejections);
+  EXPECT_LT(statistics[0].numEvaluations, numStates / 10);
+  EXPECT_GE(statistics[1].totalDuration, 0.);
+
+  intersection.resetConstraintStatistics();
+  statistics = intersection.getConstraintStatistics();
+  EXPECT_EQ(0u, statistics[0].numEvaluations);
+  EXPECT_EQ(0u, statistics[1].numEvaluations);
+
+  // Constraints added later get statistics, too.
+  intersection.addConstraint(pc);
+  EXPECT_FALSE(intersection.isSatisfied(nullptr));
+  EXPECT_EQ(3u, intersection.getConstraintStatistics().size());
+}
+
+TEST(TestableIntersectionTest, AdaptiveOrderingIsSatisfiedBatch)
+{
+  auto ss = std::make_shared<R1>();
+  auto pc = std::make_shared<PassingConstraint>(ss);
+  using Vector1d = Eigen::Matrix<double, 1, 1>;
+  auto box = std::make_shared<R1BoxConstraint>(
+      ss, nullptr, Vector1d(0.), Vector1d(1.));
+
+  TestableIntersection intersection{
+      ss, std::vector<std::shared_ptr<Testable>>({pc, box})};
+  intersection.setAdaptiveOrdering(true);
+
+  std::vector<R1::ScopedState> states;
+  std::vector<const aikido::statespace::StateSpace::State*> statePtrs;
+  for (int i = 0; i < 100; ++i)
+  {
+    states.emplace_back(ss->createState());
+    states.back().setValue(Vector1d(i == 50 ? 0.5 : 2.));
+    statePtrs.emplace_back(states.back());
+  }
+
+  std::vector<bool> results;
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_FALSE(intersection.isSatisfiedBatch(statePtrs, results, false));
+    for (std::size_t j = 0; j < statePtrs.size(); ++j)
+      EXPECT_EQ(j == 50, results[j]);
+  }
+
+  const auto statistics = intersection.getConstraintStatistics();
+  EXPECT_EQ(1000u, statistics[1].numEvaluations);
+  EXPECT_EQ(990u, statistics[1].numRejections);
+  EXPECT_LT(statistics[0].numEvaluations, 1000u);
+}
@@ -28,6 +28,45 @@ using ::dart::dynamics::RevoluteJoint;
 const static std::chrono::milliseconds waitTime{0};
 const static std::chrono::milliseconds stepTime{100};
 
+/// Forwards to another TrajectoryExecutor, but can be told to reject every
+/// trajectory in validate().
+class RejectingTrajectoryExecutor : public TrajectoryExecutor
+{
+public:
+  explicit RejectingTrajectoryExecutor(
+      std::shared_ptr<TrajectoryExecutor> executor)
+    : mExecutor(std::move(executor)), mReject(false)
+  {
+    // Do nothing
+  }
+
+  void validate(TrajectoryPtr traj) override
+  {
+    if (mReject)
+      throw std::invalid_argument("Trajectory rejected.");
+
+    mExecutor->validate(std::move(traj));
+  }
+
+  std::future<void> execute(TrajectoryPtr traj) override
+  {
+    return mExecutor->execute(std::move(traj));
+  }
+
+  void step(const std::chrono::system_clock::time_point& timepoint) override
+  {
+    mExecutor->step(timepoint);
+  }
+
+  void abort() override
+  {
+    mExecutor->abort();
+  }
+
+  std::shared_ptr<TrajectoryExecutor> mExecutor;
+  bool mReject;
+};
+
 class QueuedTrajectoryExecutorTest : public testing::Test
 {
 public:
@@ -106,6 +145,13 @@ TEST_F(QueuedTrajectoryExecutorTest, constructor_Passes)
   EXPECT_NO_THROW(QueuedTrajectoryExecutor executor(std::move(mExecutor)));
 }
 
+TEST_F(QueuedTrajectoryExecutorTest, constructor_NegativeTolerance_Throws)
+{
+  EXPECT_THROW(
+      QueuedTrajectoryExecutor(std::move(mExecutor), true, -1.0),
+      std::invalid_argument);
+}
+
 TEST_F(QueuedTrajectoryExecutorTest, execute_WaitOnFuture_TrajectoryWasExecuted)
 {
   QueuedTrajectoryExecutor executor(std::move(mExecutor));
@@ -272,3 +318,137 @@ TEST_F(
   EXPECT_GT(mSkeleton->getDof(0)->getPosition(), 0.0);
   EXPECT_LT(mSkeleton->getDof(0)->getPosition(), 1.0);
 }
+
+TEST_F(
+    QueuedTrajectoryExecutorTest,
+    execute_LookAhead_NextTrajectoryStartsWithoutStall)
+{
+  QueuedTrajectoryExecutor executor(std::move(mExecutor), true);
+
+  EXPECT_DOUBLE_EQ(mSkeleton->getDof(0)->getPosition(), 0.0);
+
+  auto simulationClock = std::chrono::system_clock::now();
+  auto f1 = executor.execute(mTraj1);
+  auto f2 = executor.execute(mTraj2);
+
+  std::future_status status;
+  do
+  {
+    simulationClock += stepTime;
+    executor.step(simulationClock);
+    status = f1.wait_for(waitTime);
+  } while (status != std::future_status::ready);
+
+  f1.get();
+
+  // The step that finishes the first trajectory already executes the second.
+  EXPECT_GT(mSkeleton->getDof(0)->getPosition(), 1.0);
+  EXPECT_LT(mSkeleton->getDof(0)->getPosition(), 2.0);
+
+  do
+  {
+    simulationClock += stepTime;
+    executor.step(simulationClock);
+    status = f2.wait_for(waitTime);
+  } while (status != std::future_status::ready);
+
+  f2.get();
+
+  EXPECT_DOUBLE_EQ(mSkeleton->getDof(0)->getPosition(), 2.0);
+}
+
+TEST_F(
+    QueuedTrajectoryExecutorTest,
+    execute_LookAheadDiscontinuousTrajectory_StartsAfterPreviousFinished)
+{
+  QueuedTrajectoryExecutor executor(std::move(mExecutor), true);
+
+  auto simulationClock = std::chrono::system_clock::now();
+  auto f1 = executor.execute(mTraj1);
+  auto f2 = executor.execute(mTraj1);
+
+  std::future_status status;
+  do
+  {
+    simulationClock += stepTime;
+    executor.step(simulationClock);
+    status = f1.wait_for(waitTime);
+  } while (status != std::future_status::ready);
+
+  f1.get();
+
+  EXPECT_DOUBLE_EQ(mSkeleton->getDof(0)->getPosition(), 1.0);
+
+  do
+  {
+    simulationClock += stepTime;
+    executor.step(simulationClock);
+    status = f2.wait_for(waitTime);
+  } while (status != std::future_status::ready);
+
+  f2.get();
+
+  EXPECT_DOUBLE_EQ(mSkeleton->getDof(0)->getPosition(), 1.0);
+}
+
+TEST_F(
+    QueuedTrajectoryExecutorTest,
+    execute_LookAheadRejectedTrajectory_StartsAfterPreviousFinished)
+{
+  auto rejectingExecutor
+      = std::make_shared<RejectingTrajectoryExecutor>(std::move(mExecutor));
+  QueuedTrajectoryExecutor executor(rejectingExecutor, true);
+
+  auto simulationClock = std::chrono::system_clock::now();
+  auto f1 = executor.execute(mTraj1);
+  auto f2 = executor.execute(mTraj2);
+
+  // The second trajectory was accepted when it was queued, but is rejected
+  // when it would be appended to the first.
+  rejectingExecutor->mReject = true;
+
+  std::future_status status;
+  do
+  {
+    simulationClock += stepTime;
+    executor.step(simulationClock);
+    status = f1.wait_for(waitTime);
+  } while (status != std::future_status::ready);
+
+  f1.get();
+
+  EXPECT_DOUBLE_EQ(mSkeleton->getDof(0)->getPosition(), 1.0);
+
+  do
+  {
+    simulationClock += stepTime;
+    executor.step(simulationClock);
+    status = f2.wait_for(waitTime);
+  } while (status != std::future_status::ready);
+
+  f2.get();
+
+  EXPECT_DOUBLE_EQ(mSkeleton->getDof(0)->getPosition(), 2.0);
+}
+
+TEST_F(
+    QueuedTrajectoryExecutorTest,
+    abort_LookAheadRunningTrajectories_AllTrajectoriesAborted)
+{
+  QueuedTrajectoryExecutor executor(std::move(mExecutor), true);
+
+  auto f1 = executor.execute(mTraj1);
+  auto f2 = executor.execute(mTraj2);
+
+  auto simulationClock = std::chrono::system_clock::now();
+  simulationClock += stepTime;
+  executor.step(simulationClock);
+
+  executor.abort();
+
+  EXPECT_EQ(f1.wait_for(waitTime), std::future_status::ready);
+  EXPECT_EQ(f2.wait_for(waitTime), std::future_status::ready);
+
+  EXPECT_THROW(f1.get(), std::runtime_error);
+  EXPECT_THROW(f2.get(), std::runtime_error);
+}
@@ -130,3 +130,38 @@ TEST_F(MotionValidatorTest, BadValidationSmallResolution)
       = std::make_shared<aikido::planner::ompl::MotionValidator>(si, 0.5);
   EXPECT_TRUE(validator1->checkMotion(state1, state2));
 }
+
+TEST_F(MotionValidatorTest, ConstructorThrowsOnNullWorkerConstraint)
+{
+  std::vector<aikido::constraint::TestablePtr> workerConstraints{nullptr};
+  EXPECT_THROW(
+      MotionValidator(si, 0.1, workerConstraints), std::invalid_argument);
+}
+
+TEST_F(MotionValidatorTest, ParallelValidationMatchesSequential)
+{
+  std::vector<aikido::constraint::TestablePtr> workerConstraints;
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    workerConstraints.emplace_back(
+        std::make_shared<MockTranslationalRobotConstraint>(
+            stateSpace,
+            Eigen::Vector3d(-0.1, -0.1, -0.1),
+            Eigen::Vector3d(0.1, 0.1, 0.1)));
+  }
+
+  MotionValidator parallelValidator(si, 0.1, workerConstraints);
+  EXPECT_EQ(3u, parallelValidator.getNumWorkers());
+  EXPECT_EQ(0u, validator->getNumWorkers());
+
+  setTranslationalState(Eigen::Vector3d(-5, -5, 0), stateSpace, state1);
+  setTranslationalState(Eigen::Vector3d(-5, 5, 0), stateSpace, state2);
+  EXPECT_TRUE(parallelValidator.checkMotion(state1, state2));
+
+  setTranslationalState(Eigen::Vector3d(5, 5, 0), stateSpace, state2);
+  EXPECT_FALSE(parallelValidator.checkMotion(state1, state2));
+
+  // Segments too short to be split fall back to sequential checking.
+  setTranslationalState(Eigen::Vector3d(-5, -4.9, 0), stateSpace, state2);
+  EXPECT_TRUE(parallelValidator.checkMotion(state1, state2));
+}
@@ -1,10 +1,16 @@
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
 #include <ompl/geometric/planners/rrt/RRTConnect.h>
 #include <aikido/common/StepSequence.hpp>
 #include <aikido/constraint.hpp>
 #include <aikido/planner/ompl/CRRT.hpp>
 #include <aikido/planner/ompl/CRRTConnect.hpp>
+#include <aikido/planner/ompl/LazySP.hpp>
 #include <aikido/planner/ompl/MotionValidator.hpp>
 #include <aikido/planner/ompl/Planner.hpp>
+#include <aikido/planner/ompl/RoadmapPlanner.hpp>
 #include "../../constraint/MockConstraints.hpp"
 #include "OMPLTestHelpers.hpp"
 
@@ -12,7 +18,10 @@ using StateSpace = aikido::statespace::dart::MetaSkeletonStateSpace;
 using aikido::planner::ompl::getSpaceInformation;
 using aikido::planner::ompl::CRRT;
 using aikido::planner::ompl::CRRTConnect;
+using aikido::planner::ompl::LazySP;
+using aikido::planner::ompl::RoadmapPlanner;
 using aikido::planner::ompl::ompl_dynamic_pointer_cast;
+using aikido::planner::ompl::ompl_make_shared;
 
 TEST_F(PlannerTest, PlanToConfiguration)
 {
@@ -53,6 +62,299 @@ TEST_F(PlannerTest, PlanToConfiguration)
   EXPECT_TRUE(r0.getValue().isApprox(goalPose));
 }
 
+TEST_F(PlannerTest, PlanLazySPToConfiguration)
+{
+  Eigen::Vector3d startPose(-5, -5, 0);
+  Eigen::Vector3d goalPose(5, 5, 0);
+
+  auto startState = stateSpace->createState();
+  auto subState1 = stateSpace->getSubStateHandle<R3>(startState, 0);
+  subState1.setValue(startPose);
+
+  auto goalState = stateSpace->createState();
+  auto subState2 = stateSpace->getSubStateHandle<R3>(goalState, 0);
+  subState2.setValue(goalPose);
+
+  // Plan
+  auto traj = aikido::planner::ompl::planOMPL<LazySP>(
+      startState,
+      goalState,
+      stateSpace,
+      interpolator,
+      std::move(dmetric),
+      std::move(sampler),
+      collConstraint,
+      std::move(boundsConstraint),
+      std::move(boundsProjection),
+      5.0,
+      0.1);
+  ASSERT_TRUE(traj != nullptr);
+
+  // Check the first waypoint
+  auto s0 = stateSpace->createState();
+  traj->evaluate(0, s0);
+  auto r0 = s0.getSubStateHandle<R3>(0);
+  EXPECT_TRUE(r0.getValue().isApprox(startPose));
+
+  // Check the last waypoint
+  traj->evaluate(traj->getDuration(), s0);
+  r0 = s0.getSubStateHandle<R3>(0);
+  EXPECT_TRUE(r0.getValue().isApprox(goalPose));
+
+  // Check that the waypoints avoid the obstacle
+  for (std::size_t i = 0; i < traj->getNumWaypoints(); ++i)
+    EXPECT_TRUE(collConstraint->isSatisfied(traj->getWaypoint(i)));
+}
+
+TEST_F(PlannerTest, LazySPReusesRoadmap)
+{
+  auto si = getSpaceInformation(
+      stateSpace,
+      interpolator,
+      std::move(dmetric),
+      std::move(sampler),
+      std::move(collConstraint),
+      std::move(boundsConstraint),
+      std::move(boundsProjection),
+      0.1);
+  auto sspace = ompl_dynamic_pointer_cast<
+      aikido::planner::ompl::GeometricStateSpace>(si->getStateSpace());
+  auto planner = ompl_make_shared<LazySP>(si);
+
+  auto firstState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(firstState, 0)
+      .setValue(Eigen::Vector3d(-5, -5, 0));
+  auto secondState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(secondState, 0)
+      .setValue(Eigen::Vector3d(5, 5, 0));
+
+  auto firstPose = sspace->allocState(firstState);
+  auto secondPose = sspace->allocState(secondState);
+
+  auto pdef = ompl_make_shared<ompl::base::ProblemDefinition>(si);
+  pdef->setStartAndGoalStates(firstPose, secondPose);
+  auto traj = aikido::planner::ompl::planOMPL(
+      planner, pdef, stateSpace, interpolator, 5.0);
+  EXPECT_TRUE(traj != nullptr);
+
+  const auto numVertices = planner->getNumVertices();
+  const auto numEvaluations = planner->getNumEvaluations();
+  EXPECT_LT(0u, numEvaluations);
+
+  // Planning back reuses the roadmap, including the edges already checked, so
+  // it needs no new samples and fewer evaluations. The start and goal
+  // vertices of the first query are replaced by those of the second.
+  pdef = ompl_make_shared<ompl::base::ProblemDefinition>(si);
+  pdef->setStartAndGoalStates(secondPose, firstPose);
+  traj = aikido::planner::ompl::planOMPL(
+      planner, pdef, stateSpace, interpolator, 5.0);
+  EXPECT_TRUE(traj != nullptr);
+  EXPECT_EQ(numVertices, planner->getNumVertices());
+  EXPECT_LT(planner->getNumEvaluations() - numEvaluations, numEvaluations);
+
+  // Clearing the query removes its start and goal vertices.
+  planner->clearQuery();
+  EXPECT_EQ(numVertices - 2, planner->getNumVertices());
+
+  planner->clear();
+  EXPECT_EQ(0u, planner->getNumVertices());
+  EXPECT_EQ(0u, planner->getNumEvaluations());
+
+  sspace->freeState(firstPose);
+  sspace->freeState(secondPose);
+}
+
+TEST_F(PlannerTest, RoadmapPlannerSavesAndLoadsRoadmap)
+{
+  auto world = aikido::planner::World::create();
+  world->addSkeleton(robot);
+
+  auto startState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(startState, 0)
+      .setValue(Eigen::Vector3d(-5, -5, 0));
+  auto goalState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(goalState, 0)
+      .setValue(Eigen::Vector3d(5, 5, 0));
+
+  RoadmapPlanner planner(stateSpace, robot, world, collConstraint, make_rng());
+  auto traj = planner.plan(startState, goalState, 5.0);
+  EXPECT_TRUE(traj != nullptr);
+
+  std::stringstream stream;
+  planner.saveRoadmap(stream);
+
+  RoadmapPlanner loaded(stateSpace, robot, world, collConstraint, make_rng());
+  loaded.loadRoadmap(stream);
+  EXPECT_EQ(
+      planner.getPlanner()->getNumVertices(),
+      loaded.getPlanner()->getNumVertices());
+  EXPECT_EQ(
+      planner.getPlanner()->getNumEdges(), loaded.getPlanner()->getNumEdges());
+
+  traj = loaded.plan(goalState, startState, 5.0);
+  EXPECT_TRUE(traj != nullptr);
+
+  std::stringstream invalidStream("not a roadmap");
+  EXPECT_THROW(loaded.loadRoadmap(invalidStream), std::runtime_error);
+  EXPECT_EQ(0u, loaded.getPlanner()->getNumVertices());
+}
+
+TEST_F(PlannerTest, RoadmapPlannerRejectsCorruptRoadmap)
+{
+  auto world = aikido::planner::World::create();
+  world->addSkeleton(robot);
+
+  auto startState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(startState, 0)
+      .setValue(Eigen::Vector3d(-5, -5, 0));
+  auto goalState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(goalState, 0)
+      .setValue(Eigen::Vector3d(5, 5, 0));
+
+  RoadmapPlanner planner(stateSpace, robot, world, collConstraint, make_rng());
+  auto traj = planner.plan(startState, goalState, 5.0);
+  ASSERT_TRUE(traj != nullptr);
+
+  std::stringstream plannerStream;
+  planner.saveRoadmap(plannerStream);
+  const std::string plannerRoadmap = plannerStream.str();
+
+  std::stringstream lazySPStream;
+  planner.getPlanner()->saveRoadmap(lazySPStream);
+  const std::string lazySPRoadmap = lazySPStream.str();
+
+  RoadmapPlanner loaded(stateSpace, robot, world, collConstraint, make_rng());
+  const auto expectLoadFails = [&loaded](
+      const std::string& roadmap,
+      std::size_t offset,
+      const void* value,
+      std::size_t size,
+      bool isPlannerRoadmap) {
+    std::string corrupt = roadmap;
+    std::memcpy(&corrupt[offset], value, size);
+
+    std::stringstream stream(corrupt);
+    if (isPlannerRoadmap)
+    {
+      EXPECT_THROW(loaded.loadRoadmap(stream), std::runtime_error);
+    }
+    else
+    {
+      EXPECT_THROW(
+          loaded.getPlanner()->loadRoadmap(stream), std::runtime_error);
+    }
+    EXPECT_EQ(0u, loaded.getPlanner()->getNumVertices());
+  };
+
+  // Counts larger than the rest of the stream are rejected before anything
+  // is allocated for them.
+  const std::uint64_t hugeCount = std::numeric_limits<std::uint64_t>::max();
+  expectLoadFails(plannerRoadmap, 8, &hugeCount, sizeof(hugeCount), true);
+  expectLoadFails(plannerRoadmap, 16, &hugeCount, sizeof(hugeCount), true);
+  expectLoadFails(lazySPRoadmap, 16, &hugeCount, sizeof(hugeCount), false);
+
+  // The LazySP roadmap starts with a magic number, a version, the dimension
+  // and the number of vertices. The first vertex follows, as a status and a
+  // tangent vector.
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  expectLoadFails(lazySPRoadmap, 25, &nan, sizeof(nan), false);
+}
+
+/// Collision constraint between the translational robot and a box around the
+/// position of an obstacle Skeleton.
+class MockObstacleConstraint : public aikido::constraint::Testable
+{
+public:
+  MockObstacleConstraint(
+      aikido::statespace::dart::MetaSkeletonStateSpacePtr _stateSpace,
+      dart::dynamics::SkeletonPtr _obstacle,
+      double _halfWidth)
+    : mStateSpace(std::move(_stateSpace))
+    , mObstacle(std::move(_obstacle))
+    , mHalfWidth(_halfWidth)
+  {
+  }
+
+  bool isSatisfied(
+      const aikido::statespace::StateSpace::State* _state,
+      TestableOutcome* outcome = nullptr) const override
+  {
+    auto defaultOutcomeObject
+        = aikido::constraint::dynamic_cast_or_throw<DefaultTestableOutcome>(
+            outcome);
+
+    auto cst = static_cast<const CartesianProduct::State*>(_state);
+    const Eigen::Vector3d offset
+        = mStateSpace->getSubStateHandle<R3>(cst, 0).getValue()
+          - mObstacle->getPositions();
+    const bool isSatisfiedResult
+        = (offset.head<2>().array().abs() > mHalfWidth).any();
+
+    if (defaultOutcomeObject)
+      defaultOutcomeObject->setSatisfiedFlag(isSatisfiedResult);
+    return isSatisfiedResult;
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return std::unique_ptr<TestableOutcome>(new DefaultTestableOutcome);
+  }
+
+  std::shared_ptr<aikido::statespace::StateSpace> getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+private:
+  aikido::statespace::dart::MetaSkeletonStateSpacePtr mStateSpace;
+  dart::dynamics::SkeletonPtr mObstacle;
+  double mHalfWidth;
+};
+
+TEST_F(PlannerTest, RoadmapPlannerChecksRoadmapAgainAfterWorldChanges)
+{
+  auto obstacle = dart::dynamics::Skeleton::create("obstacle");
+  obstacle->createJointAndBodyNodePair<dart::dynamics::TranslationalJoint>();
+  obstacle->setPositions(Eigen::Vector3d(10, 10, 0));
+
+  auto world = aikido::planner::World::create();
+  world->addSkeleton(robot);
+  world->addSkeleton(obstacle);
+
+  auto obstacleConstraint
+      = std::make_shared<MockObstacleConstraint>(stateSpace, obstacle, 1.0);
+
+  const Eigen::Vector3d startPose(-5, -5, 0);
+  auto startState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(startState, 0).setValue(startPose);
+  auto goalState = stateSpace->createState();
+  stateSpace->getSubStateHandle<R3>(goalState, 0)
+      .setValue(Eigen::Vector3d(5, 5, 0));
+
+  robot->setPositions(startPose);
+  RoadmapPlanner planner(
+      stateSpace, robot, world, obstacleConstraint, make_rng());
+  auto traj = planner.plan(startState, goalState, 5.0);
+  ASSERT_TRUE(traj != nullptr);
+
+  // Moving the obstacle onto the diagonal makes edges that were checked
+  // before invalid, so the planner must check the roadmap again to find a
+  // path around the obstacle.
+  obstacle->setPositions(Eigen::Vector3d::Zero());
+  traj = planner.plan(startState, goalState, 5.0);
+  ASSERT_TRUE(traj != nullptr);
+
+  auto state = stateSpace->createState();
+  for (double t = 0.; t <= traj->getDuration(); t += 0.01)
+  {
+    traj->evaluate(t, state);
+    EXPECT_TRUE(obstacleConstraint->isSatisfied(state));
+  }
+
+  // The robot is restored after planning.
+  EXPECT_TRUE(robot->getPositions().isApprox(startPose));
+}
+
 TEST_F(PlannerTest, PlanToGoalRegion)
 {
   auto startState = stateSpace->createState();
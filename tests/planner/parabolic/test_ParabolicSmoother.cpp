@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <aikido/common/StepSequence.hpp>
 #include <aikido/constraint/Satisfied.hpp>
+#include <aikido/planner/parabolic/OnlineShortcutTrajectory.hpp>
 #include <aikido/planner/parabolic/ParabolicSmoother.hpp>
 #include <aikido/planner/parabolic/ParabolicTimer.hpp>
 #include <aikido/statespace/CartesianProduct.hpp>
@@ -23,8 +24,10 @@ using aikido::constraint::Satisfied;
 using aikido::planner::parabolic::computeParabolicTiming;
 using aikido::planner::parabolic::convertToSpline;
 using aikido::planner::parabolic::doShortcut;
+using aikido::planner::parabolic::doShortcutParallel;
 using aikido::planner::parabolic::doBlend;
 using aikido::planner::parabolic::doShortcutAndBlend;
+using aikido::planner::parabolic::OnlineShortcutTrajectory;
 
 class ParabolicSmootherTests : public ::testing::Test
 {
@@ -109,7 +112,7 @@ protected:
     return length;
   }
 
-  double getLength(aikido::trajectory::Spline* spline)
+  double getLength(const aikido::trajectory::Spline* spline)
   {
     double length = 0.0;
     auto currState = mStateSpace->createState();
@@ -246,6 +249,52 @@ TEST_F(ParabolicSmootherTests, doShortcut)
   EXPECT_TRUE(shortenTime < originTime);
 }
 
+TEST_F(ParabolicSmootherTests, doShortcutParallel)
+{
+  std::vector<aikido::constraint::TestablePtr> testables;
+  for (int i = 0; i < 4; ++i)
+    testables.push_back(std::make_shared<Satisfied>(mStateSpace));
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcutParallel(
+      *splineTrajectory.get(),
+      testables,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng,
+      mTimelimit);
+
+  // Position.
+  auto state = mStateSpace->createState();
+  smoothedTrajectory->evaluate(smoothedTrajectory->getStartTime(), state);
+  auto startState = mStateSpace->createState();
+  mNonStraightLine->evaluate(mNonStraightLine->getStartTime(), startState);
+  EXPECT_EIGEN_EQUAL(startState.getValue(), state.getValue(), mTolerance);
+
+  smoothedTrajectory->evaluate(smoothedTrajectory->getEndTime(), state);
+  auto goalState = mStateSpace->createState();
+  mNonStraightLine->evaluate(mNonStraightLine->getEndTime(), goalState);
+  EXPECT_EIGEN_EQUAL(goalState.getValue(), state.getValue(), mTolerance);
+
+  double shortenLength = getLength(smoothedTrajectory.get());
+  EXPECT_TRUE(shortenLength < mNonStraightLineLength);
+
+  double originTime = mNonStraightLine->getDuration();
+  double shortenTime = smoothedTrajectory->getDuration();
+  EXPECT_TRUE(shortenTime < originTime);
+
+  EXPECT_THROW(
+      doShortcutParallel(
+          *splineTrajectory.get(),
+          {},
+          mMaxVelocity,
+          mMaxAcceleration,
+          mRng,
+          mTimelimit),
+      std::invalid_argument);
+}
+
 TEST_F(ParabolicSmootherTests, doBlend)
 {
   std::shared_ptr<Satisfied> testable
@@ -321,3 +370,124 @@ TEST_F(ParabolicSmootherTests, doShortcutAndBlend)
   double shortenTime = smoothedTrajectory->getDuration();
   EXPECT_TRUE(shortenTime < originTime);
 }
+
+TEST_F(ParabolicSmootherTests, OnlineShortcutTrajectory)
+{
+  std::shared_ptr<Satisfied> testable
+      = std::make_shared<Satisfied>(mStateSpace);
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  OnlineShortcutTrajectory smoothedTrajectory(
+      *splineTrajectory,
+      testable,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng.clone(),
+      mTimelimit);
+  smoothedTrajectory.wait();
+  EXPECT_FALSE(smoothedTrajectory.isShortcutting());
+  EXPECT_LT(0u, smoothedTrajectory.getNumShortcuts());
+
+  // Position.
+  auto state = mStateSpace->createState();
+  smoothedTrajectory.evaluate(smoothedTrajectory.getStartTime(), state);
+  auto startState = mStateSpace->createState();
+  mNonStraightLine->evaluate(mNonStraightLine->getStartTime(), startState);
+  EXPECT_EIGEN_EQUAL(startState.getValue(), state.getValue(), mTolerance);
+
+  smoothedTrajectory.evaluate(smoothedTrajectory.getEndTime(), state);
+  auto goalState = mStateSpace->createState();
+  mNonStraightLine->evaluate(mNonStraightLine->getEndTime(), goalState);
+  EXPECT_EIGEN_EQUAL(goalState.getValue(), state.getValue(), mTolerance);
+
+  double shortenLength = getLength(smoothedTrajectory.getSpline().get());
+  EXPECT_TRUE(shortenLength < mNonStraightLineLength);
+
+  double originTime = splineTrajectory->getDuration();
+  double shortenTime = smoothedTrajectory.getDuration();
+  EXPECT_TRUE(shortenTime < originTime);
+}
+
+TEST_F(ParabolicSmootherTests, OnlineShortcutTrajectoryKeepsEvaluatedPrefix)
+{
+  std::shared_ptr<Satisfied> testable
+      = std::make_shared<Satisfied>(mStateSpace);
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+
+  // Stop shortcutting immediately.
+  OnlineShortcutTrajectory stoppedTrajectory(
+      *splineTrajectory,
+      testable,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng.clone(),
+      mTimelimit);
+  stoppedTrajectory.stop();
+  EXPECT_FALSE(stoppedTrajectory.isShortcutting());
+
+  // The trajectory is fixed up to the lead time after the latest evaluated
+  // time, which is the start time until it is first evaluated.
+  // Shortcuts after the lead time fragment the ramps, so the timelimit is
+  // reached before too few ramps are left to shortcut.
+  const double timelimit = 1.0;
+  OnlineShortcutTrajectory smoothedTrajectory(
+      *splineTrajectory,
+      testable,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng.clone(),
+      timelimit);
+
+  const double kLeadTime = aikido::planner::parabolic::DEFAULT_LEAD_TIME;
+  const double startTime = splineTrajectory->getStartTime();
+  ASSERT_LT(startTime + 2. * kLeadTime, splineTrajectory->getEndTime());
+
+  // These times were fixed before shortcutting started.
+  const std::vector<double> initialTimes{
+      startTime, startTime + 0.5 * kLeadTime, startTime + kLeadTime};
+
+  // These times were fixed once the trajectory was evaluated at the last
+  // initial time, but may have been shortcut before.
+  const std::vector<double> laterTimes{startTime + 1.5 * kLeadTime,
+                                       startTime + 2. * kLeadTime};
+
+  std::vector<Eigen::VectorXd> initialValues;
+  std::vector<Eigen::VectorXd> laterValues;
+  auto state = mStateSpace->createState();
+  for (const double time : initialTimes)
+  {
+    smoothedTrajectory.evaluate(time, state);
+    initialValues.push_back(state.getValue());
+  }
+  for (const double time : laterTimes)
+  {
+    smoothedTrajectory.evaluate(time, state);
+    laterValues.push_back(state.getValue());
+  }
+  EXPECT_DOUBLE_EQ(laterTimes.back(), smoothedTrajectory.getExecutionTime());
+
+  smoothedTrajectory.wait();
+  for (std::size_t i = 0; i < initialTimes.size(); ++i)
+  {
+    splineTrajectory->evaluate(initialTimes[i], state);
+    EXPECT_EIGEN_EQUAL(initialValues[i], state.getValue(), mTolerance);
+
+    smoothedTrajectory.evaluate(initialTimes[i], state);
+    EXPECT_EIGEN_EQUAL(initialValues[i], state.getValue(), mTolerance);
+  }
+  for (std::size_t i = 0; i < laterTimes.size(); ++i)
+  {
+    smoothedTrajectory.evaluate(laterTimes[i], state);
+    EXPECT_EIGEN_EQUAL(laterValues[i], state.getValue(), mTolerance);
+  }
+
+  auto goalState = mStateSpace->createState();
+  smoothedTrajectory.evaluate(smoothedTrajectory.getEndTime(), state);
+  mNonStraightLine->evaluate(mNonStraightLine->getEndTime(), goalState);
+  EXPECT_EIGEN_EQUAL(goalState.getValue(), state.getValue(), mTolerance);
+  EXPECT_TRUE(
+      smoothedTrajectory.getDuration() <= splineTrajectory->getDuration());
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/Rn.hpp>
+#include "../../../src/planner/parabolic/ParabolicUtil.hpp"
+
+using aikido::planner::parabolic::detail::convertToSpline;
+using aikido::planner::parabolic::detail::toEigen;
+using aikido::statespace::R2;
+
+//==============================================================================
+TEST(ParabolicUtil, ConvertToSplineMatchesDynamicPath)
+{
+  auto stateSpace = std::make_shared<R2>();
+
+  ParabolicRamp::DynamicPath path;
+  path.Init(ParabolicRamp::Vector{1., 2.}, ParabolicRamp::Vector{3., 1.5});
+  path.SetMilestones(
+      std::vector<ParabolicRamp::Vector>{{0., 0.}, {1., 2.}, {1.5, -1.}});
+  ASSERT_FALSE(path.Empty());
+
+  const double startTime = 2.;
+  const auto spline = convertToSpline(path, startTime, stateSpace);
+  EXPECT_EQ(3u, spline->getNumDerivatives());
+  EXPECT_DOUBLE_EQ(startTime, spline->getStartTime());
+  EXPECT_NEAR(path.GetTotalTime(), spline->getDuration(), 1e-9);
+
+  // Sample the whole path, including the switch times of every ramp.
+  std::vector<double> times;
+  const double totalTime = path.GetTotalTime();
+  for (double t = 0.; t < totalTime; t += 0.01)
+    times.push_back(t);
+  times.push_back(totalTime);
+
+  double rampStartTime = 0.;
+  for (const auto& rampNd : path.ramps)
+  {
+    for (const auto& ramp1d : rampNd.ramps)
+    {
+      times.push_back(rampStartTime + ramp1d.tswitch1);
+      times.push_back(rampStartTime + ramp1d.tswitch2);
+    }
+    rampStartTime += rampNd.endTime;
+  }
+
+  auto state = stateSpace->createState();
+  Eigen::VectorXd velocity;
+  ParabolicRamp::Vector expectedPosition, expectedVelocity;
+  for (const auto t : times)
+  {
+    path.Evaluate(t, expectedPosition);
+    path.Derivative(t, expectedVelocity);
+
+    spline->evaluate(startTime + t, state);
+    spline->evaluateDerivative(startTime + t, 1, velocity);
+
+    EXPECT_TRUE(state.getValue().isApprox(toEigen(expectedPosition), 1e-6))
+        << "t = " << t << ": " << state.getValue().transpose()
+        << " != " << toEigen(expectedPosition).transpose();
+    EXPECT_TRUE(velocity.isApprox(toEigen(expectedVelocity), 1e-6))
+        << "t = " << t << ": " << velocity.transpose()
+        << " != " << toEigen(expectedVelocity).transpose();
+  }
+}
@@ -0,0 +1,70 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <aikido/common/Spline.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/trajectory/Spline.hpp>
+#include "../../../src/planner/vectorfield/detail/VectorFieldIntegrator.hpp"
+
+using aikido::planner::vectorfield::detail::Knot;
+using aikido::planner::vectorfield::detail::appendToSpline;
+using aikido::planner::vectorfield::detail::convertToSpline;
+using aikido::statespace::R2;
+using aikido::trajectory::Spline;
+
+//==============================================================================
+TEST(VectorFieldIntegrator, IncrementalSplineMatchesBatchFit)
+{
+  auto stateSpace = std::make_shared<R2>();
+
+  const std::vector<double> times{0., 0.1, 0.25, 0.3, 0.7};
+  std::vector<Knot> knots;
+  for (const auto time : times)
+  {
+    Knot knot;
+    knot.mT = time;
+    knot.mPositions = Eigen::Vector2d(std::sin(3. * time), time * time - 1.);
+    knots.emplace_back(knot);
+  }
+
+  // Append one segment per knot, as the integrator does.
+  Spline incremental(stateSpace);
+  for (std::size_t i = 1; i < knots.size(); ++i)
+    appendToSpline(knots[i - 1], knots[i], incremental);
+
+  // Fit a single piecewise linear spline through all knots.
+  using BatchSplineProblem = aikido::common::
+      SplineProblem<double, int, 2, Eigen::Dynamic, Eigen::Dynamic>;
+  Eigen::VectorXd timesVector(times.size());
+  for (std::size_t i = 0; i < times.size(); ++i)
+    timesVector[i] = times[i];
+
+  BatchSplineProblem problem(timesVector, 2, 2);
+  for (std::size_t i = 0; i < knots.size(); ++i)
+    problem.addConstantConstraint(i, 0, knots[i].mPositions);
+  const auto batch = problem.fit();
+
+  auto converted = convertToSpline(knots, stateSpace);
+
+  ASSERT_EQ(knots.size() - 1, incremental.getNumSegments());
+  ASSERT_EQ(knots.size() - 1, converted->getNumSegments());
+  EXPECT_DOUBLE_EQ(times.front(), incremental.getStartTime());
+  EXPECT_DOUBLE_EQ(times.back(), incremental.getEndTime());
+
+  auto state = stateSpace->createState();
+  Eigen::VectorXd tangent;
+  for (double t = times.front(); t <= times.back(); t += 0.01)
+  {
+    const Eigen::Vector2d expected = batch.evaluate(t);
+
+    incremental.evaluate(t, state);
+    EXPECT_TRUE(state.getValue().isApprox(expected, 1e-9))
+        << "t = " << t << ": " << state.getValue().transpose()
+        << " != " << expected.transpose();
+
+    converted->evaluate(t, state);
+    EXPECT_TRUE(state.getValue().isApprox(expected, 1e-9));
+
+    incremental.evaluateDerivative(t, 1, tangent);
+    EXPECT_TRUE(tangent.isApprox(batch.evaluate(t, 1), 1e-9));
+  }
+}
@@ -0,0 +1,163 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+#include <aikido/planner/World.hpp>
+#include <aikido/robot/PlanningContextPool.hpp>
+#include "../planner/ompl/OMPLTestHelpers.hpp"
+
+using aikido::planner::World;
+using aikido::planner::WorldPtr;
+using aikido::robot::PlanningContextPool;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using aikido::statespace::dart::MetaSkeletonStateSpacePtr;
+
+//==============================================================================
+class PlanningContextPoolTest : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    robot = createTranslationalRobot();
+    world = World::create();
+    world->addSkeleton(robot);
+    stateSpace = std::make_shared<MetaSkeletonStateSpace>(robot.get());
+
+    numFactoryCalls = 0u;
+    collisionTestableFactory = [this](
+        const MetaSkeletonStateSpacePtr& space,
+        const dart::dynamics::MetaSkeletonPtr& /*metaSkeleton*/,
+        const WorldPtr& /*world*/) {
+      ++numFactoryCalls;
+      return std::make_shared<MockTranslationalRobotConstraint>(
+          space,
+          Eigen::Vector3d(-0.1, -0.1, -0.1),
+          Eigen::Vector3d(0.1, 0.1, 0.1));
+    };
+  }
+
+  dart::dynamics::SkeletonPtr robot;
+  WorldPtr world;
+  MetaSkeletonStateSpacePtr stateSpace;
+  aikido::robot::util::CollisionTestableFactory collisionTestableFactory;
+  std::size_t numFactoryCalls;
+};
+
+//==============================================================================
+TEST_F(PlanningContextPoolTest, AcquireReturnsClones)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 2);
+  EXPECT_EQ(2u, pool.getNumContexts());
+  EXPECT_EQ(2u, numFactoryCalls);
+
+  auto handle = pool.acquire();
+  EXPECT_NE(world, handle->mWorld);
+  EXPECT_NE(robot, handle->mRobot);
+  EXPECT_EQ(robot->getName(), handle->mRobot->getName());
+  EXPECT_EQ(handle->mRobot, handle->mWorld->getSkeleton(robot->getName()));
+  EXPECT_EQ(robot->getNumDofs(), handle->mMetaSkeleton->getNumDofs());
+  EXPECT_TRUE(handle->mCollisionTestable != nullptr);
+
+  // Both contexts can be checked out at once, and they do not share a World.
+  auto otherHandle = pool.acquire();
+  EXPECT_NE(handle->mWorld, otherHandle->mWorld);
+}
+
+//==============================================================================
+TEST_F(PlanningContextPoolTest, ReleasedContextIsReused)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 1);
+
+  WorldPtr clonedWorld;
+  {
+    auto handle = pool.acquire();
+    clonedWorld = handle->mWorld;
+  }
+
+  auto handle = pool.acquire();
+  EXPECT_EQ(clonedWorld, handle->mWorld);
+  EXPECT_EQ(1u, numFactoryCalls);
+}
+
+//==============================================================================
+TEST_F(PlanningContextPoolTest, AcquireWaitsWhenPoolIsExhausted)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 1);
+
+  std::atomic<bool> acquired{false};
+  std::thread thread;
+  {
+    auto handle = pool.acquire();
+    thread = std::thread([&pool, &acquired]() {
+      auto otherHandle = pool.acquire();
+      acquired = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(acquired.load());
+  }
+
+  thread.join();
+  EXPECT_TRUE(acquired.load());
+}
+
+//==============================================================================
+TEST_F(PlanningContextPoolTest, AcquireThrowsForTooManyContexts)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 2);
+
+  EXPECT_THROW(pool.acquire(3), std::invalid_argument);
+
+  auto handles = pool.acquire(2);
+  EXPECT_EQ(2u, handles.size());
+}
+
+//==============================================================================
+TEST_F(PlanningContextPoolTest, AcquireSynchronizesConfigurations)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 1);
+
+  const Eigen::Vector3d positions(1, 2, 0);
+  robot->setPositions(positions);
+
+  auto handle = pool.acquire();
+  EXPECT_TRUE(handle->mRobot->getPositions().isApprox(positions));
+
+  // Moving the clone does not move the robot.
+  handle->mRobot->setPositions(Eigen::Vector3d(3, 4, 0));
+  EXPECT_TRUE(robot->getPositions().isApprox(positions));
+}
+
+//==============================================================================
+TEST_F(PlanningContextPoolTest, AcquireClonesWorldAgainWhenSkeletonsChange)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 1);
+
+  WorldPtr clonedWorld;
+  {
+    auto handle = pool.acquire();
+    clonedWorld = handle->mWorld;
+    EXPECT_EQ(1u, handle->mWorld->getNumSkeletons());
+  }
+
+  auto obstacle = dart::dynamics::Skeleton::create("obstacle");
+  obstacle->createJointAndBodyNodePair<dart::dynamics::TranslationalJoint>();
+  obstacle->setPositions(Eigen::Vector3d(1, 1, 0));
+  world->addSkeleton(obstacle);
+
+  auto handle = pool.acquire();
+  EXPECT_NE(clonedWorld, handle->mWorld);
+  EXPECT_EQ(2u, numFactoryCalls);
+
+  auto clonedObstacle = handle->mWorld->getSkeleton("obstacle");
+  ASSERT_TRUE(clonedObstacle != nullptr);
+  EXPECT_NE(obstacle, clonedObstacle);
+  EXPECT_TRUE(
+      clonedObstacle->getPositions().isApprox(obstacle->getPositions()));
+}
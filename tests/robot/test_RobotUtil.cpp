@@ -0,0 +1,375 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <aikido/constraint/dart/TSR.hpp>
+#include <aikido/planner/World.hpp>
+#include <aikido/robot/PlanningContextPool.hpp>
+#include <aikido/robot/util.hpp>
+#include "../planner/ompl/OMPLTestHelpers.hpp"
+
+using aikido::constraint::TestablePtr;
+using aikido::constraint::dart::TSR;
+using aikido::planner::World;
+using aikido::planner::WorldPtr;
+using aikido::robot::PlanningContextPool;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using aikido::statespace::dart::MetaSkeletonStateSpacePtr;
+using aikido::statespace::StateSpace;
+
+//==============================================================================
+/// Counts the states that a Testable is called on.
+class CountingTestable : public aikido::constraint::Testable
+{
+public:
+  explicit CountingTestable(TestablePtr testable)
+    : mTestable(std::move(testable)), mNumChecks(0u)
+  {
+  }
+
+  bool isSatisfied(
+      const StateSpace::State* state,
+      TestableOutcome* outcome = nullptr) const override
+  {
+    ++mNumChecks;
+    return mTestable->isSatisfied(state, outcome);
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return mTestable->createOutcome();
+  }
+
+  aikido::statespace::StateSpacePtr getStateSpace() const override
+  {
+    return mTestable->getStateSpace();
+  }
+
+  std::size_t getNumChecks() const
+  {
+    return mNumChecks.load();
+  }
+
+private:
+  TestablePtr mTestable;
+  mutable std::atomic<std::size_t> mNumChecks;
+};
+
+//==============================================================================
+class RobotUtilTest : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    robot = createTranslationalRobot();
+    world = World::create();
+    world->addSkeleton(robot);
+    stateSpace = std::make_shared<MetaSkeletonStateSpace>(robot.get());
+
+    collisionTestableFactory = [this](
+        const MetaSkeletonStateSpacePtr& space,
+        const dart::dynamics::MetaSkeletonPtr& /*metaSkeleton*/,
+        const WorldPtr& /*world*/) {
+      auto testable = std::make_shared<CountingTestable>(
+          std::make_shared<MockTranslationalRobotConstraint>(
+              space,
+              Eigen::Vector3d(-0.1, -0.1, -0.1),
+              Eigen::Vector3d(0.1, 0.1, 0.1)));
+      collisionTestables.emplace_back(testable);
+      return testable;
+    };
+
+    startPose = Eigen::Vector3d(-5, -5, 0);
+    goalPose = Eigen::Vector3d(5, 5, 0);
+    robot->setPositions(startPose);
+  }
+
+  /// Returns a state of stateSpace at position.
+  MetaSkeletonStateSpace::ScopedState createState(
+      const Eigen::Vector3d& position) const
+  {
+    auto state = stateSpace->createState();
+    stateSpace->getSubStateHandle<R3>(state, 0).setValue(position);
+    return state;
+  }
+
+  dart::dynamics::SkeletonPtr robot;
+  WorldPtr world;
+  MetaSkeletonStateSpacePtr stateSpace;
+  aikido::robot::util::CollisionTestableFactory collisionTestableFactory;
+  std::vector<std::shared_ptr<CountingTestable>> collisionTestables;
+  Eigen::Vector3d startPose;
+  Eigen::Vector3d goalPose;
+};
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToConfigurationChecksEdgesInParallel)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 3);
+  auto rng = make_rng();
+  auto goalState = createState(goalPose);
+
+  // The straight line passes through the obstacle, so the OMPL planner runs.
+  auto traj = aikido::robot::util::planToConfiguration(
+      pool, goalState, rng.get(), 5.0, 2);
+  ASSERT_TRUE(traj != nullptr);
+
+  auto state = stateSpace->createState();
+  traj->evaluate(traj->getDuration(), state);
+  EXPECT_TRUE(
+      stateSpace->getSubStateHandle<R3>(state, 0).getValue().isApprox(
+          goalPose));
+
+  // Every context checked some of the states.
+  ASSERT_EQ(3u, collisionTestables.size());
+  for (const auto& testable : collisionTestables)
+    EXPECT_LT(0u, testable->getNumChecks());
+
+  // The robot itself is not moved.
+  EXPECT_TRUE(robot->getPositions().isApprox(startPose));
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToConfigurationRejectsTooManyEdgeCheckWorkers)
+{
+  PlanningContextPool pool(
+      stateSpace, robot, world, collisionTestableFactory, 2);
+  auto rng = make_rng();
+  auto goalState = createState(goalPose);
+
+  EXPECT_THROW(
+      aikido::robot::util::planToConfiguration(
+          pool, goalState, rng.get(), 5.0, 2),
+      std::invalid_argument);
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToConfigurationsParallelReachesAGoal)
+{
+  // The straight lines to both goals pass through the obstacle, so
+  // RRTConnect runs.
+  auto goal1 = createState(goalPose);
+  auto goal2 = createState(Eigen::Vector3d(4, 4, 0));
+  const std::vector<StateSpace::State*> goalStates{goal1.getState(),
+                                                   goal2.getState()};
+  auto rng = make_rng();
+
+  auto traj = aikido::robot::util::planToConfigurationsParallel(
+      stateSpace,
+      robot,
+      goalStates,
+      world,
+      collisionTestableFactory,
+      rng.get(),
+      5.0,
+      aikido::robot::util::ParallelPlannerParameters(2));
+  ASSERT_TRUE(traj != nullptr);
+
+  auto state = stateSpace->createState();
+  traj->evaluate(traj->getDuration(), state);
+  const Eigen::Vector3d position
+      = stateSpace->getSubStateHandle<R3>(state, 0).getValue();
+  EXPECT_TRUE(
+      position.isApprox(goalPose)
+      || position.isApprox(Eigen::Vector3d(4, 4, 0)));
+
+  // One World clone per worker.
+  EXPECT_EQ(2u, collisionTestables.size());
+
+  // The robot itself is not moved.
+  EXPECT_TRUE(robot->getPositions().isApprox(startPose));
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToConfigurationsParallelFailsIfAllGoalsInCollision)
+{
+  auto goal1 = createState(Eigen::Vector3d(0, 0, 0));
+  auto goal2 = createState(Eigen::Vector3d(0.05, 0, 0));
+  const std::vector<StateSpace::State*> goalStates{goal1.getState(),
+                                                   goal2.getState()};
+  auto rng = make_rng();
+
+  auto traj = aikido::robot::util::planToConfigurationsParallel(
+      stateSpace,
+      robot,
+      goalStates,
+      world,
+      collisionTestableFactory,
+      rng.get(),
+      1.0,
+      aikido::robot::util::ParallelPlannerParameters(2));
+  EXPECT_TRUE(traj == nullptr);
+  EXPECT_TRUE(robot->getPositions().isApprox(startPose));
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToConfigurationsParallelMatchesSerial)
+{
+  // Only the second goal can be reached with Snap Planner, so both versions
+  // return the straight line to it.
+  auto goal1 = createState(goalPose);
+  auto goal2 = createState(Eigen::Vector3d(5, -5, 0));
+  const std::vector<StateSpace::State*> goalStates{goal1.getState(),
+                                                   goal2.getState()};
+
+  auto rng = make_rng();
+  auto serialTraj = aikido::robot::util::planToConfigurations(
+      stateSpace,
+      robot,
+      goalStates,
+      collisionTestableFactory(stateSpace, robot, world),
+      rng.get(),
+      5.0);
+  ASSERT_TRUE(serialTraj != nullptr);
+
+  rng = make_rng();
+  auto parallelTraj = aikido::robot::util::planToConfigurationsParallel(
+      stateSpace,
+      robot,
+      goalStates,
+      world,
+      collisionTestableFactory,
+      rng.get(),
+      5.0,
+      aikido::robot::util::ParallelPlannerParameters(2, false));
+  ASSERT_TRUE(parallelTraj != nullptr);
+
+  ASSERT_EQ(serialTraj->getNumWaypoints(), parallelTraj->getNumWaypoints());
+  EXPECT_DOUBLE_EQ(serialTraj->getDuration(), parallelTraj->getDuration());
+
+  auto serialState = stateSpace->createState();
+  auto parallelState = stateSpace->createState();
+  for (std::size_t i = 0; i < serialTraj->getNumWaypoints(); ++i)
+  {
+    stateSpace->copyState(serialTraj->getWaypoint(i), serialState);
+    stateSpace->copyState(parallelTraj->getWaypoint(i), parallelState);
+    EXPECT_TRUE(
+        stateSpace->getSubStateHandle<R3>(serialState, 0).getValue().isApprox(
+            stateSpace->getSubStateHandle<R3>(parallelState, 0).getValue()));
+  }
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToConfigurationLazyReusesRoadmap)
+{
+  aikido::planner::ompl::RoadmapPlanner planner(
+      stateSpace,
+      robot,
+      world,
+      collisionTestableFactory(stateSpace, robot, world),
+      make_rng());
+  auto goalState = createState(goalPose);
+
+  auto traj = aikido::robot::util::planToConfigurationLazy(
+      planner, goalState, 5.0);
+  ASSERT_TRUE(traj != nullptr);
+  EXPECT_TRUE(robot->getPositions().isApprox(startPose));
+
+  const auto numVertices = planner.getPlanner()->getNumVertices();
+  const auto numEvaluations = planner.getPlanner()->getNumEvaluations();
+  EXPECT_LT(0u, numVertices);
+
+  // The second query searches the same roadmap, so it needs no new samples
+  // and fewer evaluations.
+  traj = aikido::robot::util::planToConfigurationLazy(planner, goalState, 5.0);
+  ASSERT_TRUE(traj != nullptr);
+  EXPECT_EQ(numVertices, planner.getPlanner()->getNumVertices());
+  EXPECT_LT(
+      planner.getPlanner()->getNumEvaluations() - numEvaluations,
+      numEvaluations);
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToTSRParallelReachesTSR)
+{
+  Eigen::Isometry3d T0_w = Eigen::Isometry3d::Identity();
+  T0_w.translation() = Eigen::Vector3d(4, 4, 0);
+  Eigen::Matrix<double, 6, 2> Bw = Eigen::Matrix<double, 6, 2>::Zero();
+  Bw(0, 0) = -0.5;
+  Bw(0, 1) = 0.5;
+  Bw(1, 0) = -0.5;
+  Bw(1, 1) = 0.5;
+  auto tsr = std::make_shared<TSR>(make_rng(), T0_w, Bw);
+  auto rng = make_rng();
+
+  auto traj = aikido::robot::util::planToTSRParallel(
+      stateSpace,
+      robot,
+      robot->getBodyNode(0),
+      tsr,
+      world,
+      collisionTestableFactory,
+      rng.get(),
+      5.0,
+      10,
+      aikido::robot::util::ParallelPlannerParameters(3));
+  ASSERT_TRUE(traj != nullptr);
+
+  auto state = stateSpace->createState();
+  traj->evaluate(traj->getDuration(), state);
+  const Eigen::Vector3d position
+      = stateSpace->getSubStateHandle<R3>(state, 0).getValue();
+  EXPECT_NEAR(4., position[0], 0.5 + 1e-3);
+  EXPECT_NEAR(4., position[1], 0.5 + 1e-3);
+
+  // One World clone per worker.
+  EXPECT_EQ(3u, collisionTestables.size());
+
+  // The robot itself is not moved.
+  EXPECT_TRUE(robot->getPositions().isApprox(startPose));
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToTSRParallelFailsForTSRInCollision)
+{
+  // Every pose in the TSR is inside the obstacle.
+  auto tsr = std::make_shared<TSR>(make_rng());
+  auto rng = make_rng();
+
+  auto traj = aikido::robot::util::planToTSRParallel(
+      stateSpace,
+      robot,
+      robot->getBodyNode(0),
+      tsr,
+      world,
+      collisionTestableFactory,
+      rng.get(),
+      1.0,
+      10,
+      aikido::robot::util::ParallelPlannerParameters(2));
+  EXPECT_TRUE(traj == nullptr);
+  EXPECT_EQ(2u, collisionTestables.size());
+  EXPECT_TRUE(robot->getPositions().isApprox(startPose));
+}
+
+//==============================================================================
+TEST_F(RobotUtilTest, PlanToTSRParallelThrowsOnInvalidArguments)
+{
+  auto tsr = std::make_shared<TSR>(make_rng());
+  auto rng = make_rng();
+
+  EXPECT_THROW(
+      aikido::robot::util::planToTSRParallel(
+          stateSpace,
+          robot,
+          robot->getBodyNode(0),
+          tsr,
+          nullptr,
+          collisionTestableFactory,
+          rng.get(),
+          1.0,
+          10),
+      std::invalid_argument);
+
+  EXPECT_THROW(
+      aikido::robot::util::planToTSRParallel(
+          stateSpace,
+          robot,
+          robot->getBodyNode(0),
+          tsr,
+          world,
+          nullptr,
+          rng.get(),
+          1.0,
+          10),
+      std::invalid_argument);
+}
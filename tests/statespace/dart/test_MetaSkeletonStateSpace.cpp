@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <dart/dynamics/dynamics.hpp>
 #include <gtest/gtest.h>
 #include <aikido/statespace/CartesianProduct.hpp>
@@ -229,3 +230,72 @@ TEST(MetaSkeletonStateSpace, MultipleJoints_CreatesCartesianProduct)
   EXPECT_EQ(5., substate1.getAngle());
   EXPECT_TRUE(value2.isApprox(substate2.getValue()));
 }
+
+TEST(MetaSkeletonStateSpace, ConvertPositions_RoundTrip)
+{
+  auto skeleton = Skeleton::create();
+  auto pair1 = skeleton->createJointAndBodyNodePair<RevoluteJoint>();
+  auto pair2 = skeleton->createJointAndBodyNodePair<PrismaticJoint>(
+      pair1.second);
+  skeleton->createJointAndBodyNodePair<TranslationalJoint>(pair2.second);
+  skeleton->createJointAndBodyNodePair<FreeJoint>();
+
+  std::vector<dart::dynamics::DegreeOfFreedom*> dofs = skeleton->getDofs();
+  std::reverse(dofs.begin(), dofs.end());
+  auto group = dart::dynamics::Group::create("group", dofs);
+
+  Eigen::VectorXd positions(11);
+  positions << 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.05, -0.05, 0.1, 1., 2.;
+
+  for (const auto& metaSkeleton :
+       std::vector<dart::dynamics::MetaSkeletonPtr>{skeleton, group})
+  {
+    MetaSkeletonStateSpace space(metaSkeleton.get());
+    auto state = space.createState();
+
+    space.convertPositionsToState(positions, state);
+
+    Eigen::VectorXd outPositions;
+    space.convertStateToPositions(state, outPositions);
+    EXPECT_TRUE(positions.isApprox(outPositions));
+
+    space.setState(metaSkeleton.get(), state);
+    EXPECT_TRUE(positions.isApprox(metaSkeleton->getPositions()));
+
+    auto outState = space.createState();
+    space.getState(metaSkeleton.get(), outState);
+    space.convertStateToPositions(outState, outPositions);
+    EXPECT_TRUE(positions.isApprox(outPositions));
+  }
+}
+
+TEST(MetaSkeletonStateSpace, ConvertPositions_RealVectorJoints)
+{
+  auto skeleton = Skeleton::create();
+  auto pair = skeleton->createJointAndBodyNodePair<PrismaticJoint>();
+  skeleton->createJointAndBodyNodePair<TranslationalJoint>(pair.second);
+
+  std::vector<dart::dynamics::DegreeOfFreedom*> dofs = skeleton->getDofs();
+  std::reverse(dofs.begin(), dofs.end());
+  auto group = dart::dynamics::Group::create("group", dofs);
+
+  MetaSkeletonStateSpace skeletonSpace(skeleton.get());
+  MetaSkeletonStateSpace groupSpace(group.get());
+
+  const Eigen::Vector4d positions(1., 2., 3., 4.);
+  auto state = skeletonSpace.createState();
+  skeletonSpace.convertPositionsToState(positions, state);
+  EXPECT_EQ(1., state.getSubStateHandle<R1>(0).getValue()[0]);
+  EXPECT_TRUE(
+      Vector3d(2., 3., 4.).isApprox(state.getSubStateHandle<R3>(1).getValue()));
+
+  // The group orders the DOFs of each joint in reverse.
+  groupSpace.convertPositionsToState(positions, state);
+  EXPECT_TRUE(
+      Vector3d(3., 2., 1.).isApprox(state.getSubStateHandle<R3>(0).getValue()));
+  EXPECT_EQ(4., state.getSubStateHandle<R1>(1).getValue()[0]);
+
+  EXPECT_THROW(
+      skeletonSpace.convertPositionsToState(Eigen::Vector3d::Zero(), state),
+      std::invalid_argument);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SE2.hpp>
+#include <aikido/statespace/SO2.hpp>
+
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::Interpolator;
+using aikido::statespace::R2;
+using aikido::statespace::Rn;
+using aikido::statespace::SE2;
+using aikido::statespace::SO2;
+using aikido::statespace::StateSpace;
+using aikido::statespace::StateSpacePtr;
+
+namespace {
+
+//==============================================================================
+void expectEdgeMatchesInterpolate(
+    const StateSpacePtr& stateSpace,
+    const Eigen::VectorXd& fromTangent,
+    const Eigen::VectorXd& toTangent)
+{
+  GeodesicInterpolator interpolator(stateSpace);
+
+  auto from = stateSpace->createState();
+  auto to = stateSpace->createState();
+  stateSpace->expMap(fromTangent, from);
+  stateSpace->expMap(toTangent, to);
+
+  const auto edge = interpolator.prepareEdge(from, to);
+
+  // The edge keeps its own copies of the states.
+  auto expectedTo = stateSpace->createState();
+  stateSpace->copyState(to, expectedTo);
+  stateSpace->getIdentity(to);
+
+  auto expected = stateSpace->createState();
+  auto actual = stateSpace->createState();
+  Eigen::VectorXd expectedTangent;
+  Eigen::VectorXd actualTangent;
+
+  for (const double alpha : {0., 0.1, 0.25, 0.5, 0.9, 1.})
+  {
+    interpolator.interpolate(from, expectedTo, alpha, expected);
+    edge->interpolate(alpha, actual);
+
+    stateSpace->logMap(expected, expectedTangent);
+    stateSpace->logMap(actual, actualTangent);
+    EXPECT_TRUE(expectedTangent.isApprox(actualTangent, 1e-9))
+        << "alpha = " << alpha;
+  }
+}
+
+} // namespace
+
+//==============================================================================
+TEST(GeodesicInterpolator, PrepareEdge_Rn)
+{
+  expectEdgeMatchesInterpolate(
+      std::make_shared<Rn>(3),
+      Eigen::Vector3d(1., 2., 3.),
+      Eigen::Vector3d(-1., 0., 5.));
+}
+
+//==============================================================================
+TEST(GeodesicInterpolator, PrepareEdge_SO2)
+{
+  expectEdgeMatchesInterpolate(
+      std::make_shared<SO2>(),
+      Eigen::Matrix<double, 1, 1>::Constant(0.5),
+      Eigen::Matrix<double, 1, 1>::Constant(-2.5));
+}
+
+//==============================================================================
+TEST(GeodesicInterpolator, PrepareEdge_CartesianProduct)
+{
+  const auto space = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{std::make_shared<R2>(),
+                                 std::make_shared<SO2>(),
+                                 std::make_shared<Rn>(1)});
+
+  Eigen::VectorXd from(4);
+  from << 1., 2., 0.5, 3.;
+  Eigen::VectorXd to(4);
+  to << 4., -2., 2.5, 1.;
+
+  expectEdgeMatchesInterpolate(space, from, to);
+}
+
+//==============================================================================
+TEST(GeodesicInterpolator, PrepareEdge_NonLinearSpace)
+{
+  const auto space = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{std::make_shared<SE2>(),
+                                 std::make_shared<R2>()});
+
+  Eigen::VectorXd from(5);
+  from << 0.3, 1., 2., 3., 4.;
+  Eigen::VectorXd to(5);
+  to << -1.2, -1., 0.5, 0., 1.;
+
+  expectEdgeMatchesInterpolate(space, from, to);
+}
+
+//==============================================================================
+TEST(GeodesicInterpolator, PrepareEdge_DefaultImplementation)
+{
+  // The default Interpolator::prepareEdge is used by interpolators that do not
+  // override it.
+  class TestInterpolator : public GeodesicInterpolator
+  {
+  public:
+    using GeodesicInterpolator::GeodesicInterpolator;
+
+    std::unique_ptr<Edge> prepareEdge(
+        const StateSpace::State* _from,
+        const StateSpace::State* _to) const override
+    {
+      return Interpolator::prepareEdge(_from, _to);
+    }
+  };
+
+  const auto space = std::make_shared<Rn>(2);
+  TestInterpolator interpolator(space);
+
+  auto from = space->createState();
+  auto to = space->createState();
+  from.setValue(Eigen::Vector2d(0., 1.));
+  to.setValue(Eigen::Vector2d(2., 3.));
+
+  const auto edge = interpolator.prepareEdge(from, to);
+  from.setValue(Eigen::Vector2d::Zero());
+
+  auto state = space->createState();
+  edge->interpolate(0.5, state);
+  EXPECT_TRUE(state.getValue().isApprox(Eigen::Vector2d(1., 2.)));
+}
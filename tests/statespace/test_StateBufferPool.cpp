@@ -0,0 +1,109 @@
+#include <thread>
+#include <gtest/gtest.h>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/StateBufferPool.hpp>
+
+using aikido::statespace::R3;
+using aikido::statespace::StateBufferPool;
+
+//==============================================================================
+TEST(StateBufferPool, ReusesReleasedBuffers)
+{
+  StateBufferPool::clear();
+
+  char* buffer = StateBufferPool::acquire(24);
+  StateBufferPool::release(buffer, 24);
+  EXPECT_EQ(1u, StateBufferPool::getNumCachedBuffers());
+
+  // Sizes that round up to the same bucket share buffers.
+  char* reused = StateBufferPool::acquire(20);
+  EXPECT_EQ(buffer, reused);
+  EXPECT_EQ(0u, StateBufferPool::getNumCachedBuffers());
+
+  StateBufferPool::release(reused, 20);
+  StateBufferPool::clear();
+  EXPECT_EQ(0u, StateBufferPool::getNumCachedBuffers());
+}
+
+//==============================================================================
+TEST(StateBufferPool, DoesNotCacheLargeBuffers)
+{
+  StateBufferPool::clear();
+
+  const auto size = StateBufferPool::MAX_POOLED_SIZE + 1;
+  StateBufferPool::release(StateBufferPool::acquire(size), size);
+  EXPECT_EQ(0u, StateBufferPool::getNumCachedBuffers());
+}
+
+//==============================================================================
+TEST(StateBufferPool, BoundsNumberOfCachedBuffers)
+{
+  StateBufferPool::clear();
+
+  std::vector<char*> buffers;
+  for (std::size_t i = 0; i < 2 * StateBufferPool::MAX_BUFFERS_PER_BUCKET; ++i)
+    buffers.push_back(StateBufferPool::acquire(8));
+
+  for (char* buffer : buffers)
+    StateBufferPool::release(buffer, 8);
+
+  EXPECT_EQ(
+      StateBufferPool::MAX_BUFFERS_PER_BUCKET,
+      StateBufferPool::getNumCachedBuffers());
+  StateBufferPool::clear();
+}
+
+//==============================================================================
+TEST(StateBufferPool, ScopedStatesReuseBuffers)
+{
+  StateBufferPool::clear();
+  R3 rvss;
+
+  const R3::State* first;
+  {
+    auto state = rvss.createState();
+    state.setValue(Eigen::Vector3d(1., 2., 3.));
+    first = state.getState();
+  }
+  EXPECT_EQ(1u, StateBufferPool::getNumCachedBuffers());
+
+  auto state = rvss.createState();
+  EXPECT_EQ(first, state.getState());
+  EXPECT_EQ(0u, StateBufferPool::getNumCachedBuffers());
+
+  auto moved = std::move(state);
+  moved.setValue(Eigen::Vector3d(4., 5., 6.));
+  EXPECT_TRUE(moved.getValue().isApprox(Eigen::Vector3d(4., 5., 6.)));
+}
+
+//==============================================================================
+TEST(StateBufferPool, AllocatedStatesReuseBuffers)
+{
+  StateBufferPool::clear();
+  R3 rvss;
+
+  auto state = rvss.allocateState();
+  rvss.freeState(state);
+  EXPECT_EQ(1u, StateBufferPool::getNumCachedBuffers());
+
+  auto other = rvss.allocateState();
+  EXPECT_EQ(state, other);
+  rvss.freeState(other);
+}
+
+//==============================================================================
+TEST(StateBufferPool, PoolsAreThreadLocal)
+{
+  StateBufferPool::clear();
+  StateBufferPool::release(StateBufferPool::acquire(32), 32);
+
+  std::size_t numCachedInThread = 1u;
+  std::thread thread([&numCachedInThread]() {
+    numCachedInThread = StateBufferPool::getNumCachedBuffers();
+  });
+  thread.join();
+
+  EXPECT_EQ(0u, numCachedInThread);
+  EXPECT_EQ(1u, StateBufferPool::getNumCachedBuffers());
+  StateBufferPool::clear();
+}
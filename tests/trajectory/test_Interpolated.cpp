@@ -84,3 +84,82 @@ TEST_F(InterpolatedTest, EvaluateDerivative)
   traj->evaluateDerivative(6, 1, tangentVector);
   EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d(5. / 4, -2. / 4)));
 }
+
+TEST_F(InterpolatedTest, EvaluateBatchMatchesEvaluate)
+{
+  const std::vector<double> times{0., 1., 1.5, 3., 3.5, 6., 7., 8., 2., 4.};
+  Eigen::MatrixXd evaluations;
+  traj->evaluateBatch(times, evaluations, {0, 1, 2});
+
+  ASSERT_EQ(6, evaluations.rows());
+  ASSERT_EQ(static_cast<int>(times.size()), evaluations.cols());
+
+  auto istate = rvss->createState();
+  Eigen::VectorXd tangentVector;
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    traj->evaluate(times[i], istate);
+    EXPECT_TRUE(
+        rvss->getValue(istate).isApprox(evaluations.block<2, 1>(0, i)));
+
+    traj->evaluateDerivative(times[i], 1, tangentVector);
+    EXPECT_TRUE(tangentVector.isApprox(evaluations.block<2, 1>(2, i)));
+
+    EXPECT_TRUE(evaluations.col(i).segment<2>(4).isZero());
+  }
+
+  EXPECT_THROW(
+      traj->evaluateBatch(times, evaluations, {-1}), std::invalid_argument);
+}
+
+TEST_F(InterpolatedTest, AddWaypointOutOfOrder)
+{
+  auto state = rvss->createState();
+  rvss->setValue(state, Eigen::Vector2d(1, 1));
+  traj->addWaypoint(2, state);
+  rvss->setValue(state, Eigen::Vector2d(-1, 0));
+  traj->addWaypoint(0, state);
+
+  // Adding a waypoint of the trajectory itself copies it before moving the
+  // other waypoints.
+  traj->addWaypoint(5, traj->getWaypoint(4));
+
+  const std::vector<double> expectedTimes{0, 1, 2, 3, 5, 7};
+  const std::vector<Eigen::Vector2d> expectedValues{Eigen::Vector2d(-1, 0),
+                                                    Eigen::Vector2d(0, 0),
+                                                    Eigen::Vector2d(1, 1),
+                                                    Eigen::Vector2d(3, 3),
+                                                    Eigen::Vector2d(8, 1),
+                                                    Eigen::Vector2d(8, 1)};
+
+  ASSERT_EQ(expectedTimes.size(), traj->getNumWaypoints());
+  for (std::size_t i = 0; i < expectedTimes.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(expectedTimes[i], traj->getWaypointTime(i));
+    const auto waypoint
+        = static_cast<const R2::State*>(traj->getWaypoint(i));
+    EXPECT_TRUE(rvss->getValue(waypoint).isApprox(expectedValues[i]));
+  }
+}
+
+TEST_F(InterpolatedTest, AddManyWaypoints)
+{
+  auto longTraj = make_shared<Interpolated>(rvss, interpolator);
+  longTraj->reserve(10);
+
+  auto state = rvss->createState();
+  for (int i = 0; i < 100; ++i)
+  {
+    rvss->setValue(state, Eigen::Vector2d(i, -i));
+    longTraj->addWaypoint(i, state);
+  }
+
+  ASSERT_EQ(100u, longTraj->getNumWaypoints());
+  for (int i = 0; i < 100; ++i)
+  {
+    longTraj->evaluate(i + 0.5, state);
+    const double expected = std::min(i + 0.5, 99.);
+    EXPECT_TRUE(
+        rvss->getValue(state).isApprox(Eigen::Vector2d(expected, -expected)));
+  }
+}
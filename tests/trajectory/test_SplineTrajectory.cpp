@@ -354,3 +354,138 @@ TEST_F(SplineTest, EvaluateDerivative_HigherOrder_ReturnsZero)
   trajectory.evaluateDerivative(7.5, 3, tangentVector);
   EXPECT_TRUE(Vector2d::Zero().isApprox(tangentVector));
 }
+
+TEST_F(SplineTest, getWaypointTime)
+{
+  Eigen::Matrix<double, 2, 3> coefficients;
+  coefficients << 0., 0., 1., 0., 1., 1.;
+
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(coefficients, 1., mStartState);
+  trajectory.addSegment(coefficients, 2.);
+  trajectory.addSegment(coefficients, 3.);
+
+  EXPECT_DOUBLE_EQ(3., trajectory.getWaypointTime(0));
+  EXPECT_DOUBLE_EQ(4., trajectory.getWaypointTime(1));
+  EXPECT_DOUBLE_EQ(6., trajectory.getWaypointTime(2));
+  EXPECT_DOUBLE_EQ(9., trajectory.getWaypointTime(3));
+  EXPECT_THROW(trajectory.getWaypointTime(4), std::domain_error);
+}
+
+TEST_F(SplineTest, Cursor_MatchesEvaluate)
+{
+  Eigen::Matrix<double, 2, 3> coefficients1, coefficients2, coefficients3;
+  coefficients1 << 0., 0., 1., 0., 1., 1.;
+  coefficients2 << 0., 1., 2., 0., 2., 2.;
+  coefficients3 << 0., 2., 3., 0., 3., 3.;
+
+  auto trajectory = std::make_shared<Spline>(mStateSpace, 3.);
+  trajectory->addSegment(coefficients1, 1., mStartState);
+  trajectory->addSegment(coefficients2, 2.);
+  trajectory->addSegment(coefficients3, 3.);
+
+  Spline::Cursor cursor(trajectory);
+  auto expectedState = mStateSpace->createState();
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd expectedTangent, tangent;
+
+  // Sweep forward, backward, and with jumps, including the segment
+  // boundaries and times outside of the trajectory.
+  const std::vector<double> times{2.,  3.,  3.5, 4.,  4.5, 6.,  6.5, 9.,
+                                  10., 8.,  6.,  5.9, 4.,  3.2, 8.5, 3.};
+  for (const double t : times)
+  {
+    trajectory->evaluate(t, expectedState);
+    cursor.evaluate(t, state);
+    EXPECT_TRUE(expectedState.getValue().isApprox(state.getValue()));
+
+    trajectory->evaluateDerivative(t, 1, expectedTangent);
+    cursor.evaluateDerivative(t, 1, tangent);
+    EXPECT_TRUE(expectedTangent.isApprox(tangent));
+  }
+
+  cursor.evaluate(5., state);
+  EXPECT_EQ(1u, cursor.getSegmentIndex());
+  cursor.evaluate(6., state);
+  EXPECT_EQ(1u, cursor.getSegmentIndex());
+  cursor.evaluate(6.1, state);
+  EXPECT_EQ(2u, cursor.getSegmentIndex());
+}
+
+TEST_F(SplineTest, Cursor_IsEmpty_Throws)
+{
+  auto trajectory = std::make_shared<Spline>(mStateSpace, 3.);
+  Spline::Cursor cursor(trajectory);
+  auto state = mStateSpace->createState();
+
+  EXPECT_THROW(cursor.evaluate(3., state), std::logic_error);
+}
+
+TEST_F(SplineTest, EvaluateDerivative_HighOrder_MatchesPowerSum)
+{
+  // More coefficients than the precomputed derivative table covers.
+  const int numCoefficients = 20;
+  Eigen::MatrixXd coefficients(2, numCoefficients);
+  for (int i = 0; i < numCoefficients; ++i)
+  {
+    coefficients(0, i) = 1. / (i + 1);
+    coefficients(1, i) = (i % 2 == 0) ? 0.5 : -0.25;
+  }
+
+  Spline trajectory(mStateSpace, 0.);
+  trajectory.addSegment(coefficients, 1., mStartState);
+
+  const double t = 0.7;
+  for (int derivative = 1; derivative < 4; ++derivative)
+  {
+    Vector2d expected = Vector2d::Zero();
+    for (int power = derivative; power < numCoefficients; ++power)
+    {
+      double factor = 1.;
+      for (int i = 0; i < derivative; ++i)
+        factor *= power - i;
+      expected
+          += factor * std::pow(t, power - derivative) * coefficients.col(power);
+    }
+
+    Eigen::VectorXd tangentVector;
+    trajectory.evaluateDerivative(t, derivative, tangentVector);
+    EXPECT_TRUE(expected.isApprox(tangentVector));
+  }
+}
+
+TEST_F(SplineTest, evaluateBatch_MatchesEvaluate)
+{
+  Eigen::Matrix<double, 2, 3> coefficients1, coefficients2, coefficients3;
+  coefficients1 << 0., 0., 1., 0., 1., 1.;
+  coefficients2 << 0., 1., 2., 0., 2., 2.;
+  coefficients3 << 0., 2., 3., 0., 3., 3.;
+
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(coefficients1, 1., mStartState);
+  trajectory.addSegment(coefficients2, 2.);
+  trajectory.addSegment(coefficients3, 3.);
+
+  const std::vector<double> times{3., 3.5, 4., 5., 6., 7.5, 9., 10., 4.5};
+  Eigen::MatrixXd evaluations;
+  trajectory.evaluateBatch(times, evaluations, {0, 1, 2});
+
+  ASSERT_EQ(6, evaluations.rows());
+  ASSERT_EQ(static_cast<int>(times.size()), evaluations.cols());
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    trajectory.evaluate(times[i], state);
+    EXPECT_TRUE(state.getValue().isApprox(evaluations.block<2, 1>(0, i)));
+
+    for (int derivative = 1; derivative <= 2; ++derivative)
+    {
+      trajectory.evaluateDerivative(times[i], derivative, tangentVector);
+      EXPECT_TRUE(
+          tangentVector.isApprox(
+              evaluations.block<2, 1>(2 * derivative, i)));
+    }
+  }
+}